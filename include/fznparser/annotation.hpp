@@ -32,6 +32,10 @@ class Annotation {
 
   bool operator==(const Annotation&) const;
   bool operator!=(const Annotation&) const;
+  /**
+   * @return a hash that is equal for annotations that are equal
+   */
+  [[nodiscard]] size_t hash() const;
   [[nodiscard]] std::string toString() const;
 };
 
@@ -43,6 +47,7 @@ class AnnotationExpression
                      Annotation>::variant;
   bool operator==(const AnnotationExpression&) const;
   bool operator!=(const AnnotationExpression&) const;
+  [[nodiscard]] size_t hash() const;
   [[nodiscard]] std::string toString() const;
 };
 
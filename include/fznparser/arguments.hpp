@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <variant>
 
@@ -62,11 +63,31 @@ class FloatArg : public std::variant<double, std::shared_ptr<const FloatVar>> {
   [[nodiscard]] std::string toString() const;
 };
 
-class IntSetArg : public std::variant<IntSet, std::shared_ptr<const SetVar>> {
-  std::shared_ptr<const SetVar> _setVar{nullptr};
+/**
+ * @brief The out of line parameter of an IntSetArg, together with the fixed
+ * SetVar that toVar creates for it, so that every call returns that SetVar.
+ * The SetVar is created once, also when toVar is called from several
+ * threads.
+ */
+struct IntSetParameter {
+  IntSet intSet;
+  mutable std::once_flag setVarCreated;
+  mutable std::shared_ptr<const SetVar> setVar{nullptr};
+
+  explicit IntSetParameter(IntSet);
+};
 
+/**
+ * @brief A set parameter or a set variable. The parameter is kept out of
+ * line, so that the argument is no larger than a shared pointer and a tag.
+ * Copies of a parameter argument share the parameter.
+ */
+class IntSetArg : public std::variant<std::shared_ptr<const IntSetParameter>,
+                                      std::shared_ptr<const SetVar>> {
  public:
-  using std::variant<IntSet, std::shared_ptr<const SetVar>>::variant;
+  using std::variant<std::shared_ptr<const IntSetParameter>,
+                     std::shared_ptr<const SetVar>>::variant;
+  IntSetArg(IntSet);
 
   [[nodiscard]] bool isParameter() const;
   [[nodiscard]] bool isFixed() const;
@@ -75,20 +96,30 @@ class IntSetArg : public std::variant<IntSet, std::shared_ptr<const SetVar>> {
   [[nodiscard]] const IntSet& parameter() const;
 
   [[nodiscard]] const IntSet& toParameter() const;
-  std::shared_ptr<const SetVar> toVar(fznparser::Model&);
+  /**
+   * @return the argument if it is a variable, and otherwise the fixed SetVar
+   * of the parameter. That SetVar is added to the model of the first call,
+   * which owns it; later calls, also on copies of the argument or with the
+   * copy of a model, return it without adding it to their model.
+   */
+  std::shared_ptr<const SetVar> toVar(fznparser::Model&) const;
   bool operator==(const IntSetArg&) const;
   bool operator!=(const IntSetArg&) const;
   [[nodiscard]] std::string toString() const;
 };
 
+/**
+ * @brief An argument of a constraint. Sets and arrays are held by shared
+ * pointers, so that an argument is 32 bytes whatever it holds.
+ */
 class Arg : public std::variant<
-                BoolArg, IntArg, FloatArg, IntSetArg, FloatSet,
-                std::shared_ptr<BoolVarArray>, std::shared_ptr<IntVarArray>,
-                std::shared_ptr<FloatVarArray>, std::shared_ptr<SetVarArray>,
-                std::shared_ptr<FloatSetArray>> {
+                BoolArg, IntArg, FloatArg, IntSetArg,
+                std::shared_ptr<FloatSet>, std::shared_ptr<BoolVarArray>,
+                std::shared_ptr<IntVarArray>, std::shared_ptr<FloatVarArray>,
+                std::shared_ptr<SetVarArray>, std::shared_ptr<FloatSetArray>> {
  public:
   using std::variant<
-      BoolArg, IntArg, FloatArg, IntSetArg, FloatSet,
+      BoolArg, IntArg, FloatArg, IntSetArg, std::shared_ptr<FloatSet>,
       std::shared_ptr<BoolVarArray>, std::shared_ptr<IntVarArray>,
       std::shared_ptr<FloatVarArray>, std::shared_ptr<SetVarArray>,
       std::shared_ptr<FloatSetArray>>::variant;
@@ -100,6 +131,11 @@ class Arg : public std::variant<
 
   bool operator==(const Arg&) const;
   bool operator!=(const Arg&) const;
+  /**
+   * @return a hash that is equal for arguments that are equal. Variables are
+   * hashed by their identifiers.
+   */
+  [[nodiscard]] size_t hash() const;
   [[nodiscard]] std::string toString() const;
 };
 
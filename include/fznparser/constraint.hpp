@@ -38,6 +38,11 @@ class Constraint {
 
   bool operator==(const Constraint&) const;
   bool operator!=(const Constraint&) const;
+  /**
+   * @return a hash of the identifier, arguments and annotations that is equal
+   * for constraints that are equal
+   */
+  [[nodiscard]] size_t hash() const;
   [[nodiscard]] std::string toString() const;
 };
 
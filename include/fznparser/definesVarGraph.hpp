@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "fznparser/constraint.hpp"
+#include "fznparser/occurrenceIndex.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief The functional dependencies between the constraints that define
+ * variables (see Constraint::definedVar()).
+ *
+ * There is an edge from a defining constraint to every other defining
+ * constraint that has the variable it defines as an argument, i.e. whose
+ * defined variable depends on it. Constraints are referred to by their index
+ * in Model::constraints().
+ */
+class DefinesVarGraph {
+  size_t _numConstraints;
+  size_t _numDefiningConstraints{0};
+  // the successors of constraint c are _successors[_offsets[c]] to
+  // _successors[_offsets[c + 1] - 1]
+  std::vector<size_t> _offsets;
+  std::vector<uint32_t> _successors;
+  std::vector<uint32_t> _topologicalOrder;
+  std::vector<uint32_t> _cyclicConstraints;
+
+ public:
+  DefinesVarGraph(const std::vector<Constraint>& constraints,
+                  const OccurrenceIndex& occurrenceIndex);
+
+  [[nodiscard]] size_t numDefiningConstraints() const;
+
+  /**
+   * @return the defining constraints that have the variable that the
+   * constraint defines as an argument, which is empty if the constraint does
+   * not define a variable
+   */
+  [[nodiscard]] std::span<const uint32_t> successors(uint32_t constraint) const;
+
+  /**
+   * @return the defining constraints that are not in cyclicConstraints(),
+   * each after the defining constraints it depends on
+   */
+  [[nodiscard]] std::span<const uint32_t> topologicalOrder() const;
+
+  [[nodiscard]] bool hasCycle() const;
+  /**
+   * @return the defining constraints that are on a cycle or depend on a
+   * constraint on a cycle, in increasing order
+   */
+  [[nodiscard]] std::span<const uint32_t> cyclicConstraints() const;
+};
+
+}  // namespace fznparser
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "fznparser/constraint.hpp"
+#include "fznparser/solveType.hpp"
+#include "fznparser/variables.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief Receives the items of a FlatZinc model in source order, each one as
+ * soon as it has been parsed and transformed.
+ *
+ * The default implementations ignore the item, so a handler only needs to
+ * override the callbacks it is interested in.
+ */
+class ItemHandler {
+ public:
+  virtual ~ItemHandler() = default;
+
+  /**
+   * @brief Called for each variable declaration that is not an array
+   * (including variables that are aliases of other variables)
+   */
+  virtual void onVar(const Var&) {}
+  /**
+   * @brief Called for each array variable declaration
+   */
+  virtual void onArray(const Var&) {}
+  virtual void onConstraint(Constraint&&) {}
+  virtual void onSolve(SolveType&&) {}
+};
+
+}  // namespace fznparser
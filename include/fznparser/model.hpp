@@ -1,12 +1,16 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "fznparser/constraint.hpp"
+#include "fznparser/definesVarGraph.hpp"
+#include "fznparser/occurrenceIndex.hpp"
 #include "fznparser/solveType.hpp"
 #include "fznparser/types.hpp"
+#include "fznparser/varPools.hpp"
 #include "fznparser/variables.hpp"
 
 namespace fznparser {
@@ -21,6 +25,10 @@ class Model {
   std::unordered_map<double, std::shared_ptr<FloatVar>> _floatVarPars;
   std::vector<std::shared_ptr<SetVar>> _setVarPars;
 
+  std::shared_ptr<const OccurrenceIndex> _occurrenceIndex;
+  std::shared_ptr<const DefinesVarGraph> _definesVarGraph;
+  std::shared_ptr<const VarPools> _varPools;
+
  public:
   Model(const Model&) = default;
   Model(Model&&) = default;
@@ -57,6 +65,55 @@ class Model {
   bool isMaximisationProblem() const;
   bool isMinimisationProblem() const;
 
+  /**
+   * @brief Builds the index of the constraints each variable occurs in.
+   * Adding a variable or a constraint to the model discards the index.
+   */
+  void buildOccurrenceIndex();
+  bool hasOccurrenceIndex() const noexcept;
+  /**
+   * @throws FznException if the index has not been built
+   */
+  const OccurrenceIndex& occurrenceIndex() const;
+
+  /**
+   * @brief Builds the graph of the constraints that define variables, with
+   * its topological order. It uses the occurrence index if it has been built.
+   * Adding a variable or a constraint to the model discards the graph.
+   */
+  void buildDefinesVarGraph();
+  bool hasDefinesVarGraph() const noexcept;
+  /**
+   * @throws FznException if the graph has not been built
+   */
+  const DefinesVarGraph& definesVarGraph() const;
+
+  /**
+   * @brief Copies the variables, parameters and constraints into contiguous
+   * pools that refer to each other by 32-bit handles. Adding a variable or a
+   * constraint to the model discards the pools.
+   */
+  void buildVarPools();
+  bool hasVarPools() const noexcept;
+  /**
+   * @throws FznException if the pools have not been built
+   */
+  const VarPools& varPools() const;
+
+  /**
+   * @brief Removes the constraints that are equal to an earlier constraint,
+   * keeping the order of the others. The occurrence index, the defines_var
+   * graph and the pools are discarded if a constraint is removed.
+   *
+   * @return the number of constraints that were removed
+   */
+  size_t removeDuplicateConstraints();
+
+  /**
+   * @brief The models are equal if their variables and solve types are, and
+   * if they have the same constraints, in any order, the same number of
+   * times.
+   */
   bool operator==(const Model&) const;
   bool operator!=(const Model&) const;
   std::string toString() const;
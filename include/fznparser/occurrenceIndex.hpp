@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fznparser/constraint.hpp"
+#include "fznparser/variables.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief An occurrence of a variable in an argument of a constraint.
+ */
+struct Occurrence {
+  // the index of the constraint in Model::constraints()
+  uint32_t constraint;
+  // the index of the argument in Constraint::arguments()
+  uint32_t argument;
+  // the index of the variable in the argument if it is an array, and 0
+  // otherwise
+  uint32_t element;
+
+  bool operator==(const Occurrence&) const = default;
+};
+
+/**
+ * @brief For each variable, the constraints it occurs in, stored in
+ * compressed sparse rows.
+ *
+ * The basic (bool, int, float and set) variables of the model have the dense
+ * ids 0 to numVars() - 1, in the order of Model::vars(). Arrays and
+ * references are not given ids: an array that is an argument is resolved to
+ * the variables it holds, and a reference resolves to its source.
+ */
+class OccurrenceIndex {
+  std::vector<Var> _vars;
+  std::unordered_map<const VarBase*, uint32_t> _ids;
+  // the occurrences of the variable with id i are _occurrences[_offsets[i]]
+  // to _occurrences[_offsets[i + 1] - 1], ordered by constraint, argument and
+  // element
+  std::vector<size_t> _offsets;
+  std::vector<Occurrence> _occurrences;
+
+ public:
+  OccurrenceIndex(const std::unordered_map<std::string, Var>& vars,
+                  const std::vector<Constraint>& constraints);
+
+  [[nodiscard]] size_t numVars() const;
+  [[nodiscard]] size_t numOccurrences() const;
+
+  /**
+   * @return the basic variable with the id
+   */
+  [[nodiscard]] const Var& var(uint32_t id) const;
+  /**
+   * @return the id of the basic variable, or std::nullopt if it is not a
+   * variable of the model
+   */
+  [[nodiscard]] std::optional<uint32_t> id(const VarBase&) const;
+  /**
+   * @return the id of the basic variable or, for a reference, of its source,
+   * or std::nullopt if it is not a basic variable of the model
+   */
+  [[nodiscard]] std::optional<uint32_t> id(const Var&) const;
+
+  [[nodiscard]] std::span<const Occurrence> occurrences(uint32_t id) const;
+};
+
+}  // namespace fznparser
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "fznparser/model.hpp"
+
+namespace fznparser {
+
+/**
+ * @return a 128 bit hash of the content as 32 hexadecimal digits. It is not
+ * a cryptographic hash, and it is only stable between machines of the same
+ * byte order.
+ */
+std::string contentHash(std::string_view content);
+
+/**
+ * @brief An on-disk cache of parsed models, keyed by the hash of the FlatZinc
+ * they were parsed from. Each model is stored as a snapshot (see snapshot.hpp)
+ * in its own file in the cache directory, so a directory can be shared by
+ * several processes. The file also holds the size and a second, independent
+ * hash of the FlatZinc, which are checked when the model is loaded, so that
+ * a collision of contentHash does not return the model of other content.
+ *
+ * When the snapshots in the directory exceed the size cap, the least recently
+ * used ones are removed. A snapshot is used when it is stored or loaded, and
+ * the time it was last used is its modification time.
+ *
+ * Failing to read or write the cache is never an error: a snapshot that
+ * cannot be read is removed, and the model is parsed instead.
+ */
+class ParseCache {
+  std::filesystem::path _directory;
+  uintmax_t _maxBytes;
+
+ public:
+  /**
+   * @param directory the cache directory, which is created if it does not
+   * exist
+   * @param maxBytes the size cap of the snapshots in the directory
+   * @throws FznException if the directory cannot be created
+   */
+  ParseCache(std::filesystem::path directory, uintmax_t maxBytes);
+
+  [[nodiscard]] const std::filesystem::path& directory() const;
+  [[nodiscard]] uintmax_t maxBytes() const;
+
+  /**
+   * @return the path of the snapshot of the model parsed from the content
+   */
+  [[nodiscard]] std::filesystem::path entryPath(
+      std::string_view fznContent) const;
+
+  /**
+   * @return the model parsed from the content if it is cached
+   */
+  [[nodiscard]] std::optional<Model> load(std::string_view fznContent) const;
+
+  /**
+   * @brief Stores the model parsed from the content and then removes the
+   * least recently used snapshots while the cache exceeds its size cap.
+   *
+   * @return whether the model was stored
+   */
+  bool store(std::string_view fznContent, const Model&) const;
+
+  /**
+   * @return the total size of the snapshots in the cache directory
+   */
+  [[nodiscard]] uintmax_t sizeInBytes() const;
+
+  /**
+   * @brief Removes the least recently used snapshots until the snapshots in
+   * the cache directory take at most maxBytes.
+   */
+  void evict(uintmax_t maxBytes) const;
+};
+
+}  // namespace fznparser
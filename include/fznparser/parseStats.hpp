@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fznparser {
+
+/**
+ * @brief The phases of parsing a model, in the order in which they run.
+ */
+enum class ParsePhase : unsigned char {
+  // opening and mapping the file; its pages are only read when they are
+  // first accessed, which is during GRAMMAR
+  READ,
+  // building the syntax tree with the X3 grammar or the tokenizer
+  GRAMMAR,
+  // declaring the parameters and variables, and replacing empty sets and
+  // references to parameters in the syntax tree
+  REPLACE,
+  // validating the variable declarations
+  VALIDATE,
+  // transforming the variable declarations into variables
+  VARIABLES,
+  // transforming the constraint items into constraints
+  CONSTRAINTS
+};
+
+constexpr size_t numParsePhases = 6;
+
+std::string toString(ParsePhase);
+
+struct PhaseStats {
+  std::chrono::nanoseconds wallTime{0};
+  // the number of items the phase processed
+  size_t numItems{0};
+  // the number of bytes of input the phase consumed
+  size_t bytes{0};
+  // the peak resident set size of the process while the phase ran, or 0
+  // where the platform cannot reset the peak at the start of a phase, which
+  // only Linux can
+  size_t peakResidentBytes{0};
+};
+
+/**
+ * @brief Statistics about a single parse, per phase. A phase that is run
+ * several times, e.g. when a parse in parallel falls back to a sequential
+ * parse, accumulates its wall time.
+ */
+class ParseStats {
+  std::array<PhaseStats, numParsePhases> _phases{};
+
+ public:
+  [[nodiscard]] PhaseStats& phase(ParsePhase);
+  [[nodiscard]] const PhaseStats& phase(ParsePhase) const;
+
+  [[nodiscard]] std::chrono::nanoseconds totalWallTime() const;
+  /**
+   * @return the largest peak resident set size of the phases
+   */
+  [[nodiscard]] size_t peakResidentBytes() const;
+
+  /**
+   * @return one line per phase with its wall time, items, bytes and peak
+   * resident set size
+   */
+  [[nodiscard]] std::string toString() const;
+};
+
+}  // namespace fznparser
@@ -2,14 +2,75 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
+#include "fznparser/itemHandler.hpp"
 #include "fznparser/model.hpp"
+#include "fznparser/parseCache.hpp"
+#include "fznparser/parseStats.hpp"
 
 namespace fznparser {
 
+/**
+ * @brief Selects how FlatZinc is parsed.
+ */
+struct ParseOptions {
+  /**
+   * @brief Parse with the single-pass tokenizer and recursive-descent parser
+   * instead of the Boost Spirit X3 grammar. Both produce the same model.
+   */
+  bool useTokenizer{false};
+  /**
+   * @brief The number of threads that parse the model and transform its
+   * constraints, where 0 means one per hardware thread. The input is split at
+   * item boundaries into chunks of at least 64 KiB, so small inputs are parsed
+   * on the calling thread. Only the overloads that return a Model parse and
+   * transform in parallel; the constraints keep their source order.
+   */
+  unsigned int numThreads{1};
+  /**
+   * @brief If not nullptr, the wall time, items and bytes of each phase are
+   * recorded in it, and on Linux the peak resident set size of the process
+   * while the phase ran. To measure that peak, the peak of the process is
+   * reset at the start of each phase, which getrusage also reports. Only the
+   * overloads that return a Model collect statistics.
+   */
+  ParseStats* stats{nullptr};
+  /**
+   * @brief If not nullptr, a model that is cached for the same content is
+   * loaded from it instead of being parsed, and a model that is parsed is
+   * stored in it. Only the overloads that return a Model use the cache; the
+   * statistics of a model that is loaded only cover reading the file.
+   */
+  const ParseCache* cache{nullptr};
+  /**
+   * @brief Build the index of the constraints each variable occurs in (see
+   * Model::occurrenceIndex()) once the constraints have been transformed.
+   * Only the overloads that return a Model build the index.
+   */
+  bool buildOccurrenceIndex{false};
+};
+
 Model parseFznIstream(std::istream& fznStream);
-Model parseFznFile(const std::string& fznFilePath);
-Model parseFznString(const std::string& fznContent);
-Model parseFznString(std::string&& fznContent);
+Model parseFznFile(const std::string& fznFilePath,
+                   const ParseOptions& options = {});
+/**
+ * @brief Parses FlatZinc held in a contiguous buffer, in place and without
+ * copying it.
+ *
+ * @param fznContent the FlatZinc content; it only needs to outlive the call
+ */
+Model parseFznString(std::string_view fznContent,
+                     const ParseOptions& options = {});
+
+/**
+ * @brief Parses the file and passes each item to the handler in source order
+ * instead of materializing the model. Constraints are not retained after the
+ * handler has received them.
+ */
+void parseFznFile(const std::string& fznFilePath, ItemHandler& handler,
+                  const ParseOptions& options = {});
+void parseFznString(std::string_view fznContent, ItemHandler& handler,
+                    const ParseOptions& options = {});
 
 }  // namespace fznparser
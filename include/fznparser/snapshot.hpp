@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "fznparser/model.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief The version of the snapshot format that is written. A snapshot of
+ * any other version is rejected when it is read.
+ */
+constexpr uint32_t snapshotVersion = 2;
+
+/**
+ * @brief Writes the model in a compact binary format that can be read back
+ * much faster than the FlatZinc it was parsed from.
+ *
+ * The snapshot holds the variables, arrays, constraints, annotations and
+ * solve type. Objects that are shared in the model, such as a variable that
+ * is an element of an array and an argument of a constraint, are shared in
+ * the model that is read. The flags and links that are derived from
+ * annotations (output variables, defined variables and the variables that
+ * constraints define) are derived again when the snapshot is read.
+ */
+void writeSnapshot(const Model&, std::ostream&);
+void writeSnapshotFile(const Model&, const std::string& snapshotFilePath);
+
+/**
+ * @brief Reads a model written by writeSnapshot.
+ *
+ * @throws FznException if the content is not a snapshot of the current
+ * version or is truncated
+ */
+Model readSnapshotString(std::string_view snapshot);
+Model readSnapshotFile(const std::string& snapshotFilePath);
+
+}  // namespace fznparser
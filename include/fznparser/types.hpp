@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -7,9 +11,58 @@
 namespace fznparser {
 
 class IntSet {
-  std::variant<std::pair<int64_t, int64_t>, std::vector<int64_t>> _elements;
+  // the elements offset + i for the bits i that are set in words, for sets
+  // whose span is small compared to their size
+  struct Bitset {
+    int64_t offset;
+    std::vector<uint64_t> words;
+  };
+  // an interval, the enumerated elements, two or more sorted and disjoint
+  // intervals that are not adjacent, or a bitset
+  std::variant<std::pair<int64_t, int64_t>, std::vector<int64_t>,
+               std::vector<std::pair<int64_t, int64_t>>, Bitset>
+      _elements;
+
+  void assign(std::vector<std::pair<int64_t, int64_t>>&& intervals);
+  void advance(size_t& position, int64_t& value) const;
 
  public:
+  /**
+   * @brief Iterates over the elements in increasing order, without
+   * enumerating them up front.
+   */
+  class const_iterator {
+    const IntSet* _set;
+    // the index of the element, interval or bit that the iterator is at
+    size_t _position;
+    int64_t _value;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int64_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int64_t*;
+    using reference = const int64_t&;
+
+    const_iterator() : _set(nullptr), _position(0), _value(0) {}
+    const_iterator(const IntSet* set, size_t position, int64_t value)
+        : _set(set), _position(position), _value(value) {}
+
+    reference operator*() const { return _value; }
+    const_iterator& operator++() {
+      _set->advance(_position, _value);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const const_iterator& other) const {
+      return _position == other._position && _value == other._value;
+    }
+  };
+
   IntSet() = delete;
   IntSet(const IntSet&) = default;
   IntSet(IntSet&&) = default;
@@ -19,25 +72,67 @@ class IntSet {
   explicit IntSet(int64_t);
   IntSet(int64_t lb, int64_t ub);
   /**
-   * @brief Sorts and removes duplicates from the vector
+   * @brief Sorts and removes duplicates from the vector, and keeps the
+   * elements so that elements() returns them.
    *
    * @param elems the elements of the set
    */
   explicit IntSet(std::vector<int64_t>&& elems);
+  /**
+   * @brief Sorts and merges the intervals, and stores the set as the
+   * smallest of an interval list, a bitset and its elements.
+   *
+   * @param intervals the (lb, ub) intervals whose union is the set
+   */
+  explicit IntSet(std::vector<std::pair<int64_t, int64_t>>&& intervals);
 
   [[nodiscard]] bool contains(int64_t) const;
+  /**
+   * @brief Sets results[i] to whether the set contains values[i]. Runs of
+   * values in increasing order are looked up faster.
+   */
+  void contains(std::span<const int64_t> values,
+                std::span<bool> results) const;
   [[nodiscard]] size_t size() const;
   [[nodiscard]] int64_t lowerBound() const;
   [[nodiscard]] int64_t upperBound() const;
 
   [[nodiscard]] bool isInterval() const;
+  /**
+   * @return true if the set holds its elements, which elements() then
+   * returns, rather than the bounds of an interval. This is the case for
+   * every set built from elements, but sets built from intervals or by the
+   * set operations below are only stored as elements if that is smallest.
+   */
+  [[nodiscard]] bool hasElements() const;
 
+  /**
+   * @brief Enumerates the elements of the set, which can be expensive for
+   * sets that are not stored as elements.
+   */
   const std::vector<int64_t>& populateElements();
 
   [[nodiscard]] const std::vector<int64_t>& elements() const;
 
+  /**
+   * @return the maximal intervals of the set in increasing order
+   */
+  [[nodiscard]] std::vector<std::pair<int64_t, int64_t>> intervals() const;
+
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] const_iterator end() const;
+
+  [[nodiscard]] IntSet intersect(const IntSet&) const;
+  [[nodiscard]] IntSet unite(const IntSet&) const;
+  [[nodiscard]] IntSet subtract(const IntSet&) const;
+  [[nodiscard]] bool isSubsetOf(const IntSet&) const;
+
   bool operator==(const IntSet&) const;
   bool operator!=(const IntSet&) const;
+  /**
+   * @return a hash that is equal for sets that are equal
+   */
+  [[nodiscard]] size_t hash() const;
 
   [[nodiscard]] std::string toString() const;
 };
@@ -64,10 +159,18 @@ class FloatSet {
   [[nodiscard]] double upperBound() const;
 
   [[nodiscard]] bool isInterval() const;
+  /**
+   * @return true if the set holds its elements, which elements() then
+   * returns, rather than the bounds of an interval. This is the case for
+   * sets built from a vector of elements and for the empty set 1.0..0.0,
+   * but not for sets built from a single value or other bounds.
+   */
+  [[nodiscard]] bool hasElements() const;
   [[nodiscard]] const std::vector<double>& elements() const;
 
   bool operator==(const FloatSet&) const;
   bool operator!=(const FloatSet&) const;
+  [[nodiscard]] size_t hash() const;
 
   [[nodiscard]] std::string toString() const;
 };
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <boost/container/vector.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "fznparser/constraint.hpp"
+#include "fznparser/types.hpp"
+#include "fznparser/variables.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief A 32-bit reference to a parameter or a variable of type VarType in
+ * VarPools.
+ */
+template <class VarType>
+class Handle {
+  static constexpr uint32_t varBit = uint32_t{1} << 31;
+  // the index in the pool of parameters or of variables, with varBit set for
+  // variables
+  uint32_t _value;
+
+  explicit Handle(uint32_t value) : _value(value) {}
+
+ public:
+  static constexpr uint32_t maxIndex = varBit - 1;
+
+  static Handle parameter(uint32_t index) { return Handle(index); }
+  static Handle var(uint32_t index) { return Handle(index | varBit); }
+
+  [[nodiscard]] bool isParameter() const { return (_value & varBit) == 0; }
+  [[nodiscard]] uint32_t index() const { return _value & ~varBit; }
+
+  bool operator==(const Handle&) const = default;
+};
+
+using BoolHandle = Handle<BoolVar>;
+using IntHandle = Handle<IntVar>;
+using FloatHandle = Handle<FloatVar>;
+using SetHandle = Handle<SetVar>;
+
+/**
+ * @brief A 32-bit reference to an array of type ArrayType in VarPools.
+ */
+template <class ArrayType>
+struct ArrayHandle {
+  uint32_t index;
+
+  bool operator==(const ArrayHandle&) const = default;
+};
+
+/**
+ * @brief A 32-bit reference to a float set in VarPools, which is always a
+ * parameter.
+ */
+struct FloatSetHandle {
+  uint32_t index;
+
+  bool operator==(const FloatSetHandle&) const = default;
+};
+
+/**
+ * @brief An argument of a constraint in VarPools, with the alternatives of
+ * Arg in the same order.
+ */
+class PooledArg
+    : public std::variant<BoolHandle, IntHandle, FloatHandle, SetHandle,
+                          FloatSetHandle, ArrayHandle<BoolVarArray>,
+                          ArrayHandle<IntVarArray>, ArrayHandle<FloatVarArray>,
+                          ArrayHandle<SetVarArray>,
+                          ArrayHandle<FloatSetArray>> {
+ public:
+  using std::variant<BoolHandle, IntHandle, FloatHandle, SetHandle,
+                     FloatSetHandle, ArrayHandle<BoolVarArray>,
+                     ArrayHandle<IntVarArray>, ArrayHandle<FloatVarArray>,
+                     ArrayHandle<SetVarArray>,
+                     ArrayHandle<FloatSetArray>>::variant;
+};
+
+/**
+ * @brief A variable of the model in VarPools. References are resolved to
+ * their sources.
+ */
+class PooledVar
+    : public std::variant<BoolHandle, IntHandle, FloatHandle, SetHandle,
+                          ArrayHandle<BoolVarArray>, ArrayHandle<IntVarArray>,
+                          ArrayHandle<FloatVarArray>,
+                          ArrayHandle<SetVarArray>> {
+ public:
+  using std::variant<BoolHandle, IntHandle, FloatHandle, SetHandle,
+                     ArrayHandle<BoolVarArray>, ArrayHandle<IntVarArray>,
+                     ArrayHandle<FloatVarArray>,
+                     ArrayHandle<SetVarArray>>::variant;
+};
+
+/**
+ * @brief The variables, parameters and constraints of a model, stored by
+ * value in contiguous pools per type and referred to by 32-bit handles
+ * instead of shared pointers.
+ *
+ * The pools are immutable once built, so they can be traversed from several
+ * threads, without allocating and without touching reference counts. The
+ * variables of the model are pooled in the order of Model::vars(), followed
+ * by the variables that only occur in constraints. Annotations of
+ * constraints are not pooled.
+ */
+class VarPools {
+  template <typename ParType, class VarType>
+  struct Pool {
+    boost::container::vector<ParType> pars;
+    std::vector<VarType> vars;
+    // the elements of array a are elements[arrayOffsets[a]] to
+    // elements[arrayOffsets[a + 1] - 1]
+    std::vector<Handle<VarType>> elements;
+    std::vector<uint32_t> arrayOffsets{0};
+  };
+
+  // the pool indices of the variables and arrays that have been added, while
+  // the pools are built
+  using Indices = std::unordered_map<const void*, uint32_t>;
+
+  Pool<bool, BoolVar> _bools;
+  Pool<int64_t, IntVar> _ints;
+  Pool<double, FloatVar> _floats;
+  Pool<IntSet, SetVar> _sets;
+  std::vector<FloatSet> _floatSets;
+  // the elements of float set array a are
+  // _floatSetArrayElements[_floatSetArrayOffsets[a]] to
+  // _floatSetArrayElements[_floatSetArrayOffsets[a + 1] - 1]
+  std::vector<FloatSet> _floatSetArrayElements;
+  std::vector<uint32_t> _floatSetArrayOffsets{0};
+
+  std::vector<PooledVar> _vars;
+  // the arguments of constraint c are _arguments[_argumentOffsets[c]] to
+  // _arguments[_argumentOffsets[c + 1] - 1]
+  std::vector<uint32_t> _argumentOffsets{0};
+  std::vector<PooledArg> _arguments;
+  // the identifier of constraint c is _identifiers[_constraintIdentifiers[c]]
+  std::vector<uint32_t> _constraintIdentifiers;
+  std::vector<std::string> _identifiers;
+
+  template <typename ParType, class VarType>
+  Handle<VarType> addParameter(Pool<ParType, VarType>&, const ParType&);
+  template <typename ParType, class VarType>
+  Handle<VarType> addVar(Pool<ParType, VarType>&, const VarType&, Indices&);
+  template <class ArrayType, typename ParType, class VarType>
+  ArrayHandle<ArrayType> addArray(Pool<ParType, VarType>&, const ArrayType&,
+                                  Indices&);
+  ArrayHandle<FloatSetArray> addArray(const FloatSetArray&);
+  PooledVar addVar(const Var&, Indices&);
+  PooledArg addArg(const Arg&, Indices&);
+
+ public:
+  VarPools(const std::unordered_map<std::string, Var>& vars,
+           const std::vector<Constraint>& constraints);
+
+  [[nodiscard]] size_t numConstraints() const;
+
+  /**
+   * @return the variables of the model, in the order of Model::vars()
+   */
+  [[nodiscard]] std::span<const PooledVar> vars() const;
+
+  [[nodiscard]] const std::string& identifier(uint32_t constraint) const;
+  [[nodiscard]] std::span<const PooledArg> arguments(
+      uint32_t constraint) const;
+
+  [[nodiscard]] std::span<const BoolVar> boolVars() const;
+  [[nodiscard]] std::span<const IntVar> intVars() const;
+  [[nodiscard]] std::span<const FloatVar> floatVars() const;
+  [[nodiscard]] std::span<const SetVar> setVars() const;
+
+  /**
+   * @throws FznException if the handle is to a parameter
+   */
+  [[nodiscard]] const BoolVar& var(BoolHandle) const;
+  [[nodiscard]] const IntVar& var(IntHandle) const;
+  [[nodiscard]] const FloatVar& var(FloatHandle) const;
+  [[nodiscard]] const SetVar& var(SetHandle) const;
+
+  /**
+   * @throws FznException if the handle is to a variable
+   */
+  [[nodiscard]] bool parameter(BoolHandle) const;
+  [[nodiscard]] int64_t parameter(IntHandle) const;
+  [[nodiscard]] double parameter(FloatHandle) const;
+  [[nodiscard]] const IntSet& parameter(SetHandle) const;
+  [[nodiscard]] const FloatSet& parameter(FloatSetHandle) const;
+
+  [[nodiscard]] std::span<const BoolHandle> elements(
+      ArrayHandle<BoolVarArray>) const;
+  [[nodiscard]] std::span<const IntHandle> elements(
+      ArrayHandle<IntVarArray>) const;
+  [[nodiscard]] std::span<const FloatHandle> elements(
+      ArrayHandle<FloatVarArray>) const;
+  [[nodiscard]] std::span<const SetHandle> elements(
+      ArrayHandle<SetVarArray>) const;
+  [[nodiscard]] std::span<const FloatSet> elements(
+      ArrayHandle<FloatSetArray>) const;
+};
+
+}  // namespace fznparser
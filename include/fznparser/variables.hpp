@@ -2,7 +2,14 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <boost/container/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -83,6 +90,8 @@ class IntVar : public VarBase {
          std::vector<fznparser::Annotation>&& annotations = {});
   IntVar(std::vector<int64_t>&&, const std::string&,
          std::vector<fznparser::Annotation>&& annotations = {});
+  IntVar(IntSet&&, const std::string&,
+         std::vector<fznparser::Annotation>&& annotations = {});
 
   [[nodiscard]] const IntSet& domain() const;
 
@@ -172,38 +181,132 @@ class VarArrayTemplate : public VarArrayBase {
   static_assert(std::is_base_of_v<VarBase, VarType>,
                 "VarType must inherit VarBase");
 
+  // bit i % 64 of _isVar[i / 64] is set if element i is a variable, and
+  // _numVarsBefore[i / 64] is the number of variables before that word
+  std::vector<uint64_t> _isVar;
+  std::vector<size_t> _numVarsBefore;
+  // the parameters and the variables, each in the order of the array. Unlike
+  // std::vector<bool>, the boost vector stores booleans contiguously.
+  boost::container::vector<ParType> _pars;
+  std::vector<std::shared_ptr<const VarType>> _vars;
+  size_t _size{0};
+  // the size passed to reserve, as it is not known until the first append
+  // whether the elements are parameters or variables
+  size_t _reserved{0};
+
+  void appendTag(bool isVar) {
+    if (_size % 64 == 0) {
+      _isVar.push_back(0);
+      _numVarsBefore.push_back(_vars.size());
+    }
+    if (isVar) {
+      _isVar.back() |= uint64_t{1} << (_size % 64);
+    }
+    ++_size;
+  }
+
+  template <class Vector>
+  void reserveFirst(Vector& elements) {
+    if (elements.empty() && _reserved > _size) {
+      elements.reserve(_reserved - _size);
+    }
+  }
+
+  // the number of variables before the element at the index
+  [[nodiscard]] size_t numVarsBefore(size_t index) const {
+    const uint64_t below = (uint64_t{1} << (index % 64)) - 1;
+    return _numVarsBefore[index / 64] +
+           static_cast<size_t>(std::popcount(_isVar[index / 64] & below));
+  }
+
  protected:
-  std::vector<std::variant<ParType, std::shared_ptr<const VarType>>> _vars;
   VarArrayTemplate(const std::string& identifier,
                    std::vector<Annotation>&& annotations)
       : VarArrayBase(identifier, std::move(annotations)) {}
 
  public:
+  /**
+   * @brief An element of the array, which refers to the parameter or the
+   * variable rather than copying it into a variant.
+   */
+  class Element {
+    const ParType* _par;
+    const std::shared_ptr<const VarType>* _var;
+
+   public:
+    Element(const ParType* par, const std::shared_ptr<const VarType>* var)
+        : _par(par), _var(var) {}
+
+    [[nodiscard]] bool isParameter() const { return _var == nullptr; }
+    [[nodiscard]] const ParType& parameter() const { return *_par; }
+    [[nodiscard]] const std::shared_ptr<const VarType>& var() const {
+      return *_var;
+    }
+  };
+
+  /**
+   * @brief Iterates over the elements in order, counting the variables as it
+   * goes rather than ranking the tag bitmap for every element.
+   */
+  class const_iterator {
+    const VarArrayTemplate* _array;
+    size_t _index;
+    // the number of variables before the index
+    size_t _numVars;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Element;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Element;
+
+    const_iterator() : _array(nullptr), _index(0), _numVars(0) {}
+    const_iterator(const VarArrayTemplate* array, size_t index, size_t numVars)
+        : _array(array), _index(index), _numVars(numVars) {}
+
+    reference operator*() const {
+      if (_array->isParameter(_index)) {
+        return Element(&_array->_pars[_index - _numVars], nullptr);
+      }
+      return Element(nullptr, &_array->_vars[_numVars]);
+    }
+    const_iterator& operator++() {
+      if (!_array->isParameter(_index)) {
+        ++_numVars;
+      }
+      ++_index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const const_iterator& other) const {
+      return _index == other._index;
+    }
+  };
+
   VarArrayTemplate(const VarArrayTemplate&) = default;
   VarArrayTemplate(VarArrayTemplate&&) = default;
 
-  [[nodiscard]] bool isParArray() const {
-    return std::all_of(_vars.begin(), _vars.end(), [&](const auto& var) {
-      return std::holds_alternative<ParType>(var);
-    });
-  }
+  [[nodiscard]] bool isParArray() const { return _vars.empty(); }
+  [[nodiscard]] bool isVarArray() const { return _pars.empty(); }
 
   [[nodiscard]] bool isFixed() const override {
-    return std::all_of(_vars.begin(), _vars.end(), [&](const auto& var) {
-      return std::holds_alternative<ParType>(var) ||
-             std::get<std::shared_ptr<const VarType>>(var)->isFixed();
-    });
+    return std::all_of(_vars.begin(), _vars.end(),
+                       [&](const auto& var) { return var->isFixed(); });
   }
 
   [[nodiscard]] std::vector<ParType> toParVector() const {
     std::vector<ParType> parVector;
-    parVector.reserve(_vars.size());
-    for (const auto& var : _vars) {
-      if (std::holds_alternative<ParType>(var)) {
-        parVector.emplace_back(std::get<ParType>(var));
-      } else if (std::get<std::shared_ptr<const VarType>>(var)->isFixed()) {
-        parVector.emplace_back(
-            std::get<std::shared_ptr<const VarType>>(var)->lowerBound());
+    parVector.reserve(_size);
+    for (const auto element : *this) {
+      if (element.isParameter()) {
+        parVector.emplace_back(element.parameter());
+      } else if (element.var()->isFixed()) {
+        parVector.emplace_back(element.var()->lowerBound());
       } else {
         throw FznException("Cannot convert to parameter array");
       }
@@ -214,20 +317,78 @@ class VarArrayTemplate : public VarArrayBase {
   virtual std::vector<std::shared_ptr<const VarType>> toVarVector(
       fznparser::Model&) = 0;
 
-  void append(const ParType& par) { _vars.emplace_back(par); }
-  void append(std::shared_ptr<VarType> var) { _vars.emplace_back(var); }
-  void append(const VarType& var) {
-    _vars.emplace_back(std::make_shared<VarType>(var));
+  void reserve(size_t size) {
+    _reserved = size;
+    _isVar.reserve((size + 63) / 64);
+    _numVarsBefore.reserve((size + 63) / 64);
+  }
+  void append(const ParType& par) {
+    appendTag(false);
+    reserveFirst(_pars);
+    _pars.push_back(par);
+  }
+  void append(std::shared_ptr<VarType> var) {
+    appendTag(true);
+    reserveFirst(_vars);
+    _vars.emplace_back(std::move(var));
   }
+  void append(const VarType& var) { append(std::make_shared<VarType>(var)); }
   [[nodiscard]] std::string toString() const override = 0;
-  [[nodiscard]] size_t size() const { return _vars.size(); }
+  [[nodiscard]] size_t size() const { return _size; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0, 0}; }
+  [[nodiscard]] const_iterator end() const {
+    return {this, _size, _vars.size()};
+  }
+
+  /**
+   * @brief Whether the element at the index is a parameter rather than a
+   * variable. Together with parameter and var, this reads an element without
+   * copying it into a variant.
+   */
+  [[nodiscard]] bool isParameter(size_t index) const {
+    return ((_isVar[index / 64] >> (index % 64)) & 1) == 0;
+  }
+  [[nodiscard]] const ParType& parameter(size_t index) const {
+    return _pars[index - numVarsBefore(index)];
+  }
+  [[nodiscard]] const std::shared_ptr<const VarType>& var(size_t index) const {
+    return _vars[numVarsBefore(index)];
+  }
+
   std::variant<ParType, std::shared_ptr<const VarType>> operator[](
       size_t index) const {
-    return _vars[index];
+    if (isParameter(index)) {
+      return parameter(index);
+    }
+    return var(index);
   }
   [[nodiscard]] std::variant<ParType, std::shared_ptr<const VarType>> at(
       size_t index) const {
-    return _vars.at(index);
+    if (index >= _size) {
+      throw std::out_of_range("Array index out of range");
+    }
+    return operator[](index);
+  }
+
+  /**
+   * @brief The elements of a parameter array, which are stored contiguously.
+   */
+  [[nodiscard]] std::span<const ParType> parameters() const {
+    if (!isParArray()) {
+      throw FznException("Not a parameter array");
+    }
+    return {_pars.data(), _pars.size()};
+  }
+
+  /**
+   * @brief The elements of an array of only variables, which are stored
+   * contiguously.
+   */
+  [[nodiscard]] std::span<const std::shared_ptr<const VarType>> vars() const {
+    if (!isVarArray()) {
+      throw FznException("Not a variable array");
+    }
+    return _vars;
   }
 };
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace fznparser::parser {
+
+/**
+ * @brief A monotonic memory resource that the AST of a single parse is
+ * allocated from. Deallocation is a no-op; the memory is released at once
+ * when the arena is destroyed, so the arena must outlive every AST node
+ * allocated from it.
+ */
+class Arena {
+  std::pmr::monotonic_buffer_resource _resource;
+
+ public:
+  /**
+   * @param initialSize the size of the first block, e.g. the size of the
+   * input that is parsed
+   */
+  explicit Arena(size_t initialSize = 0);
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  std::pmr::memory_resource* resource() noexcept { return &_resource; }
+
+  /**
+   * @brief Makes the arena the current arena of the calling thread for the
+   * lifetime of the scope.
+   */
+  class Scope {
+    std::pmr::memory_resource* _previous;
+
+   public:
+    explicit Scope(Arena&) noexcept;
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope();
+  };
+};
+
+/**
+ * @return the resource of the current arena of the calling thread, or the
+ * global heap if there is none
+ */
+std::pmr::memory_resource* currentArena() noexcept;
+
+/**
+ * @brief Allocates from the current arena of the thread that constructed it.
+ *
+ * Unlike std::pmr::polymorphic_allocator, a default constructed allocator
+ * picks up the current arena, which is what lets the X3 grammar (which
+ * default constructs every attribute) build the AST inside an arena. The
+ * allocator moves and swaps along with its container, so AST nodes can be
+ * moved between chunks parsed in different arenas.
+ */
+template <typename T>
+class ArenaAllocator {
+  std::pmr::memory_resource* _resource;
+
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  ArenaAllocator() noexcept : _resource(currentArena()) {}
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : _resource(other.resource()) {}
+
+  [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+    return _resource;
+  }
+
+  T* allocate(const size_t n) {
+    return static_cast<T*>(_resource->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, const size_t n) noexcept {
+    _resource->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  // a copy is allocated from the current arena, not from the original's
+  [[nodiscard]] ArenaAllocator select_on_container_copy_construction() const {
+    return {};
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return _resource == other.resource();
+  }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace fznparser::parser
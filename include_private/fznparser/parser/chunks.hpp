@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace fznparser::parser {
+
+/**
+ * @brief Splits FlatZinc into at most maxChunks consecutive chunks of
+ * roughly equal size, but at least minChunkSize bytes, that can be parsed
+ * independently.
+ *
+ * Every chunk but the last ends with the ";" terminating an item. Semicolons
+ * inside string literals and comments are not item boundaries.
+ */
+std::vector<std::string_view> splitIntoChunks(std::string_view content,
+                                              size_t maxChunks,
+                                              size_t minChunkSize);
+
+}  // namespace fznparser::parser
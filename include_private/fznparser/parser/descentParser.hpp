@@ -0,0 +1,80 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fznparser/parser/grammarAst.hpp"
+#include "fznparser/parser/lexer.hpp"
+
+namespace fznparser::parser {
+
+/**
+ * @brief Hand-written recursive-descent parser that produces the same AST as
+ * the X3 grammar in grammarDef.hpp.
+ *
+ * Every production is chosen from the current token (array declarations look
+ * ahead to the token after "of"), so nothing is parsed twice. The item methods
+ * return std::nullopt without consuming anything when the next item is of
+ * another kind, and throw FznException on malformed input.
+ */
+class DescentParser {
+  Lexer _lexer;
+  // the array declaration that isArrayOfVar last looked ahead in, and whether
+  // it is of var, so that parDeclItem and varDeclItem do not both look ahead
+  const char* _arrayDecl{nullptr};
+  bool _arrayDeclIsOfVar{false};
+
+  [[nodiscard]] const Token& token() const noexcept { return _lexer.token(); }
+  [[nodiscard]] bool isKeyword(std::string_view) const;
+  bool isArrayOfVar();
+  bool accept(TokenKind);
+  bool acceptKeyword(std::string_view);
+  void expect(TokenKind);
+  void expectKeyword(std::string_view);
+
+  std::string identifier();
+  std::string varParIdentifier();
+  int64_t intLiteral();
+  double floatLiteral();
+  std::string stringLiteral();
+  ArenaVector<int64_t> intSet();
+
+  IndexSet indexSet();
+  BasicParType basicParType();
+  ParType parType();
+  template <typename Variant>
+  Variant basicVarType();
+  ArrayVarType arrayVarType();
+  template <typename Variant>
+  Variant basicPredParamType();
+  PredParamType predParamType();
+  PredParam predParam();
+
+  template <typename Variant>
+  Variant basicLiteralExpr();
+  template <typename Variant>
+  Variant basicExpr();
+  ArrayLiteral arrayLiteral();
+  Expr expr();
+  ParExpr parExpr();
+
+  BasicAnnExpr basicAnnExpr();
+  AnnExpr annExpr();
+  Annotation annotation();
+  Annotations annotations();
+
+ public:
+  explicit DescentParser(std::string_view content);
+
+  Model model();
+  std::optional<PredicateItem> predicateItem();
+  std::optional<ParDeclItem> parDeclItem();
+  std::optional<VarDeclItem> varDeclItem();
+  std::optional<ConstraintItem> constraintItem();
+  std::optional<SolveItem> solveItem();
+  [[nodiscard]] bool atEnd() const noexcept;
+};
+
+}  // namespace fznparser::parser
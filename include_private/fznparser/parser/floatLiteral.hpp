@@ -0,0 +1,17 @@
+#pragma once
+
+#include <charconv>
+
+namespace fznparser::parser {
+
+/**
+ * @brief Converts the float literal at the start of [first, last) like
+ * std::from_chars, except that a literal whose magnitude is too small to be
+ * represented, e.g. "1e-400", is converted to zero with its sign instead of
+ * being out of range. Only literals too large to be represented are out of
+ * range.
+ */
+std::from_chars_result floatFromChars(const char* first, const char* last,
+                                      double& value);
+
+}  // namespace fznparser::parser
@@ -6,7 +6,8 @@
 #include <boost/variant/apply_visitor.hpp>
 #include <optional>
 #include <string>
-#include <vector>
+
+#include "fznparser/parser/arena.hpp"
 
 namespace fznparser::parser {
 namespace x3 = ::boost::spirit::x3;
@@ -61,7 +62,7 @@ struct BasicVarIntTypeUnbounded {};
 struct BasicVarIntTypeBounded : IntRange {};
 
 // "var" "{" <int-literal> "," ... "}"
-struct BasicVarIntTypeSet : std::vector<int64_t> {};
+struct BasicVarIntTypeSet : ArenaVector<int64_t> {};
 
 /*
 | "var" "float"
@@ -80,7 +81,7 @@ struct BasicVarFloatTypeBounded : FloatRange {};
 */
 struct BasicVarSetTypeBounded : IntRange {};
 
-struct BasicVarSetTypeSet : std::vector<int64_t> {};
+struct BasicVarSetTypeSet : ArenaVector<int64_t> {};
 
 struct BasicVarSetTypeUnbounded {};
 
@@ -106,11 +107,11 @@ struct BasicPredParamTypeIntBounded : IntRange {};
 
 struct BasicPredParamTypeFloatBounded : FloatRange {};
 
-struct BasicPredParamTypeIntSet : std::vector<int64_t> {};
+struct BasicPredParamTypeIntSet : ArenaVector<int64_t> {};
 
 struct BasicPredParamTypeSetBounded : IntRange {};
 
-struct BasicPredParamTypeSetSet : std::vector<int64_t> {};
+struct BasicPredParamTypeSetSet : ArenaVector<int64_t> {};
 /*
 <basic-pred-param-type> ::= <basic-par-type>
                           | <basic-var-type>
@@ -156,9 +157,9 @@ struct PredParam {
 
 struct SetLiteralEmpty {};
 struct IntSetLiteralBounded : IntRange {};
-struct IntSetLiteralSet : std::vector<int64_t> {};
+struct IntSetLiteralSet : ArenaVector<int64_t> {};
 struct FloatSetLiteralBounded : FloatRange {};
-struct FloatSetLiteralSet : std::vector<double> {};
+struct FloatSetLiteralSet : ArenaVector<double> {};
 
 /*
 <basic-literal-expr> ::= <bool-literal>
@@ -181,7 +182,7 @@ using BasicExpr =
                    std::string>;
 
 // <array-literal> ::= "[" [ <basic-expr> "," ... ] "]"
-using ArrayLiteral = std::vector<BasicExpr>;
+using ArrayLiteral = ArenaVector<BasicExpr>;
 
 /*
 <expr>       ::= <basic-expr>
@@ -193,7 +194,7 @@ using Expr =
                    std::string, ArrayLiteral>;
 
 // <par-array-literal> ::= "[" [ <basic-literal-expr> "," ... ] "]"
-using ParArrayLiteral = std::vector<BasicLiteralExpr>;
+using ParArrayLiteral = ArenaVector<BasicLiteralExpr>;
 
 /*
 <par-expr>   ::= <basic-literal-expr>
@@ -242,7 +243,7 @@ using BasicAnnExpr =
 <ann-expr>   := <basic-ann-expr>
               | "[" [ <basic-ann-expr> "," ... ] "]"
 */
-using AnnExpr = std::vector<BasicAnnExpr>;
+using AnnExpr = ArenaVector<BasicAnnExpr>;
 
 /*
 <annotation> ::= <identifier>
@@ -250,13 +251,13 @@ using AnnExpr = std::vector<BasicAnnExpr>;
 */
 struct Annotation {
   std::string identifier;
-  std::vector<AnnExpr> expressions;
+  ArenaVector<AnnExpr> expressions;
 };
 
 /*
 <annotations> ::= [ "::" <annotation> ]*
 */
-using Annotations = std::vector<Annotation>;
+using Annotations = ArenaVector<Annotation>;
 
 // | <basic-var-type> ":" <var-par-identifier> <annotations> [ "=" <basic-expr>
 // ] ";"
@@ -290,8 +291,8 @@ using VarDeclItem = boost::variant<BasicVarDecl, ArrayVarDecl>;
 */
 struct ConstraintItem {
   std::string identifier;
-  std::vector<Expr> expressions;
-  std::vector<Annotation> annotations;
+  ArenaVector<Expr> expressions;
+  ArenaVector<Annotation> annotations;
 };
 
 /*
@@ -319,7 +320,7 @@ using SolveItem = boost::variant<SolveSatisfy, SolveOptimize>;
 */
 struct PredicateItem {
   std::string identifier;
-  std::vector<PredParam> params;
+  ArenaVector<PredParam> params;
 };
 
 /*
@@ -331,10 +332,10 @@ struct PredicateItem {
   <solve-item>
 */
 struct Model {
-  std::vector<PredicateItem> predicateItems;
-  std::vector<ParDeclItem> parDeclItems;
-  std::vector<VarDeclItem> varDeclItems;
-  std::vector<ConstraintItem> constraintItems;
+  ArenaVector<PredicateItem> predicateItems;
+  ArenaVector<ParDeclItem> parDeclItems;
+  ArenaVector<VarDeclItem> varDeclItems;
+  ArenaVector<ConstraintItem> constraintItems;
   SolveItem solveItem;
 };
 }  // namespace fznparser::parser
@@ -1,10 +1,20 @@
 #pragma once
 
 #include <boost/spirit/home/x3.hpp>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 
+#include "fznparser/parser/floatLiteral.hpp"
 #include "fznparser/parser/grammar.hpp"
 #include "fznparser/parser/grammarAst.hpp"
+#include "fznparser/simd.hpp"
 
 namespace fznparser::parser {
 
@@ -24,19 +34,87 @@ const auto negative_int = [](const auto &ctx) {
   x3::_pass(ctx) = attribute >= 0;
 };
 
-const auto double_is_finite = [](const auto &ctx) {
-  double &attribute = x3::_attr(ctx);
-  x3::traits::move_to(attribute, x3::_val(ctx));
-  x3::_pass(ctx) = std::isfinite(attribute);
+/*
+<float-literal> ::= [-]?[0-9]+.[0-9]+
+                  | [-]?[0-9]+.[0-9]+[Ee][-+]?[0-9]+
+                  | [-]?[0-9]+[Ee][-+]?[0-9]+
+
+Converted with std::from_chars, which rounds correctly, so that any finite
+double printed with std::to_chars is parsed back to the same double. A
+literal too small for a double is converted to zero.
+*/
+struct float_literal_parser : x3::parser<float_literal_parser> {
+  using attribute_type = double;
+  static bool const has_attribute = true;
+
+  static bool is_digit(const char c) { return '0' <= c && c <= '9'; }
+
+  // the end of the float literal that starts at first, after converting it to
+  // value, or nullptr if there is none. std::from_chars finds the end, so only
+  // the places where it is more lenient than the grammar are checked here.
+  static const char *convert(const char *first, const char *last,
+                             double &value) {
+    const char *integral = first != last && *first == '-' ? first + 1 : first;
+    const char *integralEnd = integral;
+    while (integralEnd != last && is_digit(*integralEnd)) {
+      ++integralEnd;
+    }
+    // rejects ".5", "inf" and "nan", and integer literals
+    if (integralEnd == integral || integralEnd == last) {
+      return nullptr;
+    }
+    if (*integralEnd == '.') {
+      // rejects "1." and "1.e5"
+      if (integralEnd + 1 == last || !is_digit(integralEnd[1])) {
+        return nullptr;
+      }
+    } else if (*integralEnd != 'e' && *integralEnd != 'E') {
+      return nullptr;
+    }
+    const auto [ptr, ec] = floatFromChars(first, last, value);
+    // fails for literals whose magnitude is too large for a double, and for
+    // "1e" without exponent digits
+    if (ec != std::errc{} || ptr == integralEnd) {
+      return nullptr;
+    }
+    return ptr;
+  }
+
+  template <typename Iterator, typename Context, typename RContext,
+            typename Attribute>
+  bool parse(Iterator &first, const Iterator &last, const Context &context,
+             const RContext &, Attribute &attribute) const {
+    x3::skip_over(first, last, context);
+    double value;
+    if constexpr (std::contiguous_iterator<Iterator>) {
+      const char *text = std::to_address(first);
+      const char *end =
+          convert(text, text + std::distance(first, last), value);
+      if (end == nullptr) {
+        return false;
+      }
+      first += end - text;
+    } else {
+      // e.g. istream iterators, which only give one character at a time
+      std::string text;
+      for (Iterator it = first; it != last && (is_digit(*it) || *it == '.' ||
+                                               *it == 'e' || *it == 'E' ||
+                                               *it == '-' || *it == '+');
+           ++it) {
+        text.push_back(*it);
+      }
+      const char *end = convert(text.data(), text.data() + text.size(), value);
+      if (end == nullptr) {
+        return false;
+      }
+      std::advance(first, end - text.data());
+    }
+    x3::traits::move_to(value, attribute);
+    return true;
+  }
 };
 
-template <typename ValueType>
-struct strict_real_policies : x3::strict_real_policies<ValueType> {
-  static bool const allow_leading_dot = false;
-  static bool const allow_trailing_dot = false;
-};
-// TODO: parse exponents
-const x3::real_parser<double, strict_real_policies<double>> float_parser{};
+const float_literal_parser float_parser{};
 
 const auto neg_hex = rule<struct neg_hex, int64_t>{
     "neg_hex"} = lit("-0x") >> (hex[negative_int]);
@@ -44,12 +122,19 @@ const auto neg_hex = rule<struct neg_hex, int64_t>{
 const auto neg_oct = rule<struct neg_ocr, int64_t>{
     "neg_oct"} = lit("-0o") >> (oct[negative_int]);
 
+/*
+<int-literal> ::= [-]?[0-9]+
+                | [-]?0x[0-9A-Fa-f]+
+                | [-]?0o[0-7]+
+
+x3::int64 also accepts an explicit plus sign, which the grammar does not.
+*/
 const auto int_literal = rule<struct int_literal, int64_t>{"int_literal"} =
     lexeme[(lit("0x") >> hex) | (lit("0o") >> oct) | neg_hex | neg_oct |
-           x3::int64];
+           (!lit('+') >> x3::int64)];
 
 const auto float_literal = rule<struct float_literal, double>{"float_literal"} =
-    float_parser[double_is_finite];
+    float_parser;
 
 /*
 <identifier> ::= [A-Za-z][A-Za-z0-9_]*
@@ -368,11 +453,101 @@ const auto basic_expr = rule<struct basic_expr, BasicExpr>{"basic_expr"} =
     lexeme[float_literal >> !(lit('.') | lit('e') | lit('E'))] |
     var_par_identifier;
 
+/*
+"[" [ <element> "," ... ] "]"
+
+Like lit('[') >> -(element % ',') >> lit(']'), but runs of decimal int
+literals, which make up most of the large arrays, are scanned by
+simd::scanIntList, and only the other elements are parsed with the element
+rule.
+*/
+template <typename Element, typename Container>
+struct array_literal_parser
+    : x3::parser<array_literal_parser<Element, Container>> {
+  using attribute_type = Container;
+  static bool const has_attribute = true;
+
+  Element element;
+
+  constexpr explicit array_literal_parser(const Element &element)
+      : element(element) {}
+
+  // parses a run of int literals, or else one element
+  template <typename Iterator, typename Context, typename RContext>
+  bool parse_elements(Iterator &first, const Iterator &last,
+                      const Context &context, const RContext &rcontext,
+                      Container &container) const {
+    Iterator it = first;
+    x3::skip_over(it, last, context);
+    if constexpr (std::contiguous_iterator<Iterator>) {
+      std::array<int64_t, 256> ints;
+      const char *text = std::to_address(it);
+      const simd::IntList list =
+          simd::scanIntList(text, text + std::distance(it, last), ints);
+      if (list.size > 0) {
+        container.insert(container.end(), ints.begin(),
+                         ints.begin() + list.size);
+        first = it + (list.end - text);
+        return true;
+      }
+    }
+    typename Container::value_type value;
+    if (!element.parse(it, last, context, rcontext, value)) {
+      return false;
+    }
+    container.push_back(std::move(value));
+    first = it;
+    return true;
+  }
+
+  template <typename Iterator, typename Context, typename RContext>
+  bool parse(Iterator &first, const Iterator &last, const Context &context,
+             const RContext &rcontext, x3::unused_type) const {
+    Container container;
+    return parse(first, last, context, rcontext, container);
+  }
+
+  template <typename Iterator, typename Context, typename RContext>
+  bool parse(Iterator &first, const Iterator &last, const Context &context,
+             const RContext &rcontext, Container &container) const {
+    Iterator it = first;
+    x3::skip_over(it, last, context);
+    if (it == last || *it != '[') {
+      return false;
+    }
+    ++it;
+    const size_t size = container.size();
+    if (parse_elements(it, last, context, rcontext, container)) {
+      while (true) {
+        Iterator next = it;
+        x3::skip_over(next, last, context);
+        if (next == last || *next != ',') {
+          break;
+        }
+        ++next;
+        if (!parse_elements(next, last, context, rcontext, container)) {
+          break;
+        }
+        it = next;
+      }
+    }
+    x3::skip_over(it, last, context);
+    if (it == last || *it != ']') {
+      container.erase(container.begin() + size, container.end());
+      return false;
+    }
+    first = ++it;
+    return true;
+  }
+};
+
 /*
 <array-literal> ::= "[" [ <basic-expr> "," ... ] "]"
 */
 const auto array_literal = rule<struct array_literal, ArrayLiteral>{
-    "array_literal"} = lit('[') >> -(basic_expr % ',') >> lit(']');
+    "array_literal"} =
+    array_literal_parser<std::remove_cv_t<decltype(basic_expr)>, ArrayLiteral>(
+        basic_expr);
 
 /*
 <expr>       ::= <basic-expr>
@@ -383,7 +558,9 @@ const auto expr = rule<struct expr, Expr>{"expr"} = basic_expr | array_literal;
 <par-array-literal> ::= "[" [ <basic-literal-expr> "," ... ] "]"
 */
 const auto par_array_literal = rule<struct par_array_literal, ParArrayLiteral>{
-    "par_array_literal"} = lit('[') >> -(basic_literal_expr % ',') >> lit(']');
+    "par_array_literal"} =
+    array_literal_parser<std::remove_cv_t<decltype(basic_literal_expr)>,
+                         ParArrayLiteral>(basic_literal_expr);
 
 /*
 <par-expr>   ::= <basic-literal-expr>
@@ -406,7 +583,8 @@ const auto par_decl_item =
 const auto string_literal =
     rule<struct string_literal, std::string>{"string_literal"} =
         lexeme[x3::char_('"') >>
-               *((lit("\\\"") >> attr('"')) | ~x3::char_('"')) >>
+               *((lit("\\\"") >> attr('"')) |
+                 (x3::char_('\\') >> x3::char_) | ~x3::char_('"')) >>
                x3::char_('"')];
 
 const annotation_type annotation{"annotation"};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <boost/variant/variant.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace fznparser::parser {
+
+/**
+ * @return the index of T in Ts, or -1 if T is not one of Ts
+ */
+template <typename T, typename... Ts>
+constexpr int variantIndex() {
+  constexpr bool matches[]{std::is_same_v<T, Ts>...};
+  for (size_t i = 0; i < sizeof...(Ts); ++i) {
+    if (matches[i]) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Whether the variant currently holds a T.
+ *
+ * Compares which() against an index computed at compile time, unlike
+ * comparing type() against typeid(T), which compares type names on some
+ * ABIs.
+ */
+template <typename T, typename... Ts>
+[[nodiscard]] bool holds(const boost::variant<Ts...>& variant) noexcept {
+  constexpr int index = variantIndex<T, Ts...>();
+  static_assert(index >= 0, "the variant cannot hold the type");
+  return variant.which() == index;
+}
+
+}  // namespace fznparser::parser
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fznparser::parser {
+
+enum class TokenKind : uint8_t {
+  END,
+  IDENTIFIER,
+  INT_LITERAL,
+  FLOAT_LITERAL,
+  STRING_LITERAL,
+  LEFT_PAREN,
+  RIGHT_PAREN,
+  LEFT_BRACKET,
+  RIGHT_BRACKET,
+  LEFT_BRACE,
+  RIGHT_BRACE,
+  COMMA,
+  COLON,
+  DOUBLE_COLON,
+  SEMICOLON,
+  EQUALS,
+  DOT_DOT
+};
+
+struct Token {
+  TokenKind kind{TokenKind::END};
+  // the characters of the token; for string literals without the quotes
+  std::string_view text;
+  int64_t intValue{0};
+  double floatValue{0};
+};
+
+/**
+ * @brief Splits FlatZinc into tokens in a single pass, classifying each
+ * character through a lookup table. Whitespace and comments are skipped.
+ *
+ * Keywords are returned as identifiers. The lexer is cheap to copy, which
+ * is how the parser looks ahead.
+ */
+class Lexer {
+  const char* _begin;
+  const char* _pos;
+  const char* _end;
+  Token _token;
+
+  void skipWhitespaceAndComments();
+  void lexNumber();
+  void lexString();
+
+ public:
+  explicit Lexer(std::string_view content);
+
+  [[nodiscard]] const Token& token() const noexcept { return _token; }
+  void advance();
+
+  /**
+   * @brief The line (starting at 1) of the current token, for error messages
+   */
+  [[nodiscard]] size_t line() const;
+  [[noreturn]] void fail(const std::string& expected) const;
+};
+
+std::string toString(TokenKind);
+
+}  // namespace fznparser::parser
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+
+#include "fznparser/parseStats.hpp"
+
+namespace fznparser {
+
+/**
+ * @brief Resets the peak resident set size of the process to its current
+ * resident set size, which only Linux supports.
+ *
+ * @return whether the peak was reset
+ */
+bool resetPeakResidentBytes();
+
+/**
+ * @return the peak resident set size of the process since it was last reset,
+ * or 0 where the platform does not report it
+ */
+size_t peakResidentBytes();
+
+/**
+ * @brief Adds the wall time of its lifetime to a phase and records the peak
+ * resident set size of the process during its lifetime. It does nothing if
+ * no statistics are collected.
+ */
+class PhaseTimer {
+  PhaseStats* _phase;
+  // whether the peak resident set size was reset when the phase started
+  bool _measuresPeak{false};
+  std::chrono::steady_clock::time_point _start;
+
+ public:
+  PhaseTimer(ParseStats*, ParsePhase);
+  PhaseTimer(const PhaseTimer&) = delete;
+  PhaseTimer& operator=(const PhaseTimer&) = delete;
+  ~PhaseTimer();
+};
+
+}  // namespace fznparser
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace fznparser::simd {
+
+/**
+ * @brief The instruction set that the functions below were compiled for:
+ * "avx2", "sse4.2" or "scalar".
+ */
+const char* instructionSet();
+
+/**
+ * @brief Like std::ranges::lower_bound, but the last few elements of the
+ * search are compared at once with vector instructions.
+ *
+ * @return the index of the first element that is not less than the value,
+ * or sorted.size() if there is none
+ */
+size_t lowerBound(std::span<const int64_t> sorted, int64_t value);
+
+/**
+ * @brief Like lowerBound, but in time logarithmic in the distance to the
+ * lower bound rather than in the size, for searches that continue where the
+ * previous one ended.
+ */
+size_t gallop(std::span<const int64_t> sorted, int64_t value);
+
+/**
+ * @return true if every element of the sorted subset is in the sorted
+ * superset
+ */
+bool includes(std::span<const int64_t> superset,
+              std::span<const int64_t> subset);
+
+/**
+ * @brief A run of int literals parsed by scanIntList.
+ */
+struct IntList {
+  // the end of the last int literal of the run
+  const char* end;
+  size_t size;
+};
+
+/**
+ * @brief Parses a run of decimal int literals separated by commas, such as
+ * the elements of a long coefficient array, classifying 64 characters at a
+ * time with vector instructions. The run starts at first and stops before the
+ * first element that is not a decimal int literal followed, after any
+ * whitespace, by a comma or ']', such as an identifier, a float, a set or a
+ * hexadecimal or octal literal, or once ints is full.
+ *
+ * @return the run, whose ints are written to the start of ints. It ends at
+ * first if it is empty.
+ */
+IntList scanIntList(const char* first, const char* last,
+                    std::span<int64_t> ints);
+
+}  // namespace fznparser::simd
@@ -1,21 +1,79 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "fznparser/arguments.hpp"
 #include "fznparser/constraint.hpp"
 #include "fznparser/model.hpp"
+#include "fznparser/parseStats.hpp"
 #include "fznparser/parser/grammarAst.hpp"
 #include "fznparser/solveType.hpp"
+#include "fznparser/transformer/symbolTable.hpp"
 #include "fznparser/variables.hpp"
 
 namespace fznparser {
 
+/**
+ * @brief Transformed variables, indexed by the symbol ids of their
+ * identifiers.
+ */
+class VarTable {
+  const SymbolTable& _symbols;
+  std::vector<std::optional<Var>> _vars;
+
+ public:
+  explicit VarTable(const SymbolTable&);
+
+  /**
+   * @return the variable, or nullptr if no variable with the identifier has
+   * been added
+   */
+  [[nodiscard]] const Var* find(std::string_view identifier) const;
+  /**
+   * @brief Adds the variable unless one with the same id already exists.
+   *
+   * @return the variable with the id
+   */
+  Var& emplace(SymbolId, Var&&);
+};
+
+/**
+ * @brief The element type of an argument array literal.
+ */
+enum class ArgArrayType : uint8_t { BOOL, INT, FLOAT, INT_SET, FLOAT_SET };
+
 class ModelTransformer {
   parser::Model _model;
-  std::unordered_map<std::string, parser::PredicateItem> _predDeclItems;
-  std::unordered_map<std::string, parser::ParDeclItem> _parDeclItems;
-  std::unordered_map<std::string, parser::VarDeclItem> _varDeclItems;
+  // the identifiers of all parameters and variables, interned when declared
+  SymbolTable _symbols;
+  // indexed by symbol id, holding the index of the declaration in
+  // _model.parDeclItems and _model.varDeclItems respectively, or noItem
+  static constexpr size_t noItem = std::numeric_limits<size_t>::max();
+  std::vector<size_t> _parDeclItems;
+  std::vector<size_t> _varDeclItems;
+  // the variables transformed so far when items are added one at a time
+  VarTable _vars{_symbols};
+  std::unordered_map<std::string, Var> _varMap;
+  // the statistics the phases are recorded in, or nullptr
+  ParseStats* _stats{nullptr};
+
+  struct Declaration {
+    const parser::ParDeclItem* parDeclItem{nullptr};
+    const parser::VarDeclItem* varDeclItem{nullptr};
+  };
+
+  SymbolId declare(std::string_view identifier);
+  /**
+   * @brief Resolves the identifier with a single symbol lookup. Both members
+   * are nullptr if the identifier is not declared.
+   */
+  [[nodiscard]] Declaration declaration(std::string_view identifier) const;
 
   void replaceParameters(parser::VarDeclItem&);
   void replaceParameters(parser::BasicVarDecl&);
@@ -28,32 +86,64 @@ class ModelTransformer {
   void validate(const parser::ArrayVarDecl&) const;
   void validate(const parser::Annotation&) const;
 
-  const std::type_info& arrayType(
-      const std::unordered_map<std::string, Var>& vars,
+  /**
+   * @return the type of the argument array, or std::nullopt if the literal
+   * cannot be an argument array
+   */
+  [[nodiscard]] std::optional<ArgArrayType> arrayType(
       const parser::ArrayLiteral&) const;
 
-  static Var transform(const std::unordered_map<std::string, Var>&,
-                       const parser::VarDeclItem&);
-  static Var transformVar(const std::unordered_map<std::string, Var>&,
-                          const parser::BasicVarDecl&);
-  static Var transformVarArray(const std::unordered_map<std::string, Var>&,
-                               const parser::ArrayVarDecl&);
-  Arg transformArgument(const std::unordered_map<std::string, Var>&,
-                        const parser::Expr&);
-  Arg transformArgArray(const std::unordered_map<std::string, Var>&,
-                        const parser::ArrayLiteral&) const;
-  Constraint transform(const std::unordered_map<std::string, Var>&,
-                       const parser::ConstraintItem&);
-  SolveType transform(const std::unordered_map<std::string, Var>&,
-                      const parser::SolveItem&) const;
+  static Var transform(const VarTable&, const parser::VarDeclItem&);
+  static Var transformVar(const VarTable&, const parser::BasicVarDecl&);
+  static Var transformVarArray(const VarTable&, const parser::ArrayVarDecl&);
+  Arg transformArgument(const VarTable&, const parser::Expr&);
+  Arg transformArgArray(const VarTable&, const parser::ArrayLiteral&) const;
+  Constraint transform(const VarTable&, const parser::ConstraintItem&);
+  SolveType transform(const VarTable&, const parser::SolveItem&) const;
+  /**
+   * @brief Transforms the constraint items of the model on up to numThreads
+   * threads, keeping them in source order. The variables are only read.
+   */
+  std::vector<Constraint> transformConstraints(
+      const VarTable&, const std::unordered_map<std::string, Var>& varMap,
+      size_t numThreads);
 
  public:
   ModelTransformer(const ModelTransformer&) = delete;
   ModelTransformer& operator=(const ModelTransformer&) = delete;
   ModelTransformer(ModelTransformer&&) = delete;
-  explicit ModelTransformer(parser::Model&& model);
+  /**
+   * @brief Creates a transformer whose items are added one at a time, in
+   * source order, via the add* and transform* methods.
+   */
+  ModelTransformer() = default;
+  /**
+   * @param stats if not nullptr, the replace and validate phases, and later
+   * the phases of generateModel, are recorded in it
+   */
+  explicit ModelTransformer(parser::Model&& model,
+                            ParseStats* stats = nullptr);
+
+  /**
+   * @param numThreads the number of threads that transform the constraints;
+   * if an item cannot be transformed, the exception of the first such item in
+   * source order is thrown regardless of the number of threads
+   * @param buildOccurrenceIndex whether to build the occurrence index of the
+   * model
+   */
+  fznparser::Model generateModel(size_t numThreads = 1,
+                                 bool buildOccurrenceIndex = false);
 
-  fznparser::Model generateModel();
+  void addParDeclItem(parser::ParDeclItem&&);
+  /**
+   * @brief Validates and transforms the declaration. Only the type of the
+   * declaration is kept for validating later items.
+   *
+   * @return the transformed variable
+   */
+  const Var& addVarDeclItem(parser::VarDeclItem&&);
+  Constraint transformConstraintItem(parser::ConstraintItem&&);
+  SolveType transformSolveItem(const parser::SolveItem&) const;
 };
 
 }  // namespace fznparser
\ No newline at end of file
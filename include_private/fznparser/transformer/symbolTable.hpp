@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace fznparser {
+
+using SymbolId = uint32_t;
+
+/**
+ * @brief Interns identifiers: every distinct identifier is stored once and
+ * numbered densely from 0 in the order it was first interned, so that
+ * per-identifier data can be kept in vectors indexed by the id.
+ */
+class SymbolTable {
+  // a deque never relocates its elements, so the keys of _ids stay valid
+  std::deque<std::string> _names;
+  std::unordered_map<std::string_view, SymbolId> _ids;
+
+ public:
+  SymbolTable() = default;
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+  SymbolTable(SymbolTable&&) = default;
+  SymbolTable& operator=(SymbolTable&&) = default;
+
+  void reserve(size_t);
+
+  /**
+   * @brief Returns the id of the identifier, assigning the next id if it has
+   * not been interned before.
+   */
+  SymbolId intern(std::string_view);
+  [[nodiscard]] std::optional<SymbolId> find(std::string_view) const;
+  [[nodiscard]] const std::string& name(SymbolId) const;
+  [[nodiscard]] size_t size() const noexcept;
+};
+
+}  // namespace fznparser
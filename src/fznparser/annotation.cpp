@@ -1,5 +1,6 @@
 #include "fznparser/annotation.hpp"
 
+#include <boost/container_hash/hash.hpp>
 #include <array>
 #include <functional>
 #include <string>
@@ -52,6 +53,17 @@ bool Annotation::operator!=(const Annotation& other) const {
   return !operator==(other);
 }
 
+size_t Annotation::hash() const {
+  size_t seed = std::hash<std::string>{}(_identifier);
+  for (const std::vector<AnnotationExpression>& expressions : _expressions) {
+    boost::hash_combine(seed, expressions.size());
+    for (const AnnotationExpression& expression : expressions) {
+      boost::hash_combine(seed, expression.hash());
+    }
+  }
+  return seed;
+}
+
 std::string Annotation::toString() const {
   std::string s(_identifier);
   if (!_expressions.empty()) {
@@ -106,6 +118,26 @@ bool AnnotationExpression::operator!=(const AnnotationExpression& other) const {
   return !operator==(other);
 }
 
+size_t AnnotationExpression::hash() const {
+  size_t seed = index();
+  if (holds_alternative<bool>(*this)) {
+    boost::hash_combine(seed, get<bool>(*this));
+  } else if (holds_alternative<int64_t>(*this)) {
+    boost::hash_combine(seed, get<int64_t>(*this));
+  } else if (holds_alternative<double>(*this)) {
+    boost::hash_combine(seed, get<double>(*this));
+  } else if (holds_alternative<IntSet>(*this)) {
+    boost::hash_combine(seed, get<IntSet>(*this).hash());
+  } else if (holds_alternative<FloatSet>(*this)) {
+    boost::hash_combine(seed, get<FloatSet>(*this).hash());
+  } else if (holds_alternative<std::string>(*this)) {
+    boost::hash_combine(seed, get<std::string>(*this));
+  } else if (holds_alternative<Annotation>(*this)) {
+    boost::hash_combine(seed, get<Annotation>(*this).hash());
+  }
+  return seed;
+}
+
 std::string AnnotationExpression::toString() const {
   if (holds_alternative<bool>(*this)) {
     return get<bool>(*this) ? "true" : "false";
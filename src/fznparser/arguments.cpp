@@ -1,7 +1,9 @@
 #include "fznparser/arguments.hpp"
 
+#include <boost/container_hash/hash.hpp>
 #include <array>
 #include <unordered_set>
+#include <utility>
 
 #include "fznparser/except.hpp"
 #include "fznparser/model.hpp"
@@ -177,13 +179,20 @@ std::string FloatArg::toString() const {
   return var()->identifier();
 }
 
-bool IntSetArg::isParameter() const { return holds_alternative<IntSet>(*this); }
+IntSetParameter::IntSetParameter(IntSet intSet) : intSet(std::move(intSet)) {}
+
+IntSetArg::IntSetArg(IntSet intSet)
+    : variant(std::make_shared<const IntSetParameter>(std::move(intSet))) {}
+
+bool IntSetArg::isParameter() const {
+  return holds_alternative<shared_ptr<const IntSetParameter>>(*this);
+}
 
 bool IntSetArg::isFixed() const { return isParameter() || var()->isFixed(); }
 
 const IntSet& IntSetArg::parameter() const {
   if (isParameter()) {
-    return get<IntSet>(*this);
+    return get<shared_ptr<const IntSetParameter>>(*this)->intSet;
   }
   throw FznException("Argument is not a parameter");
 }
@@ -197,20 +206,19 @@ shared_ptr<const SetVar> IntSetArg::var() const {
 
 const IntSet& IntSetArg::toParameter() const {
   if (isParameter()) {
-    return get<IntSet>(*this);
+    return get<shared_ptr<const IntSetParameter>>(*this)->intSet;
   }
   throw FznException("Argument is not a parameter");
 }
 
-shared_ptr<const SetVar> IntSetArg::toVar(Model& model) {
-  if (_setVar != nullptr) {
-    return _setVar;
-  }
-  if (isParameter()) {
-    _setVar = model.addSetVarPar(toParameter());
-    return _setVar;
+shared_ptr<const SetVar> IntSetArg::toVar(Model& model) const {
+  if (!isParameter()) {
+    return var();
   }
-  return var();
+  const IntSetParameter& par = *get<shared_ptr<const IntSetParameter>>(*this);
+  std::call_once(par.setVarCreated,
+                 [&] { par.setVar = model.addSetVarPar(par.intSet); });
+  return par.setVar;
 }
 
 bool IntSetArg::operator==(const IntSetArg& other) const {
@@ -308,9 +316,10 @@ bool Arg::operator==(const Arg& other) const {
       holds_alternative<IntSetArg>(other)) {
     return get<IntSetArg>(*this).operator==(get<IntSetArg>(other));
   }
-  if (holds_alternative<FloatSet>(*this) &&
-      holds_alternative<FloatSet>(other)) {
-    return get<FloatSet>(*this).operator==(get<FloatSet>(other));
+  if (holds_alternative<std::shared_ptr<FloatSet>>(*this) &&
+      holds_alternative<std::shared_ptr<FloatSet>>(other)) {
+    return get<std::shared_ptr<FloatSet>>(*this)->operator==(
+        *get<std::shared_ptr<FloatSet>>(other));
   }
   if (holds_alternative<std::shared_ptr<BoolVarArray>>(*this) &&
       holds_alternative<std::shared_ptr<BoolVarArray>>(other)) {
@@ -342,6 +351,68 @@ bool Arg::operator==(const Arg& other) const {
 
 bool Arg::operator!=(const Arg& other) const { return !operator==(other); }
 
+template <typename ParType>
+size_t parHash(const ParType& par) {
+  if constexpr (std::is_same_v<ParType, IntSet>) {
+    return par.hash();
+  } else {
+    return boost::hash<ParType>{}(par);
+  }
+}
+
+template <class ScalarArg>
+size_t scalarHash(const ScalarArg& arg) {
+  return arg.isParameter() ? parHash(arg.parameter())
+                           : std::hash<std::string>{}(arg.var()->identifier());
+}
+
+template <typename ParType, class VarType>
+size_t arrayHash(const VarArrayTemplate<ParType, VarType>& array) {
+  size_t seed = std::hash<std::string>{}(array.identifier());
+  boost::hash_combine(seed, array.size());
+  for (const auto element : array) {
+    boost::hash_combine(
+        seed, element.isParameter()
+                  ? parHash(element.parameter())
+                  : std::hash<std::string>{}(element.var()->identifier()));
+  }
+  return seed;
+}
+
+size_t Arg::hash() const {
+  size_t seed = index();
+  if (holds_alternative<BoolArg>(*this)) {
+    boost::hash_combine(seed, scalarHash(get<BoolArg>(*this)));
+  } else if (holds_alternative<IntArg>(*this)) {
+    boost::hash_combine(seed, scalarHash(get<IntArg>(*this)));
+  } else if (holds_alternative<FloatArg>(*this)) {
+    boost::hash_combine(seed, scalarHash(get<FloatArg>(*this)));
+  } else if (holds_alternative<IntSetArg>(*this)) {
+    boost::hash_combine(seed, scalarHash(get<IntSetArg>(*this)));
+  } else if (holds_alternative<std::shared_ptr<FloatSet>>(*this)) {
+    boost::hash_combine(seed, get<std::shared_ptr<FloatSet>>(*this)->hash());
+  } else if (holds_alternative<std::shared_ptr<BoolVarArray>>(*this)) {
+    boost::hash_combine(seed,
+                        arrayHash(*get<std::shared_ptr<BoolVarArray>>(*this)));
+  } else if (holds_alternative<std::shared_ptr<IntVarArray>>(*this)) {
+    boost::hash_combine(seed,
+                        arrayHash(*get<std::shared_ptr<IntVarArray>>(*this)));
+  } else if (holds_alternative<std::shared_ptr<FloatVarArray>>(*this)) {
+    boost::hash_combine(seed,
+                        arrayHash(*get<std::shared_ptr<FloatVarArray>>(*this)));
+  } else if (holds_alternative<std::shared_ptr<SetVarArray>>(*this)) {
+    boost::hash_combine(seed,
+                        arrayHash(*get<std::shared_ptr<SetVarArray>>(*this)));
+  } else if (holds_alternative<std::shared_ptr<FloatSetArray>>(*this)) {
+    const FloatSetArray& array = *get<std::shared_ptr<FloatSetArray>>(*this);
+    boost::hash_combine(seed, array.size());
+    for (const FloatSet& floatSet : array) {
+      boost::hash_combine(seed, floatSet.hash());
+    }
+  }
+  return seed;
+}
+
 std::string Arg::toString() const {
   if (holds_alternative<BoolArg>(*this)) {
     return get<BoolArg>(*this).toString();
@@ -355,8 +426,8 @@ std::string Arg::toString() const {
   if (holds_alternative<IntSetArg>(*this)) {
     return get<IntSetArg>(*this).toString();
   }
-  if (holds_alternative<FloatSet>(*this)) {
-    return get<FloatSet>(*this).toString();
+  if (holds_alternative<std::shared_ptr<FloatSet>>(*this)) {
+    return get<std::shared_ptr<FloatSet>>(*this)->toString();
   }
   if (holds_alternative<std::shared_ptr<BoolVarArray>>(*this)) {
     return get<std::shared_ptr<BoolVarArray>>(*this)->toString();
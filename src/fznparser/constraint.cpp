@@ -1,5 +1,6 @@
 #include "fznparser/constraint.hpp"
 
+#include <boost/container_hash/hash.hpp>
 #include <memory>
 #include <string>
 #include <utility>
@@ -99,6 +100,17 @@ bool Constraint::operator!=(const Constraint& other) const {
   return !operator==(other);
 }
 
+size_t Constraint::hash() const {
+  size_t seed = std::hash<std::string>{}(_identifier);
+  for (const Arg& argument : _arguments) {
+    boost::hash_combine(seed, argument.hash());
+  }
+  for (const Annotation& annotation : _annotations) {
+    boost::hash_combine(seed, annotation.hash());
+  }
+  return seed;
+}
+
 std::string Constraint::toString() const {
   std::string s = _identifier + "(";
   for (size_t i = 0; i < _arguments.size(); ++i) {
@@ -0,0 +1,92 @@
+#include "fznparser/definesVarGraph.hpp"
+
+#include <optional>
+#include <string>
+
+#include "fznparser/except.hpp"
+
+namespace fznparser {
+
+DefinesVarGraph::DefinesVarGraph(const std::vector<Constraint>& constraints,
+                                 const OccurrenceIndex& occurrenceIndex)
+    : _numConstraints(constraints.size()) {
+  std::vector<bool> isDefining(constraints.size(), false);
+  // the id of the variable each constraint defines
+  std::vector<std::optional<uint32_t>> definedVars(constraints.size());
+  for (size_t c = 0; c < constraints.size(); ++c) {
+    const std::optional<const Var> definedVar = constraints[c].definedVar();
+    if (definedVar.has_value()) {
+      isDefining[c] = true;
+      definedVars[c] = occurrenceIndex.id(*definedVar);
+      ++_numDefiningConstraints;
+    }
+  }
+
+  // the successors of a defining constraint are the other defining
+  // constraints in which its variable occurs; a constraint in which it occurs
+  // several times is a successor as many times
+  _offsets.assign(constraints.size() + 1, 0);
+  std::vector<size_t> inDegrees(constraints.size(), 0);
+  for (size_t c = 0; c < constraints.size(); ++c) {
+    _offsets[c + 1] = _offsets[c];
+    if (!definedVars[c].has_value()) {
+      continue;
+    }
+    for (const Occurrence& occurrence :
+         occurrenceIndex.occurrences(*definedVars[c])) {
+      const uint32_t successor = occurrence.constraint;
+      if (successor != c && isDefining[successor]) {
+        _successors.push_back(successor);
+        ++inDegrees[successor];
+        ++_offsets[c + 1];
+      }
+    }
+  }
+
+  // Kahn's algorithm: a constraint is ordered once all the constraints it
+  // depends on are, so the constraints that are left are on or behind cycles
+  _topologicalOrder.reserve(_numDefiningConstraints);
+  for (size_t c = 0; c < constraints.size(); ++c) {
+    if (isDefining[c] && inDegrees[c] == 0) {
+      _topologicalOrder.push_back(static_cast<uint32_t>(c));
+    }
+  }
+  for (size_t i = 0; i < _topologicalOrder.size(); ++i) {
+    for (const uint32_t successor : successors(_topologicalOrder[i])) {
+      if (--inDegrees[successor] == 0) {
+        _topologicalOrder.push_back(successor);
+      }
+    }
+  }
+  for (size_t c = 0; c < constraints.size(); ++c) {
+    if (inDegrees[c] > 0) {
+      _cyclicConstraints.push_back(static_cast<uint32_t>(c));
+    }
+  }
+}
+
+size_t DefinesVarGraph::numDefiningConstraints() const {
+  return _numDefiningConstraints;
+}
+
+std::span<const uint32_t> DefinesVarGraph::successors(
+    const uint32_t constraint) const {
+  if (constraint >= _numConstraints) {
+    throw FznException("Invalid constraint index: " +
+                       std::to_string(constraint));
+  }
+  return {_successors.data() + _offsets[constraint],
+          _successors.data() + _offsets[constraint + 1]};
+}
+
+std::span<const uint32_t> DefinesVarGraph::topologicalOrder() const {
+  return _topologicalOrder;
+}
+
+bool DefinesVarGraph::hasCycle() const { return !_cyclicConstraints.empty(); }
+
+std::span<const uint32_t> DefinesVarGraph::cyclicConstraints() const {
+  return _cyclicConstraints;
+}
+
+}  // namespace fznparser
@@ -1,5 +1,6 @@
 #include "fznparser/model.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <ranges>
@@ -81,12 +82,18 @@ Var Model::addVar(Var&& var) {
     throw FznException("Variable with identifier \"" + var.identifier() +
                        "\" already exists");
   }
+  _occurrenceIndex.reset();
+  _definesVarGraph.reset();
+  _varPools.reset();
   auto addedVar = _vars.emplace(var.identifier(), std::move(var)).first->second;
   addedVar.interpretAnnotations(_vars);
   return addedVar;
 }
 
 const Constraint& Model::addConstraint(Constraint&& constraint) {
+  _occurrenceIndex.reset();
+  _definesVarGraph.reset();
+  _varPools.reset();
   Constraint& con = _constraints.emplace_back(std::move(constraint));
   con.interpretAnnotations(_vars);
   return con;
@@ -129,6 +136,57 @@ bool Model::isMinimisationProblem() const {
   return _solveType.isMinimisationProblem();
 }
 
+void Model::buildOccurrenceIndex() {
+  _occurrenceIndex =
+      std::make_shared<const OccurrenceIndex>(_vars, _constraints);
+}
+
+bool Model::hasOccurrenceIndex() const noexcept {
+  return _occurrenceIndex != nullptr;
+}
+
+const OccurrenceIndex& Model::occurrenceIndex() const {
+  if (_occurrenceIndex == nullptr) {
+    throw FznException("The occurrence index has not been built");
+  }
+  return *_occurrenceIndex;
+}
+
+void Model::buildDefinesVarGraph() {
+  if (_occurrenceIndex != nullptr) {
+    _definesVarGraph = std::make_shared<const DefinesVarGraph>(
+        _constraints, *_occurrenceIndex);
+    return;
+  }
+  const OccurrenceIndex occurrenceIndex(_vars, _constraints);
+  _definesVarGraph =
+      std::make_shared<const DefinesVarGraph>(_constraints, occurrenceIndex);
+}
+
+bool Model::hasDefinesVarGraph() const noexcept {
+  return _definesVarGraph != nullptr;
+}
+
+const DefinesVarGraph& Model::definesVarGraph() const {
+  if (_definesVarGraph == nullptr) {
+    throw FznException("The defines_var graph has not been built");
+  }
+  return *_definesVarGraph;
+}
+
+void Model::buildVarPools() {
+  _varPools = std::make_shared<const VarPools>(_vars, _constraints);
+}
+
+bool Model::hasVarPools() const noexcept { return _varPools != nullptr; }
+
+const VarPools& Model::varPools() const {
+  if (_varPools == nullptr) {
+    throw FznException("The variable pools have not been built");
+  }
+  return *_varPools;
+}
+
 bool Model::operator==(const Model& other) const {
   if (_vars.size() != other._vars.size() ||
       _constraints.size() != other._constraints.size() ||
@@ -141,24 +199,63 @@ bool Model::operator==(const Model& other) const {
       return false;
     }
   }
-  for (const Constraint& con : _constraints) {
-    bool found = false;
-    for (const Constraint& otherCon : other._constraints) {
-      if (con.operator==(otherCon)) {
-        found = true;
-        break;
-      }
-    }
-    if (!found) {
+  // the constraints are compared as multisets; models that are parsed from
+  // the same source have them in the same order
+  size_t first = 0;
+  while (first < _constraints.size() &&
+         _constraints[first].operator==(other._constraints[first])) {
+    ++first;
+  }
+  if (first == _constraints.size()) {
+    return true;
+  }
+  // the unmatched constraints of the other model, by hash
+  std::unordered_multimap<size_t, size_t> unmatched;
+  unmatched.reserve(_constraints.size() - first);
+  for (size_t i = first; i < other._constraints.size(); ++i) {
+    unmatched.emplace(other._constraints[i].hash(), i);
+  }
+  for (size_t i = first; i < _constraints.size(); ++i) {
+    const auto [begin, end] = unmatched.equal_range(_constraints[i].hash());
+    const auto match = std::find_if(begin, end, [&](const auto& entry) {
+      return _constraints[i].operator==(other._constraints[entry.second]);
+    });
+    if (match == end) {
       return false;
     }
-  }
-  if (!_solveType.operator==(other._solveType)) {
-    return false;
+    unmatched.erase(match);
   }
   return true;
 }
 
+size_t Model::removeDuplicateConstraints() {
+  std::vector<Constraint> unique;
+  unique.reserve(_constraints.size());
+  // the indices in unique, by hash
+  std::unordered_multimap<size_t, size_t> indices;
+  indices.reserve(_constraints.size());
+  for (Constraint& constraint : _constraints) {
+    const size_t hash = constraint.hash();
+    const auto [begin, end] = indices.equal_range(hash);
+    if (std::any_of(begin, end, [&](const auto& entry) {
+          return unique[entry.second].operator==(constraint);
+        })) {
+      continue;
+    }
+    indices.emplace(hash, unique.size());
+    unique.push_back(std::move(constraint));
+  }
+  const size_t numRemoved = _constraints.size() - unique.size();
+  // constraints cannot be move assigned
+  _constraints.swap(unique);
+  if (numRemoved > 0) {
+    _occurrenceIndex.reset();
+    _definesVarGraph.reset();
+    _varPools.reset();
+  }
+  return numRemoved;
+}
+
 bool Model::operator!=(const Model& other) const { return !operator==(other); }
 
 std::string Model::toString() const {
@@ -0,0 +1,176 @@
+#include "fznparser/occurrenceIndex.hpp"
+
+#include <limits>
+#include <ranges>
+
+#include "fznparser/except.hpp"
+
+namespace fznparser {
+
+/**
+ * @return the basic variable, or nullptr if the variable is an array or a
+ * reference
+ */
+const VarBase* basicVar(const Var& var) {
+  if (std::holds_alternative<std::shared_ptr<BoolVar>>(var)) {
+    return std::get<std::shared_ptr<BoolVar>>(var).get();
+  }
+  if (std::holds_alternative<std::shared_ptr<IntVar>>(var)) {
+    return std::get<std::shared_ptr<IntVar>>(var).get();
+  }
+  if (std::holds_alternative<std::shared_ptr<FloatVar>>(var)) {
+    return std::get<std::shared_ptr<FloatVar>>(var).get();
+  }
+  if (std::holds_alternative<std::shared_ptr<SetVar>>(var)) {
+    return std::get<std::shared_ptr<SetVar>>(var).get();
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Collects the occurrences of the variables of a single argument, in
+ * the order they are found, together with the ids of the variables.
+ */
+class OccurrenceCollector {
+  const std::unordered_map<const VarBase*, uint32_t>& _ids;
+  std::vector<uint32_t>& _varIds;
+  std::vector<Occurrence>& _occurrences;
+
+  void add(const VarBase* var, const Occurrence& occurrence) {
+    const auto it = _ids.find(var);
+    // a variable that was not added to the model, e.g. by toVar
+    if (it != _ids.end()) {
+      _varIds.push_back(it->second);
+      _occurrences.push_back(occurrence);
+    }
+  }
+
+  template <class ScalarArg>
+  void scalar(const ScalarArg& arg, const Occurrence& occurrence) {
+    if (!arg.isParameter()) {
+      add(arg.var().get(), occurrence);
+    }
+  }
+
+  template <typename ParType, class VarType>
+  void array(const VarArrayTemplate<ParType, VarType>& array,
+             Occurrence occurrence) {
+    uint32_t i = 0;
+    for (const auto element : array) {
+      if (!element.isParameter()) {
+        occurrence.element = i;
+        add(element.var().get(), occurrence);
+      }
+      ++i;
+    }
+  }
+
+ public:
+  OccurrenceCollector(const std::unordered_map<const VarBase*, uint32_t>& ids,
+                      std::vector<uint32_t>& varIds,
+                      std::vector<Occurrence>& occurrences)
+      : _ids(ids), _varIds(varIds), _occurrences(occurrences) {}
+
+  void collect(const Arg& arg, const Occurrence& occurrence) {
+    if (std::holds_alternative<BoolArg>(arg)) {
+      scalar(std::get<BoolArg>(arg), occurrence);
+    } else if (std::holds_alternative<IntArg>(arg)) {
+      scalar(std::get<IntArg>(arg), occurrence);
+    } else if (std::holds_alternative<FloatArg>(arg)) {
+      scalar(std::get<FloatArg>(arg), occurrence);
+    } else if (std::holds_alternative<IntSetArg>(arg)) {
+      scalar(std::get<IntSetArg>(arg), occurrence);
+    } else if (std::holds_alternative<std::shared_ptr<BoolVarArray>>(arg)) {
+      array(*std::get<std::shared_ptr<BoolVarArray>>(arg), occurrence);
+    } else if (std::holds_alternative<std::shared_ptr<IntVarArray>>(arg)) {
+      array(*std::get<std::shared_ptr<IntVarArray>>(arg), occurrence);
+    } else if (std::holds_alternative<std::shared_ptr<FloatVarArray>>(arg)) {
+      array(*std::get<std::shared_ptr<FloatVarArray>>(arg), occurrence);
+    } else if (std::holds_alternative<std::shared_ptr<SetVarArray>>(arg)) {
+      array(*std::get<std::shared_ptr<SetVarArray>>(arg), occurrence);
+    }
+    // float sets and arrays of float sets are always parameters
+  }
+};
+
+OccurrenceIndex::OccurrenceIndex(
+    const std::unordered_map<std::string, Var>& vars,
+    const std::vector<Constraint>& constraints) {
+  if (constraints.size() > std::numeric_limits<uint32_t>::max()) {
+    throw FznException("Too many constraints for an occurrence index");
+  }
+  _ids.reserve(vars.size());
+  _vars.reserve(vars.size());
+  for (const Var& var : vars | std::views::values) {
+    const VarBase* base = basicVar(var);
+    if (base != nullptr) {
+      _ids.emplace(base, static_cast<uint32_t>(_vars.size()));
+      _vars.push_back(var);
+    }
+  }
+
+  // the occurrences are collected in constraint order and then sorted by
+  // variable with a counting sort, which keeps them in constraint order
+  std::vector<uint32_t> varIds;
+  std::vector<Occurrence> occurrences;
+  OccurrenceCollector collector(_ids, varIds, occurrences);
+  for (size_t c = 0; c < constraints.size(); ++c) {
+    const std::vector<Arg>& arguments = constraints[c].arguments();
+    for (size_t a = 0; a < arguments.size(); ++a) {
+      collector.collect(arguments[a], Occurrence{static_cast<uint32_t>(c),
+                                                 static_cast<uint32_t>(a), 0});
+    }
+  }
+
+  _offsets.assign(_vars.size() + 1, 0);
+  for (const uint32_t varId : varIds) {
+    ++_offsets[varId + 1];
+  }
+  for (size_t i = 1; i < _offsets.size(); ++i) {
+    _offsets[i] += _offsets[i - 1];
+  }
+  std::vector<size_t> next(_offsets.begin(), _offsets.end() - 1);
+  _occurrences.resize(occurrences.size());
+  for (size_t i = 0; i < occurrences.size(); ++i) {
+    _occurrences[next[varIds[i]]++] = occurrences[i];
+  }
+}
+
+size_t OccurrenceIndex::numVars() const { return _vars.size(); }
+
+size_t OccurrenceIndex::numOccurrences() const { return _occurrences.size(); }
+
+const Var& OccurrenceIndex::var(const uint32_t id) const {
+  return _vars.at(id);
+}
+
+std::optional<uint32_t> OccurrenceIndex::id(const VarBase& var) const {
+  const auto it = _ids.find(&var);
+  if (it == _ids.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::optional<uint32_t> OccurrenceIndex::id(const Var& var) const {
+  const Var* source = &var;
+  while (std::holds_alternative<std::shared_ptr<VarReference>>(*source)) {
+    source = &std::get<std::shared_ptr<VarReference>>(*source)->source();
+  }
+  const VarBase* base = basicVar(*source);
+  if (base == nullptr) {
+    return std::nullopt;
+  }
+  return id(*base);
+}
+
+std::span<const Occurrence> OccurrenceIndex::occurrences(
+    const uint32_t id) const {
+  if (id >= _vars.size()) {
+    throw FznException("Invalid variable id: " + std::to_string(id));
+  }
+  return {_occurrences.data() + _offsets[id],
+          _occurrences.data() + _offsets[id + 1]};
+}
+
+}  // namespace fznparser
@@ -0,0 +1,245 @@
+#include "fznparser/parseCache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "fznparser/except.hpp"
+#include "fznparser/snapshot.hpp"
+
+namespace fznparser {
+
+namespace fs = std::filesystem;
+
+constexpr std::string_view cacheEntryExtension = ".fznsnap";
+
+constexpr uint64_t hashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t hashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+uint64_t finalizeHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+std::string contentHash(const std::string_view content) {
+  // two lanes that each consume a word at a time; the second also depends on
+  // the first, so that swapping words changes both
+  uint64_t low = hashPrime1;
+  uint64_t high = hashPrime2;
+  const auto consume = [&](const uint64_t word) {
+    low = std::rotl(low ^ (word * hashPrime2), 31) * hashPrime1;
+    high = std::rotl(high + word * hashPrime1, 27) * hashPrime2 + low;
+  };
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= content.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, content.data() + i, sizeof(uint64_t));
+    consume(word);
+  }
+  uint64_t tail = 0;
+  if (i < content.size()) {
+    std::memcpy(&tail, content.data() + i, content.size() - i);
+  }
+  consume(tail);
+  low = finalizeHash(low ^ content.size());
+  high = finalizeHash(high ^ low);
+
+  constexpr std::string_view digits = "0123456789abcdef";
+  std::string res(32, '0');
+  for (size_t d = 0; d < 16; ++d) {
+    res[d] = digits[(high >> (60 - 4 * d)) & 0xF];
+    res[16 + d] = digits[(low >> (60 - 4 * d)) & 0xF];
+  }
+  return res;
+}
+
+// a 64 bit FNV-1a hash of the content, a word at a time, which is
+// independent of contentHash and checks that an entry found by contentHash
+// was parsed from the content
+uint64_t contentCheck(const std::string_view content) {
+  constexpr uint64_t fnvPrime = 0x100000001B3ULL;
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= content.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, content.data() + i, sizeof(uint64_t));
+    hash = (hash ^ word) * fnvPrime;
+  }
+  for (; i < content.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned char>(content[i])) * fnvPrime;
+  }
+  return finalizeHash(hash);
+}
+
+// an entry is the size and the contentCheck of the content, followed by the
+// snapshot of the model parsed from it
+constexpr size_t cacheEntryHeaderSize = 2 * sizeof(uint64_t);
+
+std::string cacheEntryHeader(const std::string_view content) {
+  const uint64_t words[2] = {content.size(), contentCheck(content)};
+  std::string header(cacheEntryHeaderSize, '\0');
+  std::memcpy(header.data(), words, cacheEntryHeaderSize);
+  return header;
+}
+
+std::string readCacheEntry(const fs::path& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw FznException("Could not open file: " + path.string());
+  }
+  std::string entry(static_cast<size_t>(in.tellg()), '\0');
+  in.seekg(0);
+  if (!in.read(entry.data(), static_cast<std::streamsize>(entry.size()))) {
+    throw FznException("Could not read file: " + path.string());
+  }
+  return entry;
+}
+
+ParseCache::ParseCache(fs::path directory, const uintmax_t maxBytes)
+    : _directory(std::move(directory)), _maxBytes(maxBytes) {
+  std::error_code ec;
+  fs::create_directories(_directory, ec);
+  if (ec || !fs::is_directory(_directory, ec)) {
+    throw FznException("Could not create cache directory: " +
+                       _directory.string());
+  }
+}
+
+const fs::path& ParseCache::directory() const { return _directory; }
+
+uintmax_t ParseCache::maxBytes() const { return _maxBytes; }
+
+fs::path ParseCache::entryPath(const std::string_view fznContent) const {
+  return _directory /
+         (contentHash(fznContent) + std::string(cacheEntryExtension));
+}
+
+std::optional<Model> ParseCache::load(
+    const std::string_view fznContent) const {
+  const fs::path path = entryPath(fznContent);
+  std::error_code ec;
+  if (!fs::exists(path, ec)) {
+    return std::nullopt;
+  }
+  try {
+    const std::string entry = readCacheEntry(path);
+    const std::string_view header =
+        std::string_view(entry).substr(0, cacheEntryHeaderSize);
+    if (header != cacheEntryHeader(fznContent)) {
+      // parsed from other content with the same contentHash
+      fs::remove(path, ec);
+      return std::nullopt;
+    }
+    std::optional<Model> model(readSnapshotString(
+        std::string_view(entry).substr(cacheEntryHeaderSize)));
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    return model;
+  } catch (const std::exception&) {
+    // truncated, or written by another version. Besides FznException, a
+    // corrupted snapshot can make the reader fail to allocate.
+    fs::remove(path, ec);
+    return std::nullopt;
+  }
+}
+
+bool ParseCache::store(const std::string_view fznContent,
+                       const Model& model) const {
+  const fs::path path = entryPath(fznContent);
+  std::error_code ec;
+  if (fs::exists(path, ec)) {
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    return !ec;
+  }
+  // the snapshot is written next to the entry and then renamed, so that no
+  // other process can read it before it is complete
+  std::random_device random;
+  const fs::path tmpPath =
+      path.string() + "." + std::to_string(random()) + ".tmp";
+  try {
+    std::ofstream out(tmpPath, std::ios::binary);
+    out << cacheEntryHeader(fznContent);
+    writeSnapshot(model, out);
+    out.close();
+    if (!out) {
+      throw FznException("Could not write file: " + tmpPath.string());
+    }
+  } catch (const std::exception&) {
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+  fs::rename(tmpPath, path, ec);
+  if (ec) {
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+  evict(_maxBytes);
+  return true;
+}
+
+struct CacheEntry {
+  fs::path path;
+  uintmax_t size;
+  fs::file_time_type lastUsed;
+};
+
+std::vector<CacheEntry> cacheEntries(const fs::path& directory) {
+  std::vector<CacheEntry> entries;
+  std::error_code ec;
+  for (fs::directory_iterator it(directory, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    if (it->path().extension().string() != cacheEntryExtension) {
+      continue;
+    }
+    // another process may remove the entry while the directory is iterated
+    std::error_code entryEc;
+    const uintmax_t size = it->file_size(entryEc);
+    const fs::file_time_type lastUsed = it->last_write_time(entryEc);
+    if (!entryEc) {
+      entries.push_back(CacheEntry{it->path(), size, lastUsed});
+    }
+  }
+  return entries;
+}
+
+uintmax_t ParseCache::sizeInBytes() const {
+  uintmax_t size = 0;
+  for (const CacheEntry& entry : cacheEntries(_directory)) {
+    size += entry.size;
+  }
+  return size;
+}
+
+void ParseCache::evict(const uintmax_t maxBytes) const {
+  std::vector<CacheEntry> entries = cacheEntries(_directory);
+  uintmax_t size = 0;
+  for (const CacheEntry& entry : entries) {
+    size += entry.size;
+  }
+  if (size <= maxBytes) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const CacheEntry& a, const CacheEntry& b) {
+              return a.lastUsed < b.lastUsed;
+            });
+  std::error_code ec;
+  for (const CacheEntry& entry : entries) {
+    if (size <= maxBytes) {
+      break;
+    }
+    fs::remove(entry.path, ec);
+    size -= entry.size;
+  }
+}
+
+}  // namespace fznparser
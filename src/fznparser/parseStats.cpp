@@ -0,0 +1,112 @@
+#include "fznparser/parseStats.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include "fznparser/except.hpp"
+#include "fznparser/phaseTimer.hpp"
+
+namespace fznparser {
+
+std::string toString(const ParsePhase phase) {
+  switch (phase) {
+    case ParsePhase::READ:
+      return "read";
+    case ParsePhase::GRAMMAR:
+      return "grammar";
+    case ParsePhase::REPLACE:
+      return "replace";
+    case ParsePhase::VALIDATE:
+      return "validate";
+    case ParsePhase::VARIABLES:
+      return "variables";
+    case ParsePhase::CONSTRAINTS:
+      return "constraints";
+  }
+  throw FznException("Invalid parse phase");
+}
+
+PhaseStats& ParseStats::phase(const ParsePhase phase) {
+  return _phases.at(static_cast<size_t>(phase));
+}
+
+const PhaseStats& ParseStats::phase(const ParsePhase phase) const {
+  return _phases.at(static_cast<size_t>(phase));
+}
+
+std::chrono::nanoseconds ParseStats::totalWallTime() const {
+  std::chrono::nanoseconds total{0};
+  for (const PhaseStats& phase : _phases) {
+    total += phase.wallTime;
+  }
+  return total;
+}
+
+size_t ParseStats::peakResidentBytes() const {
+  size_t peak = 0;
+  for (const PhaseStats& phase : _phases) {
+    peak = std::max(peak, phase.peakResidentBytes);
+  }
+  return peak;
+}
+
+std::string ParseStats::toString() const {
+  std::stringstream ss;
+  for (size_t i = 0; i < numParsePhases; ++i) {
+    const PhaseStats& phase = _phases[i];
+    ss << fznparser::toString(static_cast<ParsePhase>(i)) << ": "
+       << std::chrono::duration<double, std::milli>(phase.wallTime).count()
+       << " ms, " << phase.numItems << " items, " << phase.bytes
+       << " bytes, peak RSS " << phase.peakResidentBytes << " bytes\n";
+  }
+  return ss.str();
+}
+
+bool resetPeakResidentBytes() {
+#if defined(__linux__)
+  // see clear_refs in proc(5)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  return static_cast<bool>(clearRefs << "5" << std::flush);
+#else
+  return false;
+#endif
+}
+
+size_t peakResidentBytes() {
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key) {
+    if (key == "VmHWM:") {
+      size_t kilobytes = 0;
+      status >> kilobytes;
+      return kilobytes * 1024;
+    }
+    status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+#endif
+  return 0;
+}
+
+PhaseTimer::PhaseTimer(ParseStats* stats, const ParsePhase phase)
+    : _phase(stats == nullptr ? nullptr : &stats->phase(phase)) {
+  if (_phase != nullptr) {
+    _measuresPeak = resetPeakResidentBytes();
+    _start = std::chrono::steady_clock::now();
+  }
+}
+
+PhaseTimer::~PhaseTimer() {
+  if (_phase != nullptr) {
+    _phase->wallTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _start);
+    if (_measuresPeak) {
+      _phase->peakResidentBytes =
+          std::max(_phase->peakResidentBytes, peakResidentBytes());
+    }
+  }
+}
+
+}  // namespace fznparser
@@ -1,53 +1,413 @@
 #include "fznparser/parser.hpp"
 
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/spirit/home/x3.hpp>
 #include <boost/spirit/include/support_istream_iterator.hpp>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <exception>
+#include <filesystem>
 #include <fstream>
 #include <istream>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "fznparser/except.hpp"
+#include "fznparser/parser/arena.hpp"
+#include "fznparser/parser/chunks.hpp"
+#include "fznparser/parser/descentParser.hpp"
 #include "fznparser/parser/grammarDef.hpp"
+#include "fznparser/phaseTimer.hpp"
 #include "fznparser/transformer/modelTransformer.hpp"
 
 namespace fznparser {
 namespace x3 = ::boost::spirit::x3;
+namespace bip = ::boost::interprocess;
 
-Model parseFznIstream(std::istream& fznStream) {
-  boost::spirit::istream_iterator fileIterator(fznStream >> std::noskipws), eof;
+Model transformModel(parser::Model&& parserModel, const ParseOptions& options,
+                     const size_t numThreads) {
+  ParseStats* stats = options.stats;
+  if (stats != nullptr) {
+    stats->phase(ParsePhase::GRAMMAR).numItems =
+        parserModel.predicateItems.size() + parserModel.parDeclItems.size() +
+        parserModel.varDeclItems.size() + parserModel.constraintItems.size() +
+        1;
+  }
+  ModelTransformer modelTransformer(std::move(parserModel), stats);
+  return modelTransformer.generateModel(numThreads,
+                                       options.buildOccurrenceIndex);
+}
 
+template <typename Iterator>
+Model parseFzn(Iterator first, const Iterator last,
+               const ParseOptions& options = {}, const size_t numThreads = 1) {
   parser::Model parserModel;
 
-  x3::phrase_parse(fileIterator, eof, parser::model, parser::skipper,
-                   parserModel);
+  {
+    const PhaseTimer timer(options.stats, ParsePhase::GRAMMAR);
+    x3::phrase_parse(first, last, parser::model, parser::skipper,
+                     parserModel);
+  }
+
+  if (first != last) {
+    throw FznException("Could not parse FlatZinc");
+  }
+
+  return transformModel(std::move(parserModel), options, numThreads);
+}
+
+/**
+ * @brief Reads the items of a model one at a time with the X3 item rules.
+ */
+template <typename Iterator>
+class X3ItemReader {
+  Iterator _first;
+  const Iterator _last;
+
+  template <typename Item, typename Rule>
+  std::optional<Item> parseItem(const Rule& rule) {
+    Item item;
+    if (!x3::phrase_parse(_first, _last, rule, parser::skipper, item)) {
+      return std::nullopt;
+    }
+    return item;
+  }
+
+ public:
+  X3ItemReader(Iterator first, const Iterator last)
+      : _first(first), _last(last) {}
+
+  std::optional<parser::PredicateItem> predicateItem() {
+    return parseItem<parser::PredicateItem>(parser::predicate_item);
+  }
+  std::optional<parser::ParDeclItem> parDeclItem() {
+    return parseItem<parser::ParDeclItem>(parser::par_decl_item);
+  }
+  std::optional<parser::VarDeclItem> varDeclItem() {
+    return parseItem<parser::VarDeclItem>(parser::var_decl_item);
+  }
+  std::optional<parser::ConstraintItem> constraintItem() {
+    return parseItem<parser::ConstraintItem>(parser::constraint_item);
+  }
+  std::optional<parser::SolveItem> solveItem() {
+    return parseItem<parser::SolveItem>(parser::solve_item);
+  }
+  // trailing whitespace and comments are skipped
+  [[nodiscard]] bool atEnd() {
+    x3::phrase_parse(_first, _last, x3::eps, parser::skipper);
+    return _first == _last;
+  }
+};
+
+/**
+ * @brief Passes the items of the reader (an X3ItemReader or a
+ * parser::DescentParser) to the handler as they are read and transformed.
+ */
+template <typename ItemReader>
+void parseItems(ItemReader& itemReader, ItemHandler& handler) {
+  ModelTransformer modelTransformer;
+
+  // predicate declarations are not used by the transformer
+  while (itemReader.predicateItem()) {
+  }
+  while (auto parDeclItem = itemReader.parDeclItem()) {
+    modelTransformer.addParDeclItem(std::move(*parDeclItem));
+  }
+  while (auto varDeclItem = itemReader.varDeclItem()) {
+    const Var& var = modelTransformer.addVarDeclItem(std::move(*varDeclItem));
+    if (var.isArray()) {
+      handler.onArray(var);
+    } else {
+      handler.onVar(var);
+    }
+  }
+  while (auto constraintItem = itemReader.constraintItem()) {
+    handler.onConstraint(
+        modelTransformer.transformConstraintItem(std::move(*constraintItem)));
+  }
+  const auto solveItem = itemReader.solveItem();
 
-  if (fileIterator != eof) {
+  if (!solveItem.has_value() || !itemReader.atEnd()) {
     throw FznException("Could not parse FlatZinc");
   }
+  handler.onSolve(modelTransformer.transformSolveItem(*solveItem));
+}
+
+// a chunk smaller than this is not worth a thread of its own
+constexpr size_t minChunkSize = size_t{1} << 16;
 
-  ModelTransformer modelTransformer(std::move(parserModel));
+struct ModelChunk {
+  parser::Model items;
+  bool hasSolveItem{false};
+};
 
-  return modelTransformer.generateModel();
+template <typename ItemReader>
+ModelChunk parseChunk(ItemReader itemReader) {
+  ModelChunk chunk;
+  parser::Model& items = chunk.items;
+  while (auto item = itemReader.predicateItem()) {
+    items.predicateItems.push_back(std::move(*item));
+  }
+  while (auto item = itemReader.parDeclItem()) {
+    items.parDeclItems.push_back(std::move(*item));
+  }
+  while (auto item = itemReader.varDeclItem()) {
+    items.varDeclItems.push_back(std::move(*item));
+  }
+  while (auto item = itemReader.constraintItem()) {
+    items.constraintItems.push_back(std::move(*item));
+  }
+  if (auto item = itemReader.solveItem()) {
+    items.solveItem = std::move(*item);
+    chunk.hasSolveItem = true;
+  }
+  if (!itemReader.atEnd()) {
+    throw FznException("Could not parse FlatZinc");
+  }
+  return chunk;
 }
 
-Model parseFznFile(const std::string& fznFilePath) {
-  std::ifstream fznFile(fznFilePath);
+// the elements keep the arenas they were allocated from
+template <typename T>
+void appendMoved(parser::ArenaVector<T>& target,
+                 parser::ArenaVector<T>& source) {
+  target.insert(target.end(), std::make_move_iterator(source.begin()),
+                std::make_move_iterator(source.end()));
+}
 
-  if (!fznFile) {
+/**
+ * @brief Concatenates the chunks in order. Across all chunks, the items must
+ * be predicates, parameters, variables, constraints and a single solve item,
+ * in that order.
+ */
+std::optional<parser::Model> mergeChunks(std::vector<ModelChunk>& chunks) {
+  parser::Model model;
+  size_t numVarDeclItems = 0;
+  size_t numConstraintItems = 0;
+  for (const ModelChunk& chunk : chunks) {
+    numVarDeclItems += chunk.items.varDeclItems.size();
+    numConstraintItems += chunk.items.constraintItems.size();
+  }
+  model.varDeclItems.reserve(numVarDeclItems);
+  model.constraintItems.reserve(numConstraintItems);
+
+  size_t phase = 0;
+  bool hasSolveItem = false;
+  for (ModelChunk& chunk : chunks) {
+    const std::array<bool, 5> hasItems{
+        !chunk.items.predicateItems.empty(), !chunk.items.parDeclItems.empty(),
+        !chunk.items.varDeclItems.empty(), !chunk.items.constraintItems.empty(),
+        chunk.hasSolveItem};
+    for (size_t itemPhase = 0; itemPhase < hasItems.size(); ++itemPhase) {
+      if (!hasItems[itemPhase]) {
+        continue;
+      }
+      if (itemPhase < phase || hasSolveItem) {
+        return std::nullopt;
+      }
+      phase = itemPhase;
+    }
+    appendMoved(model.predicateItems, chunk.items.predicateItems);
+    appendMoved(model.parDeclItems, chunk.items.parDeclItems);
+    appendMoved(model.varDeclItems, chunk.items.varDeclItems);
+    appendMoved(model.constraintItems, chunk.items.constraintItems);
+    if (chunk.hasSolveItem) {
+      model.solveItem = std::move(chunk.items.solveItem);
+      hasSolveItem = true;
+    }
+  }
+  if (!hasSolveItem) {
+    return std::nullopt;
+  }
+  return model;
+}
+
+/**
+ * @brief Splits the content at item boundaries and parses the chunks on
+ * separate threads. The first chunk is parsed on the calling thread in its
+ * current arena, the others each in an arena appended to arenas.
+ *
+ * @return the model, or std::nullopt if the content is too small to be
+ * split or cannot be parsed, in which case it should be parsed sequentially
+ * (which also reports any error in the context of the whole content)
+ */
+std::optional<parser::Model> parseInParallel(
+    const std::string_view fznContent, const ParseOptions& options,
+    const size_t numThreads, std::deque<parser::Arena>& arenas) {
+  const std::vector<std::string_view> chunks =
+      parser::splitIntoChunks(fznContent, numThreads, minChunkSize);
+  if (chunks.size() <= 1) {
+    return std::nullopt;
+  }
+  std::vector<parser::Arena*> chunkArenas{nullptr};
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    chunkArenas.push_back(&arenas.emplace_back(chunks[i].size()));
+  }
+
+  std::vector<ModelChunk> parsedChunks(chunks.size());
+  std::vector<char> failed(chunks.size(), false);
+  std::vector<std::exception_ptr> errors(chunks.size());
+  const auto parseChunkAt = [&](const size_t i) {
+    std::optional<parser::Arena::Scope> scope;
+    if (chunkArenas[i] != nullptr) {
+      scope.emplace(*chunkArenas[i]);
+    }
+    try {
+      if (options.useTokenizer) {
+        parsedChunks[i] = parseChunk(parser::DescentParser(chunks[i]));
+      } else {
+        parsedChunks[i] = parseChunk(X3ItemReader(
+            chunks[i].data(), chunks[i].data() + chunks[i].size()));
+      }
+    } catch (const FznException&) {
+      failed[i] = true;
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(chunks.size() - 1);
+    for (size_t i = 1; i < chunks.size(); ++i) {
+      workers.emplace_back(parseChunkAt, i);
+    }
+    parseChunkAt(0);
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  if (std::find(failed.begin(), failed.end(), true) != failed.end()) {
+    return std::nullopt;
+  }
+  return mergeChunks(parsedChunks);
+}
+
+/**
+ * @brief Maps the file into memory so that it can be parsed in place,
+ * avoiding both the per-character overhead of stream iterators and an
+ * intermediate copy.
+ *
+ * @return the mapped region, which is empty if the file is empty
+ */
+bip::mapped_region mapFznFile(const std::string& fznFilePath) {
+  std::error_code ec;
+  const auto fileSize = std::filesystem::file_size(fznFilePath, ec);
+  if (ec) {
     throw FznException("Could not open file: " + fznFilePath);
   }
+  if (fileSize == 0) {
+    // an empty file cannot be mapped, but neither is it valid FlatZinc
+    return bip::mapped_region();
+  }
 
-  return parseFznIstream(fznFile);
+  bip::mapped_region region;
+  try {
+    const bip::file_mapping mapping(fznFilePath.c_str(), bip::read_only);
+    region = bip::mapped_region(mapping, bip::read_only);
+  } catch (const bip::interprocess_exception&) {
+    throw FznException("Could not open file: " + fznFilePath);
+  }
+  region.advise(bip::mapped_region::advice_sequential);
+  return region;
 }
 
-Model parseFznString(const std::string& fznContent) {
-  std::stringstream ss(fznContent);
-  return parseFznIstream(ss);
+std::string_view content(const bip::mapped_region& region) {
+  return std::string_view(static_cast<const char*>(region.get_address()),
+                          region.get_size());
 }
-Model parseFznString(std::string&& fznContent) {
-  std::stringstream ss(fznContent);
-  return parseFznIstream(ss);
+
+Model parseFznIstream(std::istream& fznStream) {
+  parser::Arena arena;
+  const parser::Arena::Scope scope(arena);
+  boost::spirit::istream_iterator fileIterator(fznStream >> std::noskipws), eof;
+  return parseFzn(fileIterator, eof);
+}
+
+Model parseFznFile(const std::string& fznFilePath,
+                   const ParseOptions& options) {
+  bip::mapped_region region;
+  {
+    const PhaseTimer timer(options.stats, ParsePhase::READ);
+    region = mapFznFile(fznFilePath);
+  }
+  if (options.stats != nullptr) {
+    options.stats->phase(ParsePhase::READ).bytes = region.get_size();
+  }
+  return parseFznString(content(region), options);
+}
+
+void parseFznFile(const std::string& fznFilePath, ItemHandler& handler,
+                  const ParseOptions& options) {
+  const bip::mapped_region region = mapFznFile(fznFilePath);
+  parseFznString(content(region), handler, options);
+}
+
+Model parseFznContent(const std::string_view fznContent,
+                      const ParseOptions& options) {
+  const size_t numThreads =
+      options.numThreads == 0
+          ? std::max(std::thread::hardware_concurrency(), 1u)
+          : options.numThreads;
+  // the AST is only needed until the model has been generated, so it is
+  // allocated from arenas that are released all at once
+  std::deque<parser::Arena> arenas;
+  const parser::Arena::Scope scope(
+      arenas.emplace_back(fznContent.size() / numThreads));
+  if (options.stats != nullptr) {
+    options.stats->phase(ParsePhase::GRAMMAR).bytes = fznContent.size();
+  }
+  std::optional<parser::Model> parserModel;
+  {
+    const PhaseTimer timer(options.stats, ParsePhase::GRAMMAR);
+    if (numThreads > 1) {
+      parserModel = parseInParallel(fznContent, options, numThreads, arenas);
+    }
+    if (!parserModel.has_value() && options.useTokenizer) {
+      parserModel = parser::DescentParser(fznContent).model();
+    }
+  }
+  if (parserModel.has_value()) {
+    return transformModel(std::move(*parserModel), options, numThreads);
+  }
+  return parseFzn(fznContent.data(), fznContent.data() + fznContent.size(),
+                  options, numThreads);
+}
+
+Model parseFznString(const std::string_view fznContent,
+                     const ParseOptions& options) {
+  if (options.cache == nullptr) {
+    return parseFznContent(fznContent, options);
+  }
+  std::optional<Model> model = options.cache->load(fznContent);
+  if (!model.has_value()) {
+    model.emplace(parseFznContent(fznContent, options));
+    options.cache->store(fznContent, *model);
+  } else if (options.buildOccurrenceIndex) {
+    // the index is not part of the snapshot
+    model->buildOccurrenceIndex();
+  }
+  return std::move(*model);
+}
+
+void parseFznString(const std::string_view fznContent, ItemHandler& handler,
+                    const ParseOptions& options) {
+  if (options.useTokenizer) {
+    parser::DescentParser descentParser(fznContent);
+    parseItems(descentParser, handler);
+    return;
+  }
+  X3ItemReader itemReader(fznContent.data(),
+                          fznContent.data() + fznContent.size());
+  parseItems(itemReader, handler);
 }
 
 }  // namespace fznparser
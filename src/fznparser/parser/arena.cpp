@@ -0,0 +1,26 @@
+#include "fznparser/parser/arena.hpp"
+
+#include <algorithm>
+
+namespace fznparser::parser {
+
+thread_local std::pmr::memory_resource* threadArena = nullptr;
+
+// the first block is never smaller than this, even for tiny inputs
+constexpr size_t minInitialSize = size_t{1} << 12;
+
+Arena::Arena(const size_t initialSize)
+    : _resource(std::max(initialSize, minInitialSize)) {}
+
+Arena::Scope::Scope(Arena& arena) noexcept : _previous(threadArena) {
+  threadArena = arena.resource();
+}
+
+Arena::Scope::~Scope() { threadArena = _previous; }
+
+std::pmr::memory_resource* currentArena() noexcept {
+  return threadArena != nullptr ? threadArena
+                                : std::pmr::new_delete_resource();
+}
+
+}  // namespace fznparser::parser
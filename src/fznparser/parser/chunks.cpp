@@ -0,0 +1,48 @@
+#include "fznparser/parser/chunks.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace fznparser::parser {
+
+std::vector<std::string_view> splitIntoChunks(const std::string_view content,
+                                              const size_t maxChunks,
+                                              const size_t minChunkSize) {
+  std::vector<std::string_view> chunks;
+  const size_t chunkSize = std::max(
+      minChunkSize, (content.size() + std::max<size_t>(maxChunks, 1) - 1) /
+                        std::max<size_t>(maxChunks, 1));
+  size_t chunkBegin = 0;
+  for (size_t pos = 0; pos < content.size(); ++pos) {
+    switch (content[pos]) {
+      case '"':
+        // skip the string literal, where a backslash escapes the next
+        // character
+        for (++pos; pos < content.size() && content[pos] != '"'; ++pos) {
+          if (content[pos] == '\\') {
+            ++pos;
+          }
+        }
+        break;
+      case '%':
+        pos = std::min(content.find('\n', pos), content.size());
+        break;
+      case ';':
+        if (pos + 1 - chunkBegin >= chunkSize &&
+            chunks.size() + 1 < maxChunks) {
+          chunks.push_back(content.substr(chunkBegin, pos + 1 - chunkBegin));
+          chunkBegin = pos + 1;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  if (chunkBegin < content.size() || chunks.empty()) {
+    chunks.push_back(content.substr(chunkBegin));
+  }
+  return chunks;
+}
+
+}  // namespace fznparser::parser
@@ -0,0 +1,667 @@
+#include "fznparser/parser/descentParser.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "fznparser/parser/grammarAst.hpp"
+#include "fznparser/parser/lexer.hpp"
+
+namespace fznparser::parser {
+
+DescentParser::DescentParser(const std::string_view content)
+    : _lexer(content) {}
+
+bool DescentParser::isKeyword(const std::string_view keyword) const {
+  return token().kind == TokenKind::IDENTIFIER && token().text == keyword;
+}
+
+// whether the array declaration starting at the current token is
+// "array" "[" ... "]" "of" "var" ...
+bool DescentParser::isArrayOfVar() {
+  if (token().text.data() == _arrayDecl) {
+    return _arrayDeclIsOfVar;
+  }
+  _arrayDecl = token().text.data();
+  _arrayDeclIsOfVar = false;
+  Lexer lookahead(_lexer);
+  while (lookahead.token().kind != TokenKind::RIGHT_BRACKET &&
+         lookahead.token().kind != TokenKind::END) {
+    lookahead.advance();
+  }
+  if (lookahead.token().kind == TokenKind::END) {
+    return false;
+  }
+  lookahead.advance();
+  lookahead.advance();
+  _arrayDeclIsOfVar = lookahead.token().kind == TokenKind::IDENTIFIER &&
+                      lookahead.token().text == "var";
+  return _arrayDeclIsOfVar;
+}
+
+bool DescentParser::accept(const TokenKind kind) {
+  if (token().kind != kind) {
+    return false;
+  }
+  _lexer.advance();
+  return true;
+}
+
+bool DescentParser::acceptKeyword(const std::string_view keyword) {
+  if (!isKeyword(keyword)) {
+    return false;
+  }
+  _lexer.advance();
+  return true;
+}
+
+void DescentParser::expect(const TokenKind kind) {
+  if (!accept(kind)) {
+    _lexer.fail(toString(kind));
+  }
+}
+
+void DescentParser::expectKeyword(const std::string_view keyword) {
+  if (!acceptKeyword(keyword)) {
+    _lexer.fail("\"" + std::string(keyword) + "\"");
+  }
+}
+
+/*
+<identifier> ::= [A-Za-z][A-Za-z0-9_]*
+*/
+std::string DescentParser::identifier() {
+  if (token().kind != TokenKind::IDENTIFIER || token().text.front() == '_') {
+    _lexer.fail(toString(TokenKind::IDENTIFIER));
+  }
+  return varParIdentifier();
+}
+
+/*
+<var-par-identifier> ::= [A-Za-z_][A-Za-z0-9_]*
+*/
+std::string DescentParser::varParIdentifier() {
+  if (token().kind != TokenKind::IDENTIFIER) {
+    _lexer.fail(toString(TokenKind::IDENTIFIER));
+  }
+  std::string identifier(token().text);
+  _lexer.advance();
+  return identifier;
+}
+
+int64_t DescentParser::intLiteral() {
+  if (token().kind != TokenKind::INT_LITERAL) {
+    _lexer.fail(toString(TokenKind::INT_LITERAL));
+  }
+  const int64_t value = token().intValue;
+  _lexer.advance();
+  return value;
+}
+
+double DescentParser::floatLiteral() {
+  if (token().kind != TokenKind::FLOAT_LITERAL) {
+    _lexer.fail(toString(TokenKind::FLOAT_LITERAL));
+  }
+  const double value = token().floatValue;
+  _lexer.advance();
+  return value;
+}
+
+// like the X3 grammar, the quotes are part of the string and escaped quotes
+// are unescaped, while other escaped characters keep their backslash
+std::string DescentParser::stringLiteral() {
+  const std::string_view text = token().text;
+  std::string str;
+  str.reserve(text.size() + 2);
+  str += '"';
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (text[i] == '\\' && i + 1 < text.size()) {
+      if (text[i + 1] != '"') {
+        str += text[i];
+      }
+      ++i;
+    }
+    str += text[i];
+  }
+  str += '"';
+  _lexer.advance();
+  return str;
+}
+
+// "{" [ <int-literal> "," ... ] "}"
+ArenaVector<int64_t> DescentParser::intSet() {
+  expect(TokenKind::LEFT_BRACE);
+  ArenaVector<int64_t> values;
+  if (accept(TokenKind::RIGHT_BRACE)) {
+    return values;
+  }
+  do {
+    values.push_back(intLiteral());
+  } while (accept(TokenKind::COMMA));
+  expect(TokenKind::RIGHT_BRACE);
+  return values;
+}
+
+/*
+<index-set> ::= "1" ".." <int-literal>
+*/
+IndexSet DescentParser::indexSet() {
+  if (token().kind != TokenKind::INT_LITERAL || token().intValue != 1) {
+    _lexer.fail("an index set starting at 1");
+  }
+  _lexer.advance();
+  expect(TokenKind::DOT_DOT);
+  return IndexSet{intLiteral()};
+}
+
+/*
+<basic-par-type> ::= "bool"
+                   | "int"
+                   | "float"
+                   | "set of int"
+*/
+BasicParType DescentParser::basicParType() {
+  if (acceptKeyword("bool")) {
+    return BasicParType::BOOL;
+  }
+  if (acceptKeyword("int")) {
+    return BasicParType::INT;
+  }
+  if (acceptKeyword("float")) {
+    return BasicParType::FLOAT;
+  }
+  if (acceptKeyword("set")) {
+    expectKeyword("of");
+    expectKeyword("int");
+    return BasicParType::SET_OF_INT;
+  }
+  _lexer.fail("a parameter type");
+}
+
+/*
+<par-type> ::= <basic-par-type>
+             | "array" "[" <index-set> "]" "of" <basic-par-type>
+*/
+ParType DescentParser::parType() {
+  if (!acceptKeyword("array")) {
+    return ParType{basicParType()};
+  }
+  expect(TokenKind::LEFT_BRACKET);
+  BasicParTypeArray array{indexSet(), BasicParType::BOOL};
+  expect(TokenKind::RIGHT_BRACKET);
+  expectKeyword("of");
+  array.type = basicParType();
+  return ParType{array};
+}
+
+/*
+<basic-var-type> ::= "var" <basic-par-type>
+                   | "var" <int-literal> ".." <int-literal>
+                   | "var" "{" <int-literal> "," ... "}"
+                   | "var" <float-literal> ".." <float-literal>
+                   | "var" "set" "of" <int-literal> ".." <int-literal>
+                   | "var" "set" "of" "{" [ <int-literal> "," ... ] "}"
+*/
+template <typename Variant>
+Variant DescentParser::basicVarType() {
+  expectKeyword("var");
+  if (acceptKeyword("bool")) {
+    return Variant{BasicVarBoolType{}};
+  }
+  if (acceptKeyword("int")) {
+    return Variant{BasicVarIntTypeUnbounded{}};
+  }
+  if (acceptKeyword("float")) {
+    return Variant{BasicVarFloatTypeUnbounded{}};
+  }
+  if (acceptKeyword("set")) {
+    expectKeyword("of");
+    if (token().kind == TokenKind::LEFT_BRACE) {
+      return Variant{BasicVarSetTypeSet{intSet()}};
+    }
+    // "var set of int" is unbounded unless a range follows
+    if (acceptKeyword("int") && token().kind != TokenKind::INT_LITERAL) {
+      return Variant{BasicVarSetTypeUnbounded{}};
+    }
+    const int64_t lowerBound = intLiteral();
+    expect(TokenKind::DOT_DOT);
+    return Variant{BasicVarSetTypeBounded{lowerBound, intLiteral()}};
+  }
+  if (token().kind == TokenKind::LEFT_BRACE) {
+    return Variant{BasicVarIntTypeSet{intSet()}};
+  }
+  if (token().kind == TokenKind::FLOAT_LITERAL) {
+    const double lowerBound = floatLiteral();
+    expect(TokenKind::DOT_DOT);
+    return Variant{BasicVarFloatTypeBounded{lowerBound, floatLiteral()}};
+  }
+  if (token().kind != TokenKind::INT_LITERAL) {
+    _lexer.fail("a variable type");
+  }
+  const int64_t lowerBound = intLiteral();
+  expect(TokenKind::DOT_DOT);
+  return Variant{BasicVarIntTypeBounded{lowerBound, intLiteral()}};
+}
+
+/*
+<array-var-type> ::= "array" "[" <index-set> "]" "of" <basic-var-type>
+*/
+ArrayVarType DescentParser::arrayVarType() {
+  expectKeyword("array");
+  expect(TokenKind::LEFT_BRACKET);
+  const IndexSet arrayIndexSet = indexSet();
+  expect(TokenKind::RIGHT_BRACKET);
+  expectKeyword("of");
+  return ArrayVarType{arrayIndexSet, basicVarType<BasicVarType>()};
+}
+
+/*
+<basic-pred-param-type> ::= <basic-par-type>
+                          | <basic-var-type>
+                          | <int-literal> ".." <int-literal>
+                          | <float-literal> ".." <float-literal>
+                          | "{" <int-literal> "," ... "}"
+                          | "set" "of" <int-literal> .. <int-literal>
+                          | "set" "of" "{" [  <int-literal> "," ... ] "}"
+*/
+template <typename Variant>
+Variant DescentParser::basicPredParamType() {
+  if (isKeyword("var")) {
+    return basicVarType<Variant>();
+  }
+  if (acceptKeyword("set")) {
+    expectKeyword("of");
+    if (acceptKeyword("int")) {
+      return Variant{BasicParType::SET_OF_INT};
+    }
+    if (token().kind == TokenKind::LEFT_BRACE) {
+      return Variant{BasicPredParamTypeSetSet{intSet()}};
+    }
+    const int64_t lowerBound = intLiteral();
+    expect(TokenKind::DOT_DOT);
+    return Variant{BasicPredParamTypeSetBounded{lowerBound, intLiteral()}};
+  }
+  if (token().kind == TokenKind::IDENTIFIER) {
+    return Variant{basicParType()};
+  }
+  if (token().kind == TokenKind::LEFT_BRACE) {
+    return Variant{BasicPredParamTypeIntSet{intSet()}};
+  }
+  if (token().kind == TokenKind::FLOAT_LITERAL) {
+    const double lowerBound = floatLiteral();
+    expect(TokenKind::DOT_DOT);
+    return Variant{BasicPredParamTypeFloatBounded{lowerBound, floatLiteral()}};
+  }
+  if (token().kind != TokenKind::INT_LITERAL) {
+    _lexer.fail("a predicate parameter type");
+  }
+  const int64_t lowerBound = intLiteral();
+  expect(TokenKind::DOT_DOT);
+  return Variant{BasicPredParamTypeIntBounded{lowerBound, intLiteral()}};
+}
+
+/*
+<pred-param-type> ::= <basic-pred-param-type>
+                    | "array" "[" <pred-index-set> "]" "of"
+                      <basic-pred-param-type>
+<pred-index-set> ::= <index-set>
+                   | "int"
+*/
+PredParamType DescentParser::predParamType() {
+  if (!acceptKeyword("array")) {
+    return basicPredParamType<PredParamType>();
+  }
+  expect(TokenKind::LEFT_BRACKET);
+  const PredIndexSet predIndexSet = acceptKeyword("int")
+                                        ? PredIndexSet{IndexSetUnbounded{}}
+                                        : PredIndexSet{indexSet()};
+  expect(TokenKind::RIGHT_BRACKET);
+  expectKeyword("of");
+  return PredParamType{PredParamArrayType{
+      predIndexSet, basicPredParamType<BasicPredParamType>()}};
+}
+
+/*
+<pred-param-type> : <identifier>
+*/
+PredParam DescentParser::predParam() {
+  PredParamType type = predParamType();
+  expect(TokenKind::COLON);
+  return PredParam{std::move(type), identifier()};
+}
+
+/*
+<basic-literal-expr> ::= <bool-literal>
+                       | <int-literal>
+                       | <float-literal>
+                       | <set-literal>
+<set-literal> ::= "{" [ <int-literal> "," ... ] "}"
+                | <int-literal> ".." <int-literal>
+                | "{" [ <float-literal> "," ... ] "}"
+                | <float-literal> ".." <float-literal>
+*/
+template <typename Variant>
+Variant DescentParser::basicLiteralExpr() {
+  if (acceptKeyword("true")) {
+    return Variant{true};
+  }
+  if (acceptKeyword("false")) {
+    return Variant{false};
+  }
+  if (accept(TokenKind::LEFT_BRACE)) {
+    if (accept(TokenKind::RIGHT_BRACE)) {
+      return Variant{SetLiteralEmpty{}};
+    }
+    if (token().kind == TokenKind::FLOAT_LITERAL) {
+      FloatSetLiteralSet set;
+      do {
+        set.push_back(floatLiteral());
+      } while (accept(TokenKind::COMMA));
+      expect(TokenKind::RIGHT_BRACE);
+      return Variant{std::move(set)};
+    }
+    IntSetLiteralSet set;
+    do {
+      set.push_back(intLiteral());
+    } while (accept(TokenKind::COMMA));
+    expect(TokenKind::RIGHT_BRACE);
+    return Variant{std::move(set)};
+  }
+  if (token().kind == TokenKind::FLOAT_LITERAL) {
+    const double value = floatLiteral();
+    if (accept(TokenKind::DOT_DOT)) {
+      return Variant{FloatSetLiteralBounded{value, floatLiteral()}};
+    }
+    return Variant{value};
+  }
+  if (token().kind != TokenKind::INT_LITERAL) {
+    _lexer.fail("a literal");
+  }
+  const int64_t value = intLiteral();
+  if (accept(TokenKind::DOT_DOT)) {
+    return Variant{IntSetLiteralBounded{value, intLiteral()}};
+  }
+  return Variant{value};
+}
+
+/*
+<basic-expr> ::= <basic-literal-expr>
+               | <var-par-identifier>
+*/
+template <typename Variant>
+Variant DescentParser::basicExpr() {
+  if (token().kind == TokenKind::IDENTIFIER && !isKeyword("true") &&
+      !isKeyword("false")) {
+    return Variant{varParIdentifier()};
+  }
+  return basicLiteralExpr<Variant>();
+}
+
+/*
+<array-literal> ::= "[" [ <basic-expr> "," ... ] "]"
+*/
+ArrayLiteral DescentParser::arrayLiteral() {
+  expect(TokenKind::LEFT_BRACKET);
+  ArrayLiteral array;
+  if (accept(TokenKind::RIGHT_BRACKET)) {
+    return array;
+  }
+  do {
+    array.push_back(basicExpr<BasicExpr>());
+  } while (accept(TokenKind::COMMA));
+  expect(TokenKind::RIGHT_BRACKET);
+  return array;
+}
+
+/*
+<expr>       ::= <basic-expr>
+               | <array-literal>
+*/
+Expr DescentParser::expr() {
+  if (token().kind == TokenKind::LEFT_BRACKET) {
+    return Expr{arrayLiteral()};
+  }
+  return basicExpr<Expr>();
+}
+
+/*
+<par-expr>   ::= <basic-literal-expr>
+               | <par-array-literal>
+<par-array-literal> ::= "[" [ <basic-literal-expr> "," ... ] "]"
+*/
+ParExpr DescentParser::parExpr() {
+  if (!accept(TokenKind::LEFT_BRACKET)) {
+    return basicLiteralExpr<ParExpr>();
+  }
+  ParArrayLiteral array;
+  if (accept(TokenKind::RIGHT_BRACKET)) {
+    return ParExpr{std::move(array)};
+  }
+  do {
+    array.push_back(basicLiteralExpr<BasicLiteralExpr>());
+  } while (accept(TokenKind::COMMA));
+  expect(TokenKind::RIGHT_BRACKET);
+  return ParExpr{std::move(array)};
+}
+
+/*
+<basic-ann-expr>   := <basic-literal-expr>
+                    | <string-literal>
+                    | <annotation>
+*/
+BasicAnnExpr DescentParser::basicAnnExpr() {
+  if (token().kind == TokenKind::STRING_LITERAL) {
+    return BasicAnnExpr{stringLiteral()};
+  }
+  if (token().kind == TokenKind::IDENTIFIER && !isKeyword("true") &&
+      !isKeyword("false")) {
+    return BasicAnnExpr{x3::forward_ast<Annotation>{annotation()}};
+  }
+  return basicLiteralExpr<BasicAnnExpr>();
+}
+
+/*
+<ann-expr>   := <basic-ann-expr>
+              | "[" [ <basic-ann-expr> "," ... ] "]"
+*/
+AnnExpr DescentParser::annExpr() {
+  AnnExpr exprs;
+  if (!accept(TokenKind::LEFT_BRACKET)) {
+    exprs.push_back(basicAnnExpr());
+    return exprs;
+  }
+  if (accept(TokenKind::RIGHT_BRACKET)) {
+    return exprs;
+  }
+  do {
+    exprs.push_back(basicAnnExpr());
+  } while (accept(TokenKind::COMMA));
+  expect(TokenKind::RIGHT_BRACKET);
+  return exprs;
+}
+
+/*
+<annotation> ::= <identifier>
+               | <identifier> "(" <ann-expr> "," ... ")"
+*/
+Annotation DescentParser::annotation() {
+  Annotation ann{identifier(), {}};
+  if (!accept(TokenKind::LEFT_PAREN)) {
+    return ann;
+  }
+  do {
+    ann.expressions.push_back(annExpr());
+  } while (accept(TokenKind::COMMA));
+  expect(TokenKind::RIGHT_PAREN);
+  return ann;
+}
+
+/*
+<annotations> ::= [ "::" <annotation> ]*
+*/
+Annotations DescentParser::annotations() {
+  Annotations anns;
+  while (accept(TokenKind::DOUBLE_COLON)) {
+    anns.push_back(annotation());
+  }
+  return anns;
+}
+
+/*
+<predicate-item> ::= "predicate" <identifier> "(" [ <pred-param-type> :
+                     <identifier> "," ... ] ")" ";"
+*/
+std::optional<PredicateItem> DescentParser::predicateItem() {
+  if (!acceptKeyword("predicate")) {
+    return std::nullopt;
+  }
+  PredicateItem item{identifier(), {}};
+  expect(TokenKind::LEFT_PAREN);
+  if (!accept(TokenKind::RIGHT_PAREN)) {
+    do {
+      item.params.push_back(predParam());
+    } while (accept(TokenKind::COMMA));
+    expect(TokenKind::RIGHT_PAREN);
+  }
+  expect(TokenKind::SEMICOLON);
+  return item;
+}
+
+/*
+<par-decl-item> ::= <par-type> ":" <var-par-identifier> "=" <par-expr> ";"
+*/
+std::optional<ParDeclItem> DescentParser::parDeclItem() {
+  if (!isKeyword("bool") && !isKeyword("int") && !isKeyword("float") &&
+      !isKeyword("set") && !(isKeyword("array") && !isArrayOfVar())) {
+    return std::nullopt;
+  }
+  ParDeclItem item;
+  item.type = parType();
+  expect(TokenKind::COLON);
+  item.identifier = varParIdentifier();
+  expect(TokenKind::EQUALS);
+  item.expr = parExpr();
+  expect(TokenKind::SEMICOLON);
+  return item;
+}
+
+/*
+<var-decl-item> ::= <basic-var-type> ":" <var-par-identifier> <annotations>
+                    [ "=" <basic-expr> ] ";"
+                  | <array-var-type> ":" <var-par-identifier> <annotations>
+                    "=" <array-literal> ";"
+*/
+std::optional<VarDeclItem> DescentParser::varDeclItem() {
+  if (isKeyword("var")) {
+    BasicVarDecl decl;
+    decl.type = basicVarType<BasicVarType>();
+    expect(TokenKind::COLON);
+    decl.identifier = varParIdentifier();
+    decl.annotations = annotations();
+    if (accept(TokenKind::EQUALS)) {
+      decl.expr = basicExpr<BasicExpr>();
+    }
+    expect(TokenKind::SEMICOLON);
+    return VarDeclItem{std::move(decl)};
+  }
+  if (!isKeyword("array") || !isArrayOfVar()) {
+    return std::nullopt;
+  }
+  ArrayVarDecl decl;
+  decl.type = arrayVarType();
+  expect(TokenKind::COLON);
+  decl.identifier = varParIdentifier();
+  decl.annotations = annotations();
+  expect(TokenKind::EQUALS);
+  decl.literals = arrayLiteral();
+  expect(TokenKind::SEMICOLON);
+  return VarDeclItem{std::move(decl)};
+}
+
+/*
+<constraint-item> ::= "constraint" <identifier> "(" [ <expr> "," ... ] ")"
+                      <annotations> ";"
+*/
+std::optional<ConstraintItem> DescentParser::constraintItem() {
+  if (!acceptKeyword("constraint")) {
+    return std::nullopt;
+  }
+  ConstraintItem item;
+  item.identifier = identifier();
+  expect(TokenKind::LEFT_PAREN);
+  if (!accept(TokenKind::RIGHT_PAREN)) {
+    do {
+      item.expressions.push_back(expr());
+    } while (accept(TokenKind::COMMA));
+    expect(TokenKind::RIGHT_PAREN);
+  }
+  item.annotations = annotations();
+  expect(TokenKind::SEMICOLON);
+  return item;
+}
+
+/*
+<solve-item> ::= "solve" <annotations> "satisfy" ";"
+               | "solve" <annotations> "minimize" <basic-expr> ";"
+               | "solve" <annotations> "maximize" <basic-expr> ";"
+*/
+std::optional<SolveItem> DescentParser::solveItem() {
+  if (!acceptKeyword("solve")) {
+    return std::nullopt;
+  }
+  Annotations anns = annotations();
+  if (acceptKeyword("satisfy")) {
+    expect(TokenKind::SEMICOLON);
+    return SolveItem{SolveSatisfy{std::move(anns)}};
+  }
+  OptimizationType type = OptimizationType::MINIMIZE;
+  if (acceptKeyword("maximize")) {
+    type = OptimizationType::MAXIMIZE;
+  } else if (!acceptKeyword("minimize")) {
+    _lexer.fail("\"satisfy\", \"minimize\" or \"maximize\"");
+  }
+  SolveOptimize solveOptimize{std::move(anns), type, basicExpr<BasicExpr>()};
+  expect(TokenKind::SEMICOLON);
+  return SolveItem{std::move(solveOptimize)};
+}
+
+bool DescentParser::atEnd() const noexcept {
+  return token().kind == TokenKind::END;
+}
+
+/*
+<model> ::=
+  [ <predicate-item> ]*
+  [ <par-decl-item> ]*
+  [ <var-decl-item> ]*
+  [ <constraint-item> ]*
+  <solve-item>
+*/
+Model DescentParser::model() {
+  Model model;
+  while (auto item = predicateItem()) {
+    model.predicateItems.push_back(std::move(*item));
+  }
+  while (auto item = parDeclItem()) {
+    model.parDeclItems.push_back(std::move(*item));
+  }
+  while (auto item = varDeclItem()) {
+    model.varDeclItems.push_back(std::move(*item));
+  }
+  while (auto item = constraintItem()) {
+    model.constraintItems.push_back(std::move(*item));
+  }
+  auto item = solveItem();
+  if (!item.has_value()) {
+    _lexer.fail("a solve item");
+  }
+  model.solveItem = std::move(*item);
+  if (!atEnd()) {
+    _lexer.fail(toString(TokenKind::END));
+  }
+  return model;
+}
+
+}  // namespace fznparser::parser
@@ -0,0 +1,56 @@
+#include "fznparser/parser/floatLiteral.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <system_error>
+
+namespace fznparser::parser {
+
+inline bool isFloatDigit(const char c) { return '0' <= c && c <= '9'; }
+
+// whether the magnitude of the float literal in [first, last), which is out of
+// the range of double, is below one. The magnitude is then either below
+// 1e-300 or above 1e300, so its decimal exponent is only needed roughly.
+bool isBelowOne(const char* first, const char* last) {
+  const char* pos = first != last && *first == '-' ? first + 1 : first;
+  // the number of digits before the decimal point, not counting leading
+  // zeros, or minus the number of zeros after the point if there are none
+  int64_t magnitude = 0;
+  bool isZero = true;
+  for (; pos != last && isFloatDigit(*pos); ++pos) {
+    isZero = isZero && *pos == '0';
+    magnitude += isZero ? 0 : 1;
+  }
+  if (pos != last && *pos == '.') {
+    for (++pos; pos != last && isFloatDigit(*pos); ++pos) {
+      isZero = isZero && *pos == '0';
+      magnitude -= isZero ? 1 : 0;
+    }
+  }
+  if (pos == last || (*pos != 'e' && *pos != 'E')) {
+    return magnitude <= 0;
+  }
+  ++pos;
+  if (pos != last && *pos == '+') {
+    ++pos;
+  }
+  int64_t exponent = 0;
+  if (std::from_chars(pos, last, exponent).ec != std::errc{}) {
+    // an exponent beyond 64 bits decides on its own
+    return *pos == '-';
+  }
+  return exponent <= -magnitude;
+}
+
+std::from_chars_result floatFromChars(const char* first, const char* last,
+                                      double& value) {
+  const std::from_chars_result result = std::from_chars(first, last, value);
+  if (result.ec == std::errc::result_out_of_range &&
+      isBelowOne(first, result.ptr)) {
+    value = *first == '-' ? -0.0 : 0.0;
+    return {result.ptr, std::errc{}};
+  }
+  return result;
+}
+
+}  // namespace fznparser::parser
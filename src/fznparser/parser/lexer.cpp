@@ -0,0 +1,320 @@
+#include "fznparser/parser/lexer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "fznparser/except.hpp"
+#include "fznparser/parser/floatLiteral.hpp"
+
+namespace fznparser::parser {
+
+enum class CharClass : uint8_t {
+  INVALID,
+  SPACE,
+  LETTER,
+  // only var-par-identifiers can start with an underscore, which the parser
+  // checks
+  UNDERSCORE,
+  DIGIT,
+  SIGN,
+  QUOTE,
+  PERCENT,
+  COLON,
+  DOT,
+  PUNCTUATION
+};
+
+constexpr std::array<CharClass, 256> charClasses = [] {
+  std::array<CharClass, 256> classes{};
+  for (const char c : std::string_view(" \t\n\v\f\r")) {
+    classes[static_cast<unsigned char>(c)] = CharClass::SPACE;
+  }
+  for (char c = 'a'; c <= 'z'; ++c) {
+    classes[static_cast<unsigned char>(c)] = CharClass::LETTER;
+    classes[static_cast<unsigned char>(c - 'a' + 'A')] = CharClass::LETTER;
+  }
+  classes['_'] = CharClass::UNDERSCORE;
+  for (char c = '0'; c <= '9'; ++c) {
+    classes[static_cast<unsigned char>(c)] = CharClass::DIGIT;
+  }
+  classes['-'] = CharClass::SIGN;
+  classes['+'] = CharClass::SIGN;
+  classes['"'] = CharClass::QUOTE;
+  classes['%'] = CharClass::PERCENT;
+  classes[':'] = CharClass::COLON;
+  classes['.'] = CharClass::DOT;
+  for (const char c : std::string_view("()[]{},;=")) {
+    classes[static_cast<unsigned char>(c)] = CharClass::PUNCTUATION;
+  }
+  return classes;
+}();
+
+constexpr std::array<TokenKind, 256> punctuationKinds = [] {
+  std::array<TokenKind, 256> kinds{};
+  kinds['('] = TokenKind::LEFT_PAREN;
+  kinds[')'] = TokenKind::RIGHT_PAREN;
+  kinds['['] = TokenKind::LEFT_BRACKET;
+  kinds[']'] = TokenKind::RIGHT_BRACKET;
+  kinds['{'] = TokenKind::LEFT_BRACE;
+  kinds['}'] = TokenKind::RIGHT_BRACE;
+  kinds[','] = TokenKind::COMMA;
+  kinds[';'] = TokenKind::SEMICOLON;
+  kinds['='] = TokenKind::EQUALS;
+  return kinds;
+}();
+
+inline CharClass charClass(const char c) {
+  return charClasses[static_cast<unsigned char>(c)];
+}
+
+inline bool isDigit(const char c) { return charClass(c) == CharClass::DIGIT; }
+
+inline bool isIdentifierChar(const char c) {
+  const CharClass cc = charClass(c);
+  return cc == CharClass::LETTER || cc == CharClass::UNDERSCORE ||
+         cc == CharClass::DIGIT;
+}
+
+inline bool isDigitInBase(const char c, const int base) {
+  if (base == 8) {
+    return c >= '0' && c <= '7';
+  }
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+Lexer::Lexer(const std::string_view content)
+    : _begin(content.data()),
+      _pos(content.data()),
+      _end(content.data() + content.size()) {
+  advance();
+}
+
+void Lexer::skipWhitespaceAndComments() {
+  while (_pos != _end) {
+    const CharClass c = charClass(*_pos);
+    if (c == CharClass::SPACE) {
+      ++_pos;
+    } else if (c == CharClass::PERCENT) {
+      _pos = std::find(_pos, _end, '\n');
+    } else {
+      return;
+    }
+  }
+}
+
+void Lexer::advance() {
+  skipWhitespaceAndComments();
+  const char* start = _pos;
+  if (_pos == _end) {
+    _token = Token{TokenKind::END, std::string_view(_pos, 0)};
+    return;
+  }
+  switch (charClass(*_pos)) {
+    case CharClass::LETTER:
+    case CharClass::UNDERSCORE:
+      ++_pos;
+      while (_pos != _end && isIdentifierChar(*_pos)) {
+        ++_pos;
+      }
+      _token =
+          Token{TokenKind::IDENTIFIER,
+                std::string_view(start, static_cast<size_t>(_pos - start))};
+      return;
+    case CharClass::DIGIT:
+    case CharClass::SIGN:
+      lexNumber();
+      return;
+    case CharClass::QUOTE:
+      lexString();
+      return;
+    case CharClass::PUNCTUATION:
+      ++_pos;
+      _token = Token{punctuationKinds[static_cast<unsigned char>(*start)],
+                     std::string_view(start, 1)};
+      return;
+    case CharClass::COLON:
+      ++_pos;
+      if (_pos != _end && *_pos == ':') {
+        ++_pos;
+        _token = Token{TokenKind::DOUBLE_COLON, std::string_view(start, 2)};
+      } else {
+        _token = Token{TokenKind::COLON, std::string_view(start, 1)};
+      }
+      return;
+    case CharClass::DOT:
+      if (_pos + 1 != _end && _pos[1] == '.') {
+        _pos += 2;
+        _token = Token{TokenKind::DOT_DOT, std::string_view(start, 2)};
+        return;
+      }
+      break;
+    default:
+      break;
+  }
+  _token = Token{TokenKind::END, std::string_view(start, 1)};
+  fail("a token");
+}
+
+/*
+<int-literal> ::= [-]?[0-9]+
+                | [-]?0x[0-9A-Fa-f]+
+                | [-]?0o[0-7]+
+
+<float-literal> ::= [-]?[0-9]+.[0-9]+
+                  | [-]?[0-9]+.[0-9]+[Ee][-+]?[0-9]+
+                  | [-]?[0-9]+[Ee][-+]?[0-9]+
+*/
+void Lexer::lexNumber() {
+  const char* start = _pos;
+  // like the X3 grammar, there is no explicit plus sign, so "+1" fails below
+  const bool negative = *_pos == '-';
+  if (negative) {
+    ++_pos;
+  }
+  _token = Token{TokenKind::INT_LITERAL, std::string_view(start, 1)};
+  if (_pos == _end || !isDigit(*_pos)) {
+    fail("a number");
+  }
+
+  const auto tokenText = [&] {
+    return std::string_view(start, static_cast<size_t>(_pos - start));
+  };
+
+  if (*_pos == '0' && _end - _pos > 2 && (_pos[1] == 'x' || _pos[1] == 'o') &&
+      isDigitInBase(_pos[2], _pos[1] == 'x' ? 16 : 8)) {
+    const int base = _pos[1] == 'x' ? 16 : 8;
+    int64_t value = 0;
+    const auto [ptr, ec] = std::from_chars(_pos + 2, _end, value, base);
+    _pos = ptr;
+    _token.text = tokenText();
+    if (ec != std::errc{}) {
+      fail("an integer literal that fits in 64 bits");
+    }
+    _token.intValue = negative ? -value : value;
+    return;
+  }
+
+  while (_pos != _end && isDigit(*_pos)) {
+    ++_pos;
+  }
+  bool isFloat = false;
+  if (_end - _pos > 1 && *_pos == '.' && isDigit(_pos[1])) {
+    isFloat = true;
+    _pos += 2;
+    while (_pos != _end && isDigit(*_pos)) {
+      ++_pos;
+    }
+  }
+  if (_pos != _end && (*_pos == 'e' || *_pos == 'E')) {
+    const char* exponent = _pos + 1;
+    if (exponent != _end && charClass(*exponent) == CharClass::SIGN) {
+      ++exponent;
+    }
+    if (exponent != _end && isDigit(*exponent)) {
+      isFloat = true;
+      _pos = exponent;
+      while (_pos != _end && isDigit(*_pos)) {
+        ++_pos;
+      }
+    }
+  }
+  _token.text = tokenText();
+
+  if (isFloat) {
+    _token.kind = TokenKind::FLOAT_LITERAL;
+    const auto [ptr, ec] = floatFromChars(start, _pos, _token.floatValue);
+    if (ec != std::errc{} || ptr != _pos) {
+      fail("a finite float literal");
+    }
+    return;
+  }
+  const auto [ptr, ec] = std::from_chars(start, _pos, _token.intValue);
+  if (ec != std::errc{} || ptr != _pos) {
+    fail("an integer literal that fits in 64 bits");
+  }
+}
+
+/*
+<string-contents> ::= ([^"\n\] | \[^\n(])*
+<string-literal> ::= """ <string-contents> """
+*/
+void Lexer::lexString() {
+  const char* start = _pos;
+  ++_pos;
+  while (_pos != _end && *_pos != '"') {
+    // a backslash escapes the next character
+    if (*_pos == '\\' && _pos + 1 != _end) {
+      ++_pos;
+    }
+    ++_pos;
+  }
+  if (_pos == _end) {
+    _token = Token{TokenKind::END, std::string_view(start, 1)};
+    fail("a closing quote");
+  }
+  _token = Token{
+      TokenKind::STRING_LITERAL,
+      std::string_view(start + 1, static_cast<size_t>(_pos - start - 1))};
+  ++_pos;
+}
+
+size_t Lexer::line() const {
+  return 1 + static_cast<size_t>(std::count(_begin, _token.text.data(), '\n'));
+}
+
+void Lexer::fail(const std::string& expected) const {
+  const std::string found =
+      _token.text.empty()
+          ? "end of input"
+          : "\"" + std::string(_token.text.substr(0, 40)) + "\"";
+  throw FznException("Could not parse FlatZinc: expected " + expected +
+                     " but found " + found + " on line " +
+                     std::to_string(line()));
+}
+
+std::string toString(const TokenKind kind) {
+  switch (kind) {
+    case TokenKind::END:
+      return "end of input";
+    case TokenKind::IDENTIFIER:
+      return "an identifier";
+    case TokenKind::INT_LITERAL:
+      return "an integer literal";
+    case TokenKind::FLOAT_LITERAL:
+      return "a float literal";
+    case TokenKind::STRING_LITERAL:
+      return "a string literal";
+    case TokenKind::LEFT_PAREN:
+      return "\"(\"";
+    case TokenKind::RIGHT_PAREN:
+      return "\")\"";
+    case TokenKind::LEFT_BRACKET:
+      return "\"[\"";
+    case TokenKind::RIGHT_BRACKET:
+      return "\"]\"";
+    case TokenKind::LEFT_BRACE:
+      return "\"{\"";
+    case TokenKind::RIGHT_BRACE:
+      return "\"}\"";
+    case TokenKind::COMMA:
+      return "\",\"";
+    case TokenKind::COLON:
+      return "\":\"";
+    case TokenKind::DOUBLE_COLON:
+      return "\"::\"";
+    case TokenKind::SEMICOLON:
+      return "\";\"";
+    case TokenKind::EQUALS:
+      return "\"=\"";
+    case TokenKind::DOT_DOT:
+      return "\"..\"";
+    default:
+      return "";
+  }
+}
+
+}  // namespace fznparser::parser
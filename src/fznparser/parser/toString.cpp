@@ -16,8 +16,9 @@ std::string toString(const bool b) { return to_string(b); }
 std::string toString(const int64_t i) { return to_string(i); }
 std::string toString(const double f) { return to_string(f); }
 
-template <class T>
-std::string vecToString(const std::vector<T>& vec) {  // NOLINT(*-no-recursion)
+template <class T, class Allocator>
+std::string vecToString(  // NOLINT(*-no-recursion)
+    const std::vector<T, Allocator>& vec) {
   std::string str;
   for (size_t i = 0; i < vec.size(); ++i) {
     if (i != 0) {
@@ -0,0 +1,308 @@
+#include "fznparser/simd.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace fznparser::simd {
+
+// the number of elements that lowerBound compares at once
+constexpr size_t window = 16;
+
+const char* instructionSet() {
+#if defined(__AVX2__)
+  return "avx2";
+#elif defined(__SSE4_2__)
+  return "sse4.2";
+#else
+  return "scalar";
+#endif
+}
+
+// the number of elements that are less than the value
+size_t countLess(const int64_t* elements, const size_t size,
+                 const int64_t value) {
+  size_t count = 0;
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i values = _mm256_set1_epi64x(value);
+  for (; i + 4 <= size; i += 4) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements + i));
+    const __m256i less = _mm256_cmpgt_epi64(values, block);
+    count += static_cast<size_t>(std::popcount(static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(less)))));
+  }
+#elif defined(__SSE4_2__)
+  const __m128i values = _mm_set1_epi64x(value);
+  for (; i + 2 <= size; i += 2) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(elements + i));
+    const __m128i less = _mm_cmpgt_epi64(values, block);
+    count += static_cast<size_t>(std::popcount(
+        static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(less)))));
+  }
+#endif
+  for (; i < size; ++i) {
+    count += elements[i] < value ? 1 : 0;
+  }
+  return count;
+}
+
+size_t lowerBound(const std::span<const int64_t> sorted, const int64_t value) {
+  const int64_t* base = sorted.data();
+  size_t size = sorted.size();
+  // a binary search without branches, which leaves the lower bound within
+  // the window at base
+  while (size > window) {
+    const size_t half = size / 2;
+    base = base[half] < value ? base + half : base;
+    size -= half;
+  }
+  return static_cast<size_t>(base - sorted.data()) +
+         countLess(base, size, value);
+}
+
+size_t gallop(const std::span<const int64_t> sorted, const int64_t value) {
+  // the elements before begin are less than the value
+  size_t begin = 0;
+  size_t end = 4;
+  while (end < sorted.size() && sorted[end - 1] < value) {
+    begin = end;
+    end *= 2;
+  }
+  end = std::min(end, sorted.size());
+  return begin + lowerBound(sorted.subspan(begin, end - begin), value);
+}
+
+bool includes(const std::span<const int64_t> superset,
+              const std::span<const int64_t> subset) {
+  if (subset.empty()) {
+    return true;
+  }
+  if (subset.size() > superset.size() ||
+      subset.front() < superset.front() || superset.back() < subset.back()) {
+    return false;
+  }
+  if (superset.size() <= subset.size() * window) {
+    // a merge, which skips the superset faster than vector comparisons can
+    // when most of its elements are in the subset
+    return std::ranges::includes(superset, subset);
+  }
+  // the elements of the superset before first are less than the element
+  size_t first = 0;
+  for (const int64_t element : subset) {
+    first += gallop(superset.subspan(first), element);
+    if (first == superset.size() || superset[first] != element) {
+      return false;
+    }
+    ++first;
+  }
+  return true;
+}
+
+// the number of characters that scanIntList classifies at once
+constexpr size_t blockSize = 64;
+
+// ' ' and '\t' to '\r'
+bool isSpaceChar(const char c) {
+  return c == ' ' || ('\t' <= c && c <= '\r');
+}
+
+// bit i is set if character i of a block is in the class
+struct CharClasses {
+  uint64_t digits;
+  uint64_t spaces;
+  uint64_t commas;
+  uint64_t minuses;
+};
+
+#if defined(__AVX2__)
+// the classes of the 32 characters at chars, in the low bits
+CharClasses classifyChars32(const char* chars) {
+  const __m256i block =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars));
+  const auto mask = [](const __m256i matches) {
+    return static_cast<uint64_t>(
+        static_cast<uint32_t>(_mm256_movemask_epi8(matches)));
+  };
+  const __m256i digits =
+      _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), block));
+  // ' ' and '\t' to '\r'
+  const __m256i spaces = _mm256_or_si256(
+      _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')),
+      _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('\t' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), block)));
+  return {mask(digits), mask(spaces),
+          mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(','))),
+          mask(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('-')))};
+}
+#elif defined(__SSE4_2__)
+// the classes of the 16 characters at chars, in the low bits
+CharClasses classifyChars16(const char* chars) {
+  const __m128i block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  const auto mask = [](const __m128i matches) {
+    return static_cast<uint64_t>(
+        static_cast<uint32_t>(_mm_movemask_epi8(matches)));
+  };
+  const __m128i digits =
+      _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('0' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), block));
+  // ' ' and '\t' to '\r'
+  const __m128i spaces = _mm_or_si128(
+      _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+      _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('\r' + 1), block)));
+  return {mask(digits), mask(spaces),
+          mask(_mm_cmpeq_epi8(block, _mm_set1_epi8(','))),
+          mask(_mm_cmpeq_epi8(block, _mm_set1_epi8('-')))};
+}
+#endif
+
+// the classes of the blockSize characters at block
+CharClasses classifyChars(const char* block) {
+  CharClasses classes{0, 0, 0, 0};
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#if defined(__AVX2__)
+  constexpr size_t width = 32;
+#else
+  constexpr size_t width = 16;
+#endif
+  for (size_t i = 0; i < blockSize; i += width) {
+#if defined(__AVX2__)
+    const CharClasses part = classifyChars32(block + i);
+#else
+    const CharClasses part = classifyChars16(block + i);
+#endif
+    classes.digits |= part.digits << i;
+    classes.spaces |= part.spaces << i;
+    classes.commas |= part.commas << i;
+    classes.minuses |= part.minuses << i;
+  }
+#else
+  for (size_t i = 0; i < blockSize; ++i) {
+    const char c = block[i];
+    const uint64_t bit = uint64_t{1} << i;
+    classes.digits |= '0' <= c && c <= '9' ? bit : 0;
+    classes.spaces |= isSpaceChar(c) ? bit : 0;
+    classes.commas |= c == ',' ? bit : 0;
+    classes.minuses |= c == '-' ? bit : 0;
+  }
+#endif
+  return classes;
+}
+
+// the bits of the mask from the offset on, shifted to the low bits
+uint64_t bitsFrom(const uint64_t mask, const size_t offset) {
+  return offset < blockSize ? mask >> offset : 0;
+}
+
+IntList scanIntList(const char* first, const char* last,
+                    const std::span<int64_t> ints) {
+  IntList list{first, 0};
+  const char* pos = first;
+  char padded[blockSize];
+  while (list.size < ints.size()) {
+    const size_t available = static_cast<size_t>(last - pos);
+    const char* block = pos;
+    if (available < blockSize) {
+      // the zeros after the input end the run, as they are in no class
+      std::memset(padded, 0, blockSize);
+      std::memcpy(padded, pos, available);
+      block = padded;
+    }
+    const CharClasses classes = classifyChars(block);
+    // the characters of the block before offset have been parsed
+    size_t offset = 0;
+    // the number of characters of the block that have been parsed when the
+    // rest of the block cannot be, and the next block starts after them
+    size_t consumed = 0;
+    while (consumed == 0) {
+      const uint64_t nonSpaces = bitsFrom(~classes.spaces, offset);
+      if (nonSpaces == 0) {
+        consumed = blockSize;
+        break;
+      }
+      const size_t next =
+          offset + static_cast<size_t>(std::countr_zero(nonSpaces));
+      const bool negative = (bitsFrom(classes.minuses, next) & 1) != 0;
+      const size_t digitsStart = negative ? next + 1 : next;
+      const uint64_t nonDigits = bitsFrom(~classes.digits, digitsStart);
+      // the int literal and the separator after it
+      const uint64_t separators =
+          nonDigits == 0
+              ? 0
+              : bitsFrom(~classes.spaces,
+                         digitsStart +
+                             static_cast<size_t>(std::countr_zero(nonDigits)));
+      if (nonDigits == 0 || (separators == 0 && next > 0)) {
+        // they continue in the next block, unless the literal fills this one
+        if (next == 0) {
+          return list;
+        }
+        consumed = next;
+        break;
+      }
+      const size_t intEnd =
+          digitsStart + static_cast<size_t>(std::countr_zero(nonDigits));
+      // the separator is in the block unless the literal starts it and is
+      // followed by whitespace to its end
+      const char* separator = pos + blockSize;
+      if (separators != 0) {
+        separator = block + intEnd +
+                    static_cast<size_t>(std::countr_zero(separators));
+      } else {
+        while (separator != last && isSpaceChar(*separator)) {
+          ++separator;
+        }
+        if (separator == last) {
+          return list;
+        }
+      }
+      // otherwise the literal is part of a larger element, like 1..3 or 1.5
+      const bool comma = *separator == ',';
+      if (intEnd == digitsStart || (!comma && *separator != ']')) {
+        return list;
+      }
+      int64_t value = 0;
+      if (intEnd - digitsStart <= 18) {
+        for (size_t i = digitsStart; i < intEnd; ++i) {
+          value = value * 10 + (block[i] - '0');
+        }
+        value = negative ? -value : value;
+      } else {
+        // the literal may not fit in 64 bits
+        const auto [ptr, ec] =
+            std::from_chars(block + next, block + intEnd, value);
+        if (ec != std::errc{}) {
+          return list;
+        }
+      }
+      ints[list.size++] = value;
+      list.end = pos + intEnd;
+      if (!comma || list.size == ints.size()) {
+        return list;
+      }
+      if (separators == 0) {
+        consumed = static_cast<size_t>(separator + 1 - pos);
+        break;
+      }
+      offset = static_cast<size_t>(separator + 1 - block);
+    }
+    if (block == padded) {
+      return list;
+    }
+    pos += consumed;
+  }
+  return list;
+}
+
+}  // namespace fznparser::simd
@@ -0,0 +1,833 @@
+#include "fznparser/snapshot.hpp"
+
+#include <array>
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "fznparser/except.hpp"
+
+namespace fznparser {
+
+constexpr std::array<char, 8> snapshotMagic{'F', 'Z', 'N', 'S',
+                                            'N', 'A', 'P', '\0'};
+
+// the alternatives of Var, Arg and AnnotationExpression, in their order
+enum class VarKind : uint8_t {
+  BOOL,
+  INT,
+  FLOAT,
+  SET,
+  BOOL_ARRAY,
+  INT_ARRAY,
+  FLOAT_ARRAY,
+  SET_ARRAY,
+  REFERENCE
+};
+enum class ArgKind : uint8_t {
+  BOOL,
+  INT,
+  FLOAT,
+  INT_SET,
+  FLOAT_SET,
+  BOOL_ARRAY,
+  INT_ARRAY,
+  FLOAT_ARRAY,
+  SET_ARRAY,
+  FLOAT_SET_ARRAY
+};
+enum class ExpressionKind : uint8_t {
+  BOOL,
+  INT,
+  FLOAT,
+  INT_SET,
+  FLOAT_SET,
+  STRING,
+  ANNOTATION
+};
+// how a set, or the domain of a variable, is stored
+enum class SetKind : uint8_t { INTERVAL, ELEMENTS, INTERVALS };
+// the domain of a BoolVar that is not fixed
+constexpr uint8_t unfixedBool = 2;
+
+/**
+ * @brief A growing sequence of bytes. Unsigned integers are written as LEB128
+ * varints, signed integers are zigzag encoded first, and doubles are written
+ * as their 8 bytes in little-endian order, so that a snapshot does not depend
+ * on the byte order of the machine that wrote it.
+ */
+class SnapshotBuffer {
+  std::string _bytes;
+
+ public:
+  void byte(const uint8_t value) { _bytes.push_back(static_cast<char>(value)); }
+  void varint(uint64_t value) {
+    while (value >= 0x80) {
+      byte(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    byte(static_cast<uint8_t>(value));
+  }
+  void integer(const int64_t value) {
+    varint((static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63));
+  }
+  void real(const double value) {
+    const auto bits = std::bit_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+      byte(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+  }
+  void string(const std::string_view value) {
+    varint(value.size());
+    _bytes.append(value);
+  }
+  [[nodiscard]] const std::string& bytes() const { return _bytes; }
+};
+
+/**
+ * @brief Reads the values written by a SnapshotBuffer, throwing if the
+ * snapshot ends before a value does.
+ */
+class SnapshotReader {
+  const char* _pos;
+  const char* const _end;
+
+ public:
+  explicit SnapshotReader(const std::string_view snapshot)
+      : _pos(snapshot.data()), _end(snapshot.data() + snapshot.size()) {}
+
+  uint8_t byte() {
+    if (_pos == _end) {
+      throw FznException("Invalid snapshot: unexpected end");
+    }
+    return static_cast<uint8_t>(*_pos++);
+  }
+  uint64_t varint() {
+    // most varints are a single byte
+    if (_pos != _end && (static_cast<uint8_t>(*_pos) & 0x80) == 0) {
+      return static_cast<uint8_t>(*_pos++);
+    }
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      const uint8_t b = byte();
+      value |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if ((b & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw FznException("Invalid snapshot: varint is too long");
+  }
+  int64_t integer() {
+    const uint64_t value = varint();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+  double real() {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+      bits |= static_cast<uint64_t>(byte()) << (8 * i);
+    }
+    return std::bit_cast<double>(bits);
+  }
+  /**
+   * @return a number of elements, each of which takes at least one byte
+   */
+  size_t size() {
+    const uint64_t size = varint();
+    if (size > static_cast<uint64_t>(_end - _pos)) {
+      throw FznException("Invalid snapshot: unexpected end");
+    }
+    return static_cast<size_t>(size);
+  }
+  std::string_view string() {
+    const size_t length = size();
+    const std::string_view value(_pos, length);
+    _pos += length;
+    return value;
+  }
+  [[nodiscard]] bool atEnd() const { return _pos == _end; }
+};
+
+/**
+ * @brief Writes a model as a string table, a table of records and the
+ * model itself. Every variable, array and alias of the model is a record,
+ * which only refers to records that precede it.
+ */
+class SnapshotWriter {
+  // identifiers of constraints and annotations, which repeat a lot
+  SnapshotBuffer _strings;
+  std::unordered_map<std::string_view, uint64_t> _stringIds;
+  SnapshotBuffer _records;
+  std::unordered_map<const VarBase*, uint64_t> _recordIds;
+  SnapshotBuffer _model;
+
+  void symbol(SnapshotBuffer& out, const std::string& value) {
+    const auto [it, inserted] =
+        _stringIds.emplace(value, static_cast<uint64_t>(_stringIds.size()));
+    if (inserted) {
+      _strings.string(value);
+    }
+    out.varint(it->second);
+  }
+
+  void value(SnapshotBuffer& out, const bool b) { out.byte(b ? 1 : 0); }
+  void value(SnapshotBuffer& out, const int64_t i) { out.integer(i); }
+  void value(SnapshotBuffer& out, const double d) { out.real(d); }
+  void value(SnapshotBuffer& out, const IntSet& set) { setValue(out, set); }
+
+  template <class Set>
+  void setValue(SnapshotBuffer& out, const Set& set) {
+    if constexpr (std::is_same_v<Set, IntSet>) {
+      // interval lists and bitsets are written as their intervals
+      if (!set.hasElements() && !set.isInterval()) {
+        const std::vector<std::pair<int64_t, int64_t>> intervals =
+            set.intervals();
+        out.byte(static_cast<uint8_t>(SetKind::INTERVALS));
+        out.varint(intervals.size());
+        for (const auto& [lb, ub] : intervals) {
+          value(out, lb);
+          value(out, ub);
+        }
+        return;
+      }
+    }
+    if (set.hasElements()) {
+      out.byte(static_cast<uint8_t>(SetKind::ELEMENTS));
+      out.varint(set.elements().size());
+      for (const auto element : set.elements()) {
+        value(out, element);
+      }
+    } else {
+      out.byte(static_cast<uint8_t>(SetKind::INTERVAL));
+      value(out, set.lowerBound());
+      value(out, set.upperBound());
+    }
+  }
+
+  void annotationExpression(SnapshotBuffer& out,
+                            const AnnotationExpression& expr) {
+    out.byte(static_cast<uint8_t>(expr.index()));
+    switch (static_cast<ExpressionKind>(expr.index())) {
+      case ExpressionKind::BOOL:
+        return value(out, std::get<bool>(expr));
+      case ExpressionKind::INT:
+        return value(out, std::get<int64_t>(expr));
+      case ExpressionKind::FLOAT:
+        return value(out, std::get<double>(expr));
+      case ExpressionKind::INT_SET:
+        return setValue(out, std::get<IntSet>(expr));
+      case ExpressionKind::FLOAT_SET:
+        return setValue(out, std::get<FloatSet>(expr));
+      case ExpressionKind::STRING:
+        return symbol(out, std::get<std::string>(expr));
+      case ExpressionKind::ANNOTATION:
+        return annotation(out, std::get<Annotation>(expr));
+    }
+  }
+
+  void annotation(SnapshotBuffer& out, const Annotation& ann) {
+    symbol(out, ann.identifier());
+    out.varint(ann.expressions().size());
+    for (const std::vector<AnnotationExpression>& exprs : ann.expressions()) {
+      out.varint(exprs.size());
+      for (const AnnotationExpression& expr : exprs) {
+        annotationExpression(out, expr);
+      }
+    }
+  }
+
+  void annotations(SnapshotBuffer& out, const std::vector<Annotation>& anns) {
+    out.varint(anns.size());
+    for (const Annotation& ann : anns) {
+      annotation(out, ann);
+    }
+  }
+
+  [[nodiscard]] std::optional<uint64_t> findRecord(const VarBase& var) const {
+    const auto it = _recordIds.find(&var);
+    if (it == _recordIds.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  // the records that the record refers to must be written before it begins
+  void beginRecord(const VarKind kind, const VarBase& var) {
+    _records.byte(static_cast<uint8_t>(kind));
+    _records.string(var.identifier());
+    annotations(_records, var.annotations());
+  }
+
+  uint64_t endRecord(const VarBase& var) {
+    const auto id = static_cast<uint64_t>(_recordIds.size());
+    _recordIds.emplace(&var, id);
+    return id;
+  }
+
+  uint64_t record(const BoolVar& var) {
+    if (const auto id = findRecord(var)) {
+      return *id;
+    }
+    beginRecord(VarKind::BOOL, var);
+    _records.byte(var.isFixed() ? static_cast<uint8_t>(var.lowerBound())
+                                : unfixedBool);
+    return endRecord(var);
+  }
+
+  template <VarKind kind, class VarType>
+  uint64_t recordWithDomain(const VarType& var) {
+    if (const auto id = findRecord(var)) {
+      return *id;
+    }
+    beginRecord(kind, var);
+    setValue(_records, var.domain());
+    return endRecord(var);
+  }
+
+  uint64_t record(const IntVar& var) {
+    return recordWithDomain<VarKind::INT>(var);
+  }
+  uint64_t record(const FloatVar& var) {
+    return recordWithDomain<VarKind::FLOAT>(var);
+  }
+  uint64_t record(const SetVar& var) {
+    if (const auto id = findRecord(var)) {
+      return *id;
+    }
+    beginRecord(VarKind::SET, var);
+    setValue(_records, var.upperBound());
+    return endRecord(var);
+  }
+
+  // the elements of an array of parameters are written as is, those of other
+  // arrays as 0 followed by the parameter, or as the id of the record of the
+  // variable plus 1
+  template <VarKind kind, typename ParType, class VarType>
+  uint64_t arrayRecord(const VarArrayTemplate<ParType, VarType>& array) {
+    if (const auto id = findRecord(array)) {
+      return *id;
+    }
+    std::vector<uint64_t> elements;
+    if (!array.isParArray()) {
+      elements.reserve(array.size());
+      for (const auto element : array) {
+        elements.push_back(
+            element.isParameter() ? 0 : record(*element.var()) + 1);
+      }
+    }
+    beginRecord(kind, array);
+    _records.varint(array.size());
+    _records.byte(array.isParArray() ? 1 : 0);
+    if (array.isParArray()) {
+      for (const auto& par : array.parameters()) {
+        value(_records, par);
+      }
+      return endRecord(array);
+    }
+    auto id = elements.begin();
+    for (const auto element : array) {
+      _records.varint(*id);
+      if (element.isParameter()) {
+        value(_records, element.parameter());
+      }
+      ++id;
+    }
+    return endRecord(array);
+  }
+
+  uint64_t record(const BoolVarArray& array) {
+    return arrayRecord<VarKind::BOOL_ARRAY>(array);
+  }
+  uint64_t record(const IntVarArray& array) {
+    return arrayRecord<VarKind::INT_ARRAY>(array);
+  }
+  uint64_t record(const FloatVarArray& array) {
+    return arrayRecord<VarKind::FLOAT_ARRAY>(array);
+  }
+  uint64_t record(const SetVarArray& array) {
+    return arrayRecord<VarKind::SET_ARRAY>(array);
+  }
+
+  uint64_t record(const VarReference& reference) {
+    if (const auto id = findRecord(reference)) {
+      return *id;
+    }
+    const uint64_t source = record(reference.source());
+    beginRecord(VarKind::REFERENCE, reference);
+    _records.varint(source);
+    return endRecord(reference);
+  }
+
+  uint64_t record(const Var& var) {
+    switch (static_cast<VarKind>(var.index())) {
+      case VarKind::BOOL:
+        return record(*std::get<std::shared_ptr<BoolVar>>(var));
+      case VarKind::INT:
+        return record(*std::get<std::shared_ptr<IntVar>>(var));
+      case VarKind::FLOAT:
+        return record(*std::get<std::shared_ptr<FloatVar>>(var));
+      case VarKind::SET:
+        return record(*std::get<std::shared_ptr<SetVar>>(var));
+      case VarKind::BOOL_ARRAY:
+        return record(*std::get<std::shared_ptr<BoolVarArray>>(var));
+      case VarKind::INT_ARRAY:
+        return record(*std::get<std::shared_ptr<IntVarArray>>(var));
+      case VarKind::FLOAT_ARRAY:
+        return record(*std::get<std::shared_ptr<FloatVarArray>>(var));
+      case VarKind::SET_ARRAY:
+        return record(*std::get<std::shared_ptr<SetVarArray>>(var));
+      case VarKind::REFERENCE:
+        return record(*std::get<std::shared_ptr<VarReference>>(var));
+    }
+    throw FznException("Invalid variant type: " + var.toString());
+  }
+
+  // written like an array element
+  template <class ScalarArg>
+  void scalarArgument(const ScalarArg& arg) {
+    if (arg.isParameter()) {
+      _model.varint(0);
+      value(_model, arg.parameter());
+    } else {
+      _model.varint(record(*arg.var()) + 1);
+    }
+  }
+
+  void argument(const Arg& arg) {
+    _model.byte(static_cast<uint8_t>(arg.index()));
+    switch (static_cast<ArgKind>(arg.index())) {
+      case ArgKind::BOOL:
+        return scalarArgument(std::get<BoolArg>(arg));
+      case ArgKind::INT:
+        return scalarArgument(std::get<IntArg>(arg));
+      case ArgKind::FLOAT:
+        return scalarArgument(std::get<FloatArg>(arg));
+      case ArgKind::INT_SET:
+        return scalarArgument(std::get<IntSetArg>(arg));
+      case ArgKind::FLOAT_SET:
+        return setValue(_model, *std::get<std::shared_ptr<FloatSet>>(arg));
+      case ArgKind::BOOL_ARRAY:
+        return _model.varint(
+            record(*std::get<std::shared_ptr<BoolVarArray>>(arg)));
+      case ArgKind::INT_ARRAY:
+        return _model.varint(
+            record(*std::get<std::shared_ptr<IntVarArray>>(arg)));
+      case ArgKind::FLOAT_ARRAY:
+        return _model.varint(
+            record(*std::get<std::shared_ptr<FloatVarArray>>(arg)));
+      case ArgKind::SET_ARRAY:
+        return _model.varint(
+            record(*std::get<std::shared_ptr<SetVarArray>>(arg)));
+      case ArgKind::FLOAT_SET_ARRAY: {
+        const FloatSetArray& sets =
+            *std::get<std::shared_ptr<FloatSetArray>>(arg);
+        _model.varint(sets.size());
+        for (const FloatSet& set : sets) {
+          setValue(_model, set);
+        }
+        return;
+      }
+    }
+  }
+
+ public:
+  explicit SnapshotWriter(const Model& model) {
+    _model.varint(model.vars().size());
+    for (const auto& [identifier, var] : model.vars()) {
+      _model.varint(record(var));
+    }
+    _model.varint(model.constraints().size());
+    for (const Constraint& constraint : model.constraints()) {
+      symbol(_model, constraint.identifier());
+      _model.varint(constraint.arguments().size());
+      for (const Arg& arg : constraint.arguments()) {
+        argument(arg);
+      }
+      annotations(_model, constraint.annotations());
+    }
+    const SolveType& solveType = model.solveType();
+    if (solveType.hasObjective()) {
+      _model.varint(record(solveType.objective()) + 1);
+      _model.byte(static_cast<uint8_t>(solveType.problemType()));
+    } else {
+      _model.varint(0);
+    }
+    annotations(_model, solveType.annotations());
+  }
+
+  void write(std::ostream& out) const {
+    SnapshotBuffer header;
+    for (const char c : snapshotMagic) {
+      header.byte(static_cast<uint8_t>(c));
+    }
+    for (size_t i = 0; i < sizeof(snapshotVersion); ++i) {
+      header.byte(static_cast<uint8_t>(snapshotVersion >> (8 * i)));
+    }
+    header.varint(_stringIds.size());
+    SnapshotBuffer numRecords;
+    numRecords.varint(_recordIds.size());
+    const std::array<const SnapshotBuffer*, 5> buffers{
+        &header, &_strings, &numRecords, &_records, &_model};
+    for (const SnapshotBuffer* buffer : buffers) {
+      out.write(buffer->bytes().data(),
+                static_cast<std::streamsize>(buffer->bytes().size()));
+    }
+  }
+};
+
+/**
+ * @brief Reads a snapshot in the order it was written by a SnapshotWriter.
+ */
+class SnapshotLoader {
+  SnapshotReader _reader;
+  std::vector<std::string> _strings;
+  std::vector<Var> _records;
+
+  const std::string& symbol() {
+    const uint64_t id = _reader.varint();
+    if (id >= _strings.size()) {
+      throw FznException("Invalid snapshot: unknown string");
+    }
+    return _strings[id];
+  }
+
+  const Var& record(const uint64_t id) const {
+    if (id >= _records.size()) {
+      throw FznException("Invalid snapshot: unknown record");
+    }
+    return _records[id];
+  }
+
+  template <class T>
+  const std::shared_ptr<T>& record(const uint64_t id) const {
+    const Var& var = record(id);
+    if (!std::holds_alternative<std::shared_ptr<T>>(var)) {
+      throw FznException("Invalid snapshot: record of the wrong type");
+    }
+    return std::get<std::shared_ptr<T>>(var);
+  }
+
+  template <typename T>
+  T value() {
+    if constexpr (std::is_same_v<T, bool>) {
+      return _reader.byte() != 0;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return _reader.integer();
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _reader.real();
+    } else {
+      return setValue<IntSet, int64_t>();
+    }
+  }
+
+  template <typename T>
+  std::vector<T> elements() {
+    const size_t size = _reader.size();
+    std::vector<T> elements;
+    elements.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      elements.push_back(value<T>());
+    }
+    return elements;
+  }
+
+  std::vector<std::pair<int64_t, int64_t>> intervals() {
+    const size_t size = _reader.size();
+    std::vector<std::pair<int64_t, int64_t>> intervals;
+    intervals.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      const int64_t lb = value<int64_t>();
+      const int64_t ub = value<int64_t>();
+      intervals.emplace_back(lb, ub);
+    }
+    return intervals;
+  }
+
+  template <class Set, typename T>
+  Set setValue() {
+    const uint8_t kind = _reader.byte();
+    if (kind == static_cast<uint8_t>(SetKind::INTERVAL)) {
+      const T lb = value<T>();
+      const T ub = value<T>();
+      return Set(lb, ub);
+    }
+    if constexpr (std::is_same_v<Set, IntSet>) {
+      if (kind == static_cast<uint8_t>(SetKind::INTERVALS)) {
+        return IntSet(intervals());
+      }
+    }
+    return Set(elements<T>());
+  }
+
+  template <class VarType, typename T>
+  std::shared_ptr<VarType> varWithDomain(const std::string& identifier,
+                                         std::vector<Annotation>&& anns) {
+    const uint8_t kind = _reader.byte();
+    if (kind == static_cast<uint8_t>(SetKind::INTERVAL)) {
+      const T lb = value<T>();
+      const T ub = value<T>();
+      return std::make_shared<VarType>(lb, ub, identifier, std::move(anns));
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+      if (kind == static_cast<uint8_t>(SetKind::INTERVALS)) {
+        return std::make_shared<VarType>(IntSet(intervals()), identifier,
+                                         std::move(anns));
+      }
+    }
+    return std::make_shared<VarType>(elements<T>(), identifier,
+                                     std::move(anns));
+  }
+
+  AnnotationExpression annotationExpression() {
+    switch (static_cast<ExpressionKind>(_reader.byte())) {
+      case ExpressionKind::BOOL:
+        return value<bool>();
+      case ExpressionKind::INT:
+        return value<int64_t>();
+      case ExpressionKind::FLOAT:
+        return value<double>();
+      case ExpressionKind::INT_SET:
+        return setValue<IntSet, int64_t>();
+      case ExpressionKind::FLOAT_SET:
+        return setValue<FloatSet, double>();
+      case ExpressionKind::STRING:
+        return symbol();
+      case ExpressionKind::ANNOTATION:
+        return annotation();
+    }
+    throw FznException("Invalid snapshot: unknown annotation expression");
+  }
+
+  Annotation annotation() {
+    std::string identifier = symbol();
+    std::vector<std::vector<AnnotationExpression>> expressions(
+        _reader.size());
+    for (std::vector<AnnotationExpression>& exprs : expressions) {
+      const size_t size = _reader.size();
+      exprs.reserve(size);
+      for (size_t i = 0; i < size; ++i) {
+        exprs.push_back(annotationExpression());
+      }
+    }
+    return {std::move(identifier), std::move(expressions)};
+  }
+
+  std::vector<Annotation> annotations() {
+    const size_t size = _reader.size();
+    std::vector<Annotation> anns;
+    anns.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      anns.push_back(annotation());
+    }
+    return anns;
+  }
+
+  template <class ArrayType, typename ParType, class VarType>
+  Var array(const std::string& identifier, std::vector<Annotation>&& anns) {
+    auto res = std::make_shared<ArrayType>(identifier, std::move(anns));
+    const size_t size = _reader.size();
+    res->reserve(size);
+    const bool isParArray = _reader.byte() != 0;
+    for (size_t i = 0; i < size; ++i) {
+      const uint64_t element = isParArray ? 0 : _reader.varint();
+      if (element == 0) {
+        res->append(value<ParType>());
+      } else {
+        res->append(record<VarType>(element - 1));
+      }
+    }
+    return res;
+  }
+
+  Var readRecord() {
+    const auto kind = static_cast<VarKind>(_reader.byte());
+    const std::string identifier(_reader.string());
+    std::vector<Annotation> anns = annotations();
+    switch (kind) {
+      case VarKind::BOOL: {
+        const uint8_t domain = _reader.byte();
+        return domain == unfixedBool
+                   ? std::make_shared<BoolVar>(identifier, std::move(anns))
+                   : std::make_shared<BoolVar>(domain != 0, identifier,
+                                               std::move(anns));
+      }
+      case VarKind::INT:
+        return varWithDomain<IntVar, int64_t>(identifier, std::move(anns));
+      case VarKind::FLOAT:
+        return varWithDomain<FloatVar, double>(identifier, std::move(anns));
+      case VarKind::SET:
+        return varWithDomain<SetVar, int64_t>(identifier, std::move(anns));
+      case VarKind::BOOL_ARRAY:
+        return array<BoolVarArray, bool, BoolVar>(identifier, std::move(anns));
+      case VarKind::INT_ARRAY:
+        return array<IntVarArray, int64_t, IntVar>(identifier,
+                                                   std::move(anns));
+      case VarKind::FLOAT_ARRAY:
+        return array<FloatVarArray, double, FloatVar>(identifier,
+                                                      std::move(anns));
+      case VarKind::SET_ARRAY:
+        return array<SetVarArray, IntSet, SetVar>(identifier, std::move(anns));
+      case VarKind::REFERENCE:
+        return std::make_shared<VarReference>(
+            identifier, record(_reader.varint()), std::move(anns));
+    }
+    throw FznException("Invalid snapshot: unknown variable type");
+  }
+
+  template <class ScalarArg, typename ParType, class VarType>
+  Arg scalarArgument() {
+    const uint64_t element = _reader.varint();
+    if (element == 0) {
+      return ScalarArg{value<ParType>()};
+    }
+    return ScalarArg{
+        std::shared_ptr<const VarType>(record<VarType>(element - 1))};
+  }
+
+  Arg argument() {
+    switch (static_cast<ArgKind>(_reader.byte())) {
+      case ArgKind::BOOL:
+        return scalarArgument<BoolArg, bool, BoolVar>();
+      case ArgKind::INT:
+        return scalarArgument<IntArg, int64_t, IntVar>();
+      case ArgKind::FLOAT:
+        return scalarArgument<FloatArg, double, FloatVar>();
+      case ArgKind::INT_SET:
+        return scalarArgument<IntSetArg, IntSet, SetVar>();
+      case ArgKind::FLOAT_SET:
+        return std::make_shared<FloatSet>(setValue<FloatSet, double>());
+      case ArgKind::BOOL_ARRAY:
+        return record<BoolVarArray>(_reader.varint());
+      case ArgKind::INT_ARRAY:
+        return record<IntVarArray>(_reader.varint());
+      case ArgKind::FLOAT_ARRAY:
+        return record<FloatVarArray>(_reader.varint());
+      case ArgKind::SET_ARRAY:
+        return record<SetVarArray>(_reader.varint());
+      case ArgKind::FLOAT_SET_ARRAY: {
+        auto sets = std::make_shared<FloatSetArray>();
+        const size_t size = _reader.size();
+        sets->reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+          sets->push_back(setValue<FloatSet, double>());
+        }
+        return sets;
+      }
+    }
+    throw FznException("Invalid snapshot: unknown argument type");
+  }
+
+ public:
+  explicit SnapshotLoader(const std::string_view snapshot)
+      : _reader(snapshot) {
+    for (const char c : snapshotMagic) {
+      if (_reader.byte() != static_cast<uint8_t>(c)) {
+        throw FznException("Invalid snapshot: not a snapshot");
+      }
+    }
+    uint32_t version = 0;
+    for (size_t i = 0; i < sizeof(version); ++i) {
+      version |= static_cast<uint32_t>(_reader.byte()) << (8 * i);
+    }
+    if (version != snapshotVersion) {
+      throw FznException("Unsupported snapshot version " +
+                         std::to_string(version) + ", expected " +
+                         std::to_string(snapshotVersion));
+    }
+  }
+
+  Model model() {
+    _strings.resize(_reader.size());
+    for (std::string& string : _strings) {
+      string = _reader.string();
+    }
+    const size_t numRecords = _reader.size();
+    _records.reserve(numRecords);
+    for (size_t i = 0; i < numRecords; ++i) {
+      _records.push_back(readRecord());
+    }
+
+    std::unordered_map<std::string, Var> vars;
+    const size_t numVars = _reader.size();
+    vars.reserve(numVars);
+    for (size_t i = 0; i < numVars; ++i) {
+      const Var& var = record(_reader.varint());
+      vars.emplace(var.identifier(), var);
+    }
+    // the flags that are derived from annotations are derived again
+    for (Var& var : _records) {
+      var.interpretAnnotations(vars);
+    }
+
+    const size_t numConstraints = _reader.size();
+    std::vector<Constraint> constraints;
+    constraints.reserve(numConstraints);
+    for (size_t i = 0; i < numConstraints; ++i) {
+      std::string identifier = symbol();
+      const size_t numArgs = _reader.size();
+      std::vector<Arg> args;
+      args.reserve(numArgs);
+      for (size_t j = 0; j < numArgs; ++j) {
+        args.push_back(argument());
+      }
+      constraints
+          .emplace_back(std::move(identifier), std::move(args), annotations())
+          .interpretAnnotations(vars);
+    }
+
+    std::optional<SolveType> solveType;
+    const uint64_t objective = _reader.varint();
+    if (objective == 0) {
+      solveType.emplace(annotations());
+    } else {
+      const Var& var = record(objective - 1);
+      const auto problemType = static_cast<ProblemType>(_reader.byte());
+      solveType.emplace(problemType, var, annotations());
+    }
+    if (!_reader.atEnd()) {
+      throw FznException("Invalid snapshot: unexpected data after the model");
+    }
+    return {std::move(vars), std::move(constraints),
+            std::move(solveType.value())};
+  }
+};
+
+void writeSnapshot(const Model& model, std::ostream& out) {
+  SnapshotWriter(model).write(out);
+}
+
+void writeSnapshotFile(const Model& model,
+                       const std::string& snapshotFilePath) {
+  std::ofstream out(snapshotFilePath, std::ios::binary);
+  if (out) {
+    writeSnapshot(model, out);
+  }
+  if (!out) {
+    throw FznException("Could not write file: " + snapshotFilePath);
+  }
+}
+
+Model readSnapshotString(const std::string_view snapshot) {
+  return SnapshotLoader(snapshot).model();
+}
+
+Model readSnapshotFile(const std::string& snapshotFilePath) {
+  std::ifstream in(snapshotFilePath, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw FznException("Could not open file: " + snapshotFilePath);
+  }
+  std::string snapshot(static_cast<size_t>(in.tellg()), '\0');
+  in.seekg(0);
+  if (!in.read(snapshot.data(),
+               static_cast<std::streamsize>(snapshot.size()))) {
+    throw FznException("Could not read file: " + snapshotFilePath);
+  }
+  return readSnapshotString(snapshot);
+}
+
+}  // namespace fznparser
@@ -1,16 +1,24 @@
 #include "fznparser/transformer/modelTransformer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <boost/spirit/home/x3.hpp>
 #include <boost/spirit/home/x3/support/ast/variant.hpp>
+#include <exception>
+#include <mutex>
 #include <optional>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 #include <variant>
 #include <vector>
 
 #include "fznparser/annotation.hpp"
 #include "fznparser/except.hpp"
+#include "fznparser/parser/holds.hpp"
 #include "fznparser/parser/toString.hpp"
+#include "fznparser/phaseTimer.hpp"
 
 namespace fznparser {
 
@@ -19,57 +27,107 @@ using boost::get;
 using parser::toString;
 using std::shared_ptr;
 
-std::string getIdentifier(VarDeclItem& t) {
-  return t.type() == typeid(BasicVarDecl) ? get<BasicVarDecl>(t).identifier
-                                          : get<ArrayVarDecl>(t).identifier;
+VarTable::VarTable(const SymbolTable& symbols)
+    : _symbols(symbols), _vars(symbols.size()) {}
+
+const Var* VarTable::find(const std::string_view identifier) const {
+  const std::optional<SymbolId> id = _symbols.find(identifier);
+  if (!id.has_value() || id.value() >= _vars.size() ||
+      !_vars[id.value()].has_value()) {
+    return nullptr;
+  }
+  return &_vars[id.value()].value();
+}
+
+Var& VarTable::emplace(const SymbolId id, Var&& var) {
+  if (id >= _vars.size()) {
+    _vars.resize(_symbols.size());
+  }
+  std::optional<Var>& entry = _vars.at(id);
+  if (!entry.has_value()) {
+    entry.emplace(std::move(var));
+  }
+  return entry.value();
+}
+
+SymbolId ModelTransformer::declare(const std::string_view identifier) {
+  const SymbolId id = _symbols.intern(identifier);
+  if (id >= _parDeclItems.size()) {
+    _parDeclItems.resize(_symbols.size(), noItem);
+    _varDeclItems.resize(_symbols.size(), noItem);
+  }
+  return id;
+}
+
+ModelTransformer::Declaration ModelTransformer::declaration(
+    const std::string_view identifier) const {
+  const std::optional<SymbolId> id = _symbols.find(identifier);
+  if (!id.has_value()) {
+    return {};
+  }
+  const size_t parDeclItem = _parDeclItems[id.value()];
+  const size_t varDeclItem = _varDeclItems[id.value()];
+  return {parDeclItem != noItem ? &_model.parDeclItems[parDeclItem] : nullptr,
+          varDeclItem != noItem ? &_model.varDeclItems[varDeclItem] : nullptr};
+}
+
+const std::string& getIdentifier(const VarDeclItem& t) {
+  return holds<BasicVarDecl>(t) ? get<BasicVarDecl>(t).identifier
+                                : get<ArrayVarDecl>(t).identifier;
+}
+
+// the public types do not use the arena allocator of the AST
+template <typename T, typename Allocator>
+std::vector<T> toStdVector(const std::vector<T, Allocator>& values) {
+  return std::vector<T>(values.begin(), values.end());
 }
 
 template <typename T>
 IntSet toIntSet(const T& intSet) {
-  if (intSet.type() == typeid(SetLiteralEmpty)) {
+  if (holds<SetLiteralEmpty>(intSet)) {
     return IntSet(std::vector<int64_t>());
   }
-  if (intSet.type() == typeid(IntSetLiteralBounded)) {
+  if (holds<IntSetLiteralBounded>(intSet)) {
     return IntSet(get<IntSetLiteralBounded>(intSet).lowerBound,
                   get<IntSetLiteralBounded>(intSet).upperBound);
   }
-  if (intSet.type() == typeid(IntSetLiteralSet)) {
+  if (holds<IntSetLiteralSet>(intSet)) {
     return IntSet(
-        static_cast<std::vector<int64_t>>(get<IntSetLiteralSet>(intSet)));
+        toStdVector<int64_t>(get<IntSetLiteralSet>(intSet)));
   }
   throw FznException("Invalid int set variant type: " + toString(intSet));
 }
 
 template <typename T>
 FloatSet toFloatSet(const T& floatSet) {
-  if (floatSet.type() == typeid(SetLiteralEmpty)) {
+  if (holds<SetLiteralEmpty>(floatSet)) {
     return FloatSet(std::vector<double>());
   }
-  if (floatSet.type() == typeid(FloatSetLiteralBounded)) {
+  if (holds<FloatSetLiteralBounded>(floatSet)) {
     return FloatSet(get<FloatSetLiteralBounded>(floatSet).lowerBound,
                     get<FloatSetLiteralBounded>(floatSet).upperBound);
   }
-  if (floatSet.type() == typeid(FloatSetLiteralSet)) {
+  if (holds<FloatSetLiteralSet>(floatSet)) {
     return FloatSet(
-        static_cast<std::vector<double>>(get<FloatSetLiteralSet>(floatSet)));
+        toStdVector<double>(get<FloatSetLiteralSet>(floatSet)));
   }
   throw FznException("Invalid float set variant type: " + toString(floatSet));
 }
 
 IntVar toIntVar(const BasicVarDecl& var,
                 std::vector<fznparser::Annotation>&& annotations) {
-  if (var.type.type() == typeid(BasicVarIntTypeUnbounded)) {
+  if (holds<BasicVarIntTypeUnbounded>(var.type)) {
     return IntVar{std::numeric_limits<int64_t>::min(),
                   std::numeric_limits<int64_t>::max(), var.identifier,
                   std::move(annotations)};
   }
-  if (var.type.type() == typeid(BasicVarIntTypeBounded)) {
+  if (holds<BasicVarIntTypeBounded>(var.type)) {
     return IntVar{get<BasicVarIntTypeBounded>(var.type).lowerBound,
                   get<BasicVarIntTypeBounded>(var.type).upperBound,
                   var.identifier, std::move(annotations)};
   }
-  if (var.type.type() == typeid(BasicVarIntTypeSet)) {
-    return IntVar{std::vector<int64_t>(get<BasicVarIntTypeSet>(var.type)),
+  if (holds<BasicVarIntTypeSet>(var.type)) {
+    return IntVar{toStdVector<int64_t>(get<BasicVarIntTypeSet>(var.type)),
                   var.identifier, std::move(annotations)};
   }
   throw FznException("Invalid var int declaration: " + toString(var));
@@ -77,12 +135,12 @@ IntVar toIntVar(const BasicVarDecl& var,
 
 FloatVar toFloatVar(const BasicVarDecl& var,
                     std::vector<fznparser::Annotation>&& annotations) {
-  if (var.type.type() == typeid(BasicVarFloatTypeUnbounded)) {
+  if (holds<BasicVarFloatTypeUnbounded>(var.type)) {
     return FloatVar{std::numeric_limits<double>::min(),
                     std::numeric_limits<double>::max(), var.identifier,
                     std::move(annotations)};
   }
-  if (var.type.type() == typeid(BasicVarFloatTypeBounded)) {
+  if (holds<BasicVarFloatTypeBounded>(var.type)) {
     return FloatVar{get<BasicVarFloatTypeBounded>(var.type).lowerBound,
                     get<BasicVarFloatTypeBounded>(var.type).upperBound,
                     var.identifier, std::move(annotations)};
@@ -92,13 +150,13 @@ FloatVar toFloatVar(const BasicVarDecl& var,
 
 SetVar toSetVar(const BasicVarDecl& var,
                 std::vector<fznparser::Annotation>&& annotations) {
-  if (var.type.type() == typeid(BasicVarSetTypeBounded)) {
+  if (holds<BasicVarSetTypeBounded>(var.type)) {
     return SetVar{get<BasicVarSetTypeBounded>(var.type).lowerBound,
                   get<BasicVarSetTypeBounded>(var.type).upperBound,
                   var.identifier, std::move(annotations)};
   }
-  if (var.type.type() == typeid(BasicVarSetTypeSet)) {
-    return SetVar{std::vector<int64_t>(get<BasicVarSetTypeSet>(var.type)),
+  if (holds<BasicVarSetTypeSet>(var.type)) {
+    return SetVar{toStdVector<int64_t>(get<BasicVarSetTypeSet>(var.type)),
                   var.identifier, std::move(annotations)};
   }
   throw FznException("Invalid set var declaration: " + toString(var));
@@ -108,13 +166,10 @@ SetVar toSetVar(const BasicVarDecl& var,
 // value. An int var can be assigned to a set of integers.
 
 bool isBool(const BasicParType t) { return t == BasicParType::BOOL; }
-bool isBool(const std::type_info& t) { return t == typeid(bool); }
 
 bool isInt(const BasicParType t) { return t == BasicParType::INT; }
-bool isInt(const std::type_info& t) { return t == typeid(int64_t); }
 
 bool isFloat(const BasicParType t) { return t == BasicParType::FLOAT; }
-bool isFloat(const std::type_info& t) { return t == typeid(double); }
 
 bool isIntSet(const BasicParType t) { return t == BasicParType::SET_OF_INT; }
 
@@ -125,89 +180,79 @@ bool isVarArray(const Var& t) {
          holds_alternative<std::shared_ptr<SetVarArray>>(t);
 }
 
-bool isIntSet(const std::type_info& t) {
-  return t == typeid(SetLiteralEmpty) || t == typeid(IntSetLiteralBounded) ||
-         t == typeid(IntSetLiteralSet);
+template <typename Literal>
+bool isIntSet(const Literal& literal) {
+  return holds<SetLiteralEmpty>(literal) ||
+         holds<IntSetLiteralBounded>(literal) ||
+         holds<IntSetLiteralSet>(literal);
 }
 
-bool isFloatSet(const std::type_info& t) {
-  return t == typeid(SetLiteralEmpty) || t == typeid(FloatSetLiteralBounded) ||
-         t == typeid(FloatSetLiteralSet);
+template <typename Literal>
+bool isFloatSet(const Literal& literal) {
+  return holds<SetLiteralEmpty>(literal) ||
+         holds<FloatSetLiteralBounded>(literal) ||
+         holds<FloatSetLiteralSet>(literal);
 }
 
-bool isBoolVarExpression(const std::type_info& t) { return isBool(t); }
+bool isBoolVarExpression(const BasicExpr& expr) { return holds<bool>(expr); }
 
-bool isIntVarExpression(const std::type_info& t) {
-  return t == typeid(int64_t) || t == typeid(IntSetLiteralBounded) ||
-         t == typeid(IntSetLiteralSet);
+bool isIntVarExpression(const BasicExpr& expr) {
+  return holds<int64_t>(expr) || holds<IntSetLiteralBounded>(expr) ||
+         holds<IntSetLiteralSet>(expr);
 }
 
-bool isFloatVarExpression(const std::type_info& t) {
-  return t == typeid(double) || t == typeid(FloatSetLiteralBounded) ||
-         t == typeid(FloatSetLiteralSet);
+bool isFloatVarExpression(const BasicExpr& expr) {
+  return holds<double>(expr) || holds<FloatSetLiteralBounded>(expr) ||
+         holds<FloatSetLiteralSet>(expr);
 }
 
-bool isSetVarExpression(const std::type_info& t) {
-  return t == typeid(SetLiteralEmpty) || t == typeid(IntSetLiteralBounded) ||
-         t == typeid(IntSetLiteralSet);
-}
+bool isSetVarExpression(const BasicExpr& expr) { return isIntSet(expr); }
 
-bool isBoolVar(const std::type_info& t) {
-  return t == typeid(BasicVarBoolType);
-}
+bool isBoolVar(const BasicVarType& t) { return holds<BasicVarBoolType>(t); }
 
-bool isBoolVar(const ArrayVarDecl& array) {
-  return isBoolVar(array.type.type.type());
-}
+bool isBoolVar(const ArrayVarDecl& array) { return isBoolVar(array.type.type); }
 
-bool isBoolVar(const BasicVarDecl& var) { return isBoolVar(var.type.type()); }
+bool isBoolVar(const BasicVarDecl& var) { return isBoolVar(var.type); }
 
-bool isIntVar(const std::type_info& t) {
-  return t == typeid(BasicVarIntTypeUnbounded) ||
-         t == typeid(BasicVarIntTypeBounded) || t == typeid(BasicVarIntTypeSet);
+bool isIntVar(const BasicVarType& t) {
+  return holds<BasicVarIntTypeUnbounded>(t) ||
+         holds<BasicVarIntTypeBounded>(t) || holds<BasicVarIntTypeSet>(t);
 }
 
-bool isIntVar(const ArrayVarDecl& array) {
-  return isIntVar(array.type.type.type());
-}
+bool isIntVar(const ArrayVarDecl& array) { return isIntVar(array.type.type); }
 
-bool isIntVar(const BasicVarDecl& var) { return isIntVar(var.type.type()); }
+bool isIntVar(const BasicVarDecl& var) { return isIntVar(var.type); }
 
-bool isFloatVar(const std::type_info& t) {
-  return t == typeid(BasicVarFloatTypeUnbounded) ||
-         t == typeid(BasicVarFloatTypeBounded);
+bool isFloatVar(const BasicVarType& t) {
+  return holds<BasicVarFloatTypeUnbounded>(t) ||
+         holds<BasicVarFloatTypeBounded>(t);
 }
 
 bool isFloatVar(const ArrayVarDecl& array) {
-  return isFloatVar(array.type.type.type());
+  return isFloatVar(array.type.type);
 }
 
-bool isFloatVar(const BasicVarDecl& var) { return isFloatVar(var.type.type()); }
+bool isFloatVar(const BasicVarDecl& var) { return isFloatVar(var.type); }
 
-bool isSetVar(const std::type_info& t) {
-  return t == typeid(BasicVarSetTypeBounded) ||
-         t == typeid(BasicVarSetTypeSet) ||
-         t == typeid(BasicVarSetTypeUnbounded);
+bool isSetVar(const BasicVarType& t) {
+  return holds<BasicVarSetTypeBounded>(t) || holds<BasicVarSetTypeSet>(t) ||
+         holds<BasicVarSetTypeUnbounded>(t);
 }
 
-bool isSetVar(const ArrayVarDecl& array) {
-  return isSetVar(array.type.type.type());
-}
+bool isSetVar(const ArrayVarDecl& array) { return isSetVar(array.type.type); }
 
-bool isSetVar(const BasicVarDecl& var) { return isSetVar(var.type.type()); }
+bool isSetVar(const BasicVarDecl& var) { return isSetVar(var.type); }
 
 bool sameType(const BasicVarType& a, const BasicExpr& b) {
-  return (isBoolVar(a.type()) && isBoolVarExpression(b.type())) ||
-         (isIntVar(a.type()) && isIntVarExpression(b.type())) ||
-         (isFloatVar(a.type()) && isFloatVarExpression(b.type())) ||
-         (isSetVar(a.type()) && isSetVarExpression(b.type()));
+  return (isBoolVar(a) && isBoolVarExpression(b)) ||
+         (isIntVar(a) && isIntVarExpression(b)) ||
+         (isFloatVar(a) && isFloatVarExpression(b)) ||
+         (isSetVar(a) && isSetVarExpression(b));
 }
 
 bool sameType(const BasicVarType& a, const BasicVarType& b) {
-  return (isBoolVar(a.type()) && isBoolVar(b.type())) ||
-         (isIntVar(a.type()) && isIntVar(b.type())) ||
-         (isFloatVar(a.type()) && isFloatVar(b.type())) ||
-         (isSetVar(a.type()) && isSetVar(b.type()));
+  return (isBoolVar(a) && isBoolVar(b)) || (isIntVar(a) && isIntVar(b)) ||
+         (isFloatVar(a) && isFloatVar(b)) || (isSetVar(a) && isSetVar(b));
 }
 
 bool sameType(const ArrayVarDecl& a, const BasicExpr& b) {
@@ -219,34 +264,33 @@ bool sameType(const ArrayVarDecl& a, const BasicVarType& b) {
 }
 
 bool sameType(const BasicParType& a, const ParExpr& b) {
-  return (isBool(a) && isBool(b.type())) || (isInt(a) && isInt(b.type())) ||
-         (isFloat(a) && isFloat(b.type())) ||
-         (isIntSet(a) && isIntSet(b.type()));
+  return (isBool(a) && holds<bool>(b)) || (isInt(a) && holds<int64_t>(b)) ||
+         (isFloat(a) && holds<double>(b)) || (isIntSet(a) && isIntSet(b));
 }
 
 BasicExpr toBasicExpr(const ParExpr& parExpr) {
-  if (parExpr.type() == typeid(bool)) {
+  if (holds<bool>(parExpr)) {
     return get<bool>(parExpr);
   }
-  if (parExpr.type() == typeid(int64_t)) {
+  if (holds<int64_t>(parExpr)) {
     return get<int64_t>(parExpr);
   }
-  if (parExpr.type() == typeid(double)) {
+  if (holds<double>(parExpr)) {
     return get<double>(parExpr);
   }
-  if (parExpr.type() == typeid(SetLiteralEmpty)) {
+  if (holds<SetLiteralEmpty>(parExpr)) {
     return get<SetLiteralEmpty>(parExpr);
   }
-  if (parExpr.type() == typeid(IntSetLiteralBounded)) {
+  if (holds<IntSetLiteralBounded>(parExpr)) {
     return get<IntSetLiteralBounded>(parExpr);
   }
-  if (parExpr.type() == typeid(IntSetLiteralSet)) {
+  if (holds<IntSetLiteralSet>(parExpr)) {
     return get<IntSetLiteralSet>(parExpr);
   }
-  if (parExpr.type() == typeid(FloatSetLiteralBounded)) {
+  if (holds<FloatSetLiteralBounded>(parExpr)) {
     return get<FloatSetLiteralBounded>(parExpr);
   }
-  if (parExpr.type() == typeid(FloatSetLiteralSet)) {
+  if (holds<FloatSetLiteralSet>(parExpr)) {
     return get<FloatSetLiteralSet>(parExpr);
   }
   throw FznException("Exception when transforming basic expression \"" +
@@ -262,28 +306,28 @@ ArrayLiteral toArrayLiteral(const ParArrayLiteral& parArrayLiteral) {
 }
 
 Expr toExpr(const ParExpr& parExpr) {
-  if (parExpr.type() == typeid(bool)) {
+  if (holds<bool>(parExpr)) {
     return get<bool>(parExpr);
   }
-  if (parExpr.type() == typeid(int64_t)) {
+  if (holds<int64_t>(parExpr)) {
     return get<int64_t>(parExpr);
   }
-  if (parExpr.type() == typeid(double)) {
+  if (holds<double>(parExpr)) {
     return get<double>(parExpr);
   }
-  if (parExpr.type() == typeid(SetLiteralEmpty)) {
+  if (holds<SetLiteralEmpty>(parExpr)) {
     return get<SetLiteralEmpty>(parExpr);
   }
-  if (parExpr.type() == typeid(IntSetLiteralBounded)) {
+  if (holds<IntSetLiteralBounded>(parExpr)) {
     return get<IntSetLiteralBounded>(parExpr);
   }
-  if (parExpr.type() == typeid(FloatSetLiteralBounded)) {
+  if (holds<FloatSetLiteralBounded>(parExpr)) {
     return get<FloatSetLiteralBounded>(parExpr);
   }
-  if (parExpr.type() == typeid(FloatSetLiteralSet)) {
+  if (holds<FloatSetLiteralSet>(parExpr)) {
     return get<FloatSetLiteralSet>(parExpr);
   }
-  if (parExpr.type() == typeid(ParArrayLiteral)) {
+  if (holds<ParArrayLiteral>(parExpr)) {
     return toArrayLiteral(get<ParArrayLiteral>(parExpr));
   }
   throw FznException("Exception when transforming expression \"" +
@@ -291,9 +335,9 @@ Expr toExpr(const ParExpr& parExpr) {
 }
 
 void ModelTransformer::replaceParameters(VarDeclItem& varDeclItem) {
-  if (varDeclItem.type() == typeid(BasicVarDecl)) {
+  if (holds<BasicVarDecl>(varDeclItem)) {
     replaceParameters(get<BasicVarDecl>(varDeclItem));
-  } else if (varDeclItem.type() == typeid(ArrayVarDecl)) {
+  } else if (holds<ArrayVarDecl>(varDeclItem)) {
     replaceParameters(get<ArrayVarDecl>(varDeclItem));
   } else {
     throw FznException("replaceParameter(): invalid variant type: " +
@@ -303,35 +347,35 @@ void ModelTransformer::replaceParameters(VarDeclItem& varDeclItem) {
 
 void ModelTransformer::replaceParameters(BasicVarDecl& basicVarDecl) {
   if (!basicVarDecl.expr.has_value() ||
-      basicVarDecl.expr.value().type() != typeid(std::string)) {
+      !holds<std::string>(basicVarDecl.expr.value())) {
     return;
   }
   const std::string& identifier = get<std::string>(basicVarDecl.expr.value());
-  if (_varDeclItems.contains(identifier)) {
+  const Declaration declared = declaration(identifier);
+  if (declared.varDeclItem != nullptr) {
     return;
   }
-  const auto iter = _parDeclItems.find(identifier);
-  if (iter == _parDeclItems.end()) {
+  if (declared.parDeclItem == nullptr) {
     throw FznException("Error when replacing parameters for variable \"" +
                        toString(basicVarDecl) +
                        "\": Reference to undefined variable or parameter " +
                        "\"" + identifier + "\".");
   }
-  basicVarDecl.expr = toBasicExpr(iter->second.expr);
+  basicVarDecl.expr = toBasicExpr(declared.parDeclItem->expr);
 }
 
 void ModelTransformer::replaceParameters(ArrayVarDecl& arrayVarDecl) {
   for (size_t i = 0; i < arrayVarDecl.literals.size(); ++i) {
-    if (arrayVarDecl.literals.at(i).type() != typeid(std::string)) {
+    if (!holds<std::string>(arrayVarDecl.literals.at(i))) {
       continue;
     }
     const std::string& identifier =
         get<std::string>(arrayVarDecl.literals.at(i));
-    if (_varDeclItems.contains(identifier)) {
+    const Declaration declared = declaration(identifier);
+    if (declared.varDeclItem != nullptr) {
       continue;
     }
-    const auto iter = _parDeclItems.find(identifier);
-    if (iter == _parDeclItems.end()) {
+    if (declared.parDeclItem == nullptr) {
       throw FznException("Error when validating array literal \"" +
                          toString(arrayVarDecl.literals.at(i)) +
                          "\" in array \"" + toString(arrayVarDecl) +
@@ -339,53 +383,53 @@ void ModelTransformer::replaceParameters(ArrayVarDecl& arrayVarDecl) {
                          ": Reference to undefined variable or parameter \"" +
                          identifier + "\".");
     }
-    arrayVarDecl.literals.at(i) = toBasicExpr(iter->second.expr);
+    arrayVarDecl.literals.at(i) = toBasicExpr(declared.parDeclItem->expr);
   }
 }
 
 void ModelTransformer::replaceParameters(ArrayLiteral& array) {
   for (size_t i = 0; i < array.size(); ++i) {
-    if (array.at(i).type() != typeid(std::string)) {
+    if (!holds<std::string>(array.at(i))) {
       continue;
     }
     const std::string& identifier = get<std::string>(array.at(i));
-    if (_varDeclItems.contains(identifier)) {
+    const Declaration declared = declaration(identifier);
+    if (declared.varDeclItem != nullptr) {
       continue;
     }
-    const auto iter = _parDeclItems.find(identifier);
-    if (iter == _parDeclItems.end()) {
+    if (declared.parDeclItem == nullptr) {
       throw FznException("Error when replacing parameters for constraint \"" +
                          toString(array) +
                          "\": Reference to undefined variable or parameter " +
                          "\"" + identifier + "\".");
     }
-    array.at(i) = toBasicExpr(iter->second.expr);
+    array.at(i) = toBasicExpr(declared.parDeclItem->expr);
   }
 }
 
 void ModelTransformer::replaceParameters(ConstraintItem& constraint) {
   for (size_t i = 0; i < constraint.expressions.size(); ++i) {
-    if (constraint.expressions.at(i).type() == typeid(ArrayLiteral)) {
+    if (holds<ArrayLiteral>(constraint.expressions.at(i))) {
       replaceParameters(get<ArrayLiteral>(constraint.expressions.at(i)));
       continue;
     }
-    if (constraint.expressions.at(i).type() != typeid(std::string)) {
+    if (!holds<std::string>(constraint.expressions.at(i))) {
       continue;
     }
     const std::string& identifier =
         get<std::string>(constraint.expressions.at(i));
-    if (_varDeclItems.contains(identifier)) {
+    const Declaration declared = declaration(identifier);
+    if (declared.varDeclItem != nullptr) {
       continue;
     }
-    const auto iter = _parDeclItems.find(identifier);
-    if (iter == _parDeclItems.end()) {
+    if (declared.parDeclItem == nullptr) {
       throw FznException("Error when replacing parameters for constraint \"" +
                          toString(constraint) +
                          "\": Reference to undefined variable or parameter " +
                          "\"" + identifier + "\".");
     }
 
-    constraint.expressions.at(i) = toExpr(iter->second.expr);
+    constraint.expressions.at(i) = toExpr(declared.parDeclItem->expr);
   }
 }
 
@@ -398,7 +442,7 @@ void typeCheck(const BasicParType type, const ParExpr& parExpr) {
 }
 
 void typeCheck(const BasicParTypeArray& type, const ParExpr& parExpr) {
-  if (parExpr.type() != typeid(ParArrayLiteral)) {
+  if (!holds<ParArrayLiteral>(parExpr)) {
     throw FznException("type mismatch, expected array literal");
   }
   const auto& parArrayLiteral = get<ParArrayLiteral>(parExpr);
@@ -411,7 +455,7 @@ void typeCheck(const BasicParTypeArray& type, const ParExpr& parExpr) {
 }
 
 void typeCheck(const ParType& type, const ParExpr& parExpr) {
-  if (type.type() == typeid(BasicParType)) {
+  if (holds<BasicParType>(type)) {
     typeCheck(get<BasicParType>(type), parExpr);
   } else {
     typeCheck(get<BasicParTypeArray>(type), parExpr);
@@ -423,7 +467,7 @@ void typeCheck(const ParDeclItem& parDeclItem) {
 }
 
 void typeCheck(const BasicVarType& type, const BasicExpr& expr) {
-  if (expr.type() != typeid(std::string) && !sameType(type, expr)) {
+  if (!holds<std::string>(expr) && !sameType(type, expr)) {
     throw FznException("type mismatch between var type \"" + toString(type) +
                        "\" and expression \"" + toString(expr) + "\"");
   }
@@ -438,14 +482,14 @@ void ModelTransformer::validate(const parser::Annotation& annotation) const {
     if (annExpr.empty()) {
       continue;
     }
-    const auto& t = annExpr.front().type();
+    const int which = annExpr.front().which();
     for (size_t i = 1; i < annExpr.size(); ++i) {
-      if (annExpr.at(i).type() != t) {
+      if (annExpr.at(i).which() != which) {
         throw FznException("Error when validating annotation \"" +
                            toString(annotation) + "\": type mismatch");
       }
     }
-    if (t == typeid(std::string)) {
+    if (holds<std::string>(annExpr.front())) {
       const bool isLit = isStringLiteral(get<std::string>(annExpr.front()));
       for (size_t i = 1; i < annExpr.size(); ++i) {
         if (isStringLiteral(get<std::string>(annExpr.at(i))) != isLit) {
@@ -454,7 +498,7 @@ void ModelTransformer::validate(const parser::Annotation& annotation) const {
                              "\": mix of string literals and identifiers");
         }
       }
-    } else if (t == typeid(x3::forward_ast<parser::Annotation>)) {
+    } else if (holds<x3::forward_ast<parser::Annotation>>(annExpr.front())) {
       for (const BasicAnnExpr& basicAnnExpr : annExpr) {
         validate(get<x3::forward_ast<parser::Annotation>>(basicAnnExpr).get());
       }
@@ -477,7 +521,7 @@ void ModelTransformer::validate(const ArrayVarDecl& arrayVarDecl) const {
     throw FznException("Var literal array size does not match index set size");
   }
   for (size_t i = 0; i < arrayVarDecl.literals.size(); ++i) {
-    if (arrayVarDecl.literals.at(i).type() != typeid(std::string)) {
+    if (!holds<std::string>(arrayVarDecl.literals.at(i))) {
       if (!sameType(arrayVarDecl, arrayVarDecl.literals.at(i))) {
         throw FznException(
             "Error when validating variable array \"" + toString(arrayVarDecl) +
@@ -486,30 +530,31 @@ void ModelTransformer::validate(const ArrayVarDecl& arrayVarDecl) const {
       }
       continue;
     }
-    const std::string identifier =
+    const std::string& identifier =
         get<std::string>(arrayVarDecl.literals.at(i));
-    const auto iter = _varDeclItems.find(identifier);
-    if (iter == _varDeclItems.end()) {
+    const VarDeclItem* varDeclItem = declaration(identifier).varDeclItem;
+    if (varDeclItem == nullptr) {
       throw FznException(
           "Error when validating array literal \"" +
           toString(arrayVarDecl.literals.at(i)) + "\" in array \"" +
           toString(arrayVarDecl) + "\" at index " + std::to_string(i + 1) +
           ": Reference to undefined variable \"" + identifier + "\".");
     }
-    if (iter->second.type() != typeid(BasicVarDecl)) {
+    if (!holds<BasicVarDecl>(*varDeclItem)) {
       throw FznException("Error when validating array literal \"" +
                          toString(arrayVarDecl.literals.at(i)) +
                          "\"in array \"" + toString(arrayVarDecl) +
                          "\" at index " + std::to_string(i + 1) +
-                         ": variable \"" + toString(iter->second) +
+                         ": variable \"" + toString(*varDeclItem) +
                          "\" has incompatible type.");
     }
-    if (!sameType(arrayVarDecl, get<BasicVarDecl>(iter->second).type)) {
+    if (!sameType(arrayVarDecl, get<BasicVarDecl>(*varDeclItem).type)) {
       throw FznException(
           "Error when validating variable array \"" + toString(arrayVarDecl) +
           "\" at index " + std::to_string(i + 1) + ": \"" +
           toString(arrayVarDecl.literals.at(i)) +
-          "\". Type mismatch for variable \"" + toString(iter->second) + "\"");
+          "\". Type mismatch for variable \"" + toString(*varDeclItem) +
+          "\"");
     }
   }
   for (const parser::Annotation& annotation : arrayVarDecl.annotations) {
@@ -518,7 +563,7 @@ void ModelTransformer::validate(const ArrayVarDecl& arrayVarDecl) const {
 }
 
 void ModelTransformer::validate(const VarDeclItem& varDeclItem) const {
-  if (varDeclItem.type() == typeid(BasicVarDecl)) {
+  if (holds<BasicVarDecl>(varDeclItem)) {
     validate(get<BasicVarDecl>(varDeclItem));
   } else {
     validate(get<ArrayVarDecl>(varDeclItem));
@@ -526,11 +571,11 @@ void ModelTransformer::validate(const VarDeclItem& varDeclItem) const {
 }
 
 void replaceEmptySets(ParDeclItem& parDeclItem) {
-  if (parDeclItem.expr.type() == typeid(SetLiteralEmpty)) {
+  if (holds<SetLiteralEmpty>(parDeclItem.expr)) {
     parDeclItem.expr = IntSetLiteralSet{};
-  } else if (parDeclItem.expr.type() == typeid(ParArrayLiteral)) {
+  } else if (holds<ParArrayLiteral>(parDeclItem.expr)) {
     for (BasicLiteralExpr& expr : get<ParArrayLiteral>(parDeclItem.expr)) {
-      if (expr.type() == typeid(SetLiteralEmpty)) {
+      if (holds<SetLiteralEmpty>(expr)) {
         expr = IntSetLiteralSet{};
       }
     }
@@ -539,23 +584,22 @@ void replaceEmptySets(ParDeclItem& parDeclItem) {
 
 void replaceEmptySets(ArrayVarDecl& arrayVarDecl) {
   for (auto& literal : arrayVarDecl.literals) {
-    if (literal.type() == typeid(SetLiteralEmpty)) {
+    if (holds<SetLiteralEmpty>(literal)) {
       literal = IntSetLiteralSet{};
     }
   }
 }
 
 void replaceEmptySets(BasicVarDecl& var) {
-  if (var.expr.has_value() &&
-      var.expr.value().type() == typeid(SetLiteralEmpty)) {
+  if (var.expr.has_value() && holds<SetLiteralEmpty>(var.expr.value())) {
     var.expr = IntSetLiteralSet{};
   }
 }
 
 void replaceEmptySets(VarDeclItem& var) {
-  if (var.type() == typeid(BasicVarDecl)) {
+  if (holds<BasicVarDecl>(var)) {
     replaceEmptySets(get<BasicVarDecl>(var));
-  } else if (var.type() == typeid(ArrayVarDecl)) {
+  } else if (holds<ArrayVarDecl>(var)) {
     replaceEmptySets(get<ArrayVarDecl>(var));
   } else {
     throw FznException("replaceEmptySets(): Invalid variant type: " +
@@ -563,55 +607,123 @@ void replaceEmptySets(VarDeclItem& var) {
   }
 }
 
-ModelTransformer::ModelTransformer(parser::Model&& model)
-    : _model(std::move(model)) {
-  for (ParDeclItem& parDeclItem : _model.parDeclItems) {
-    replaceEmptySets(parDeclItem);
-    typeCheck(parDeclItem);
-    _parDeclItems.emplace(parDeclItem.identifier, parDeclItem);
-  }
-  for (VarDeclItem& varDeclItem : _model.varDeclItems) {
-    replaceEmptySets(varDeclItem);
-    replaceParameters(varDeclItem);
-    _varDeclItems.emplace(getIdentifier(varDeclItem), varDeclItem);
+// like Model::addVar
+[[noreturn]] void throwDuplicateVar(const std::string& identifier) {
+  throw FznException("Variable with identifier \"" + identifier +
+                     "\" already exists");
+}
+
+ModelTransformer::ModelTransformer(parser::Model&& model, ParseStats* stats)
+    : _model(std::move(model)), _stats(stats) {
+  const size_t numSymbols =
+      _model.parDeclItems.size() + _model.varDeclItems.size();
+  {
+    const PhaseTimer timer(_stats, ParsePhase::REPLACE);
+    _symbols.reserve(numSymbols);
+    _parDeclItems.reserve(numSymbols);
+    _varDeclItems.reserve(numSymbols);
+    // the tables refer to the items in _model instead of holding copies
+    for (size_t i = 0; i < _model.parDeclItems.size(); ++i) {
+      ParDeclItem& parDeclItem = _model.parDeclItems[i];
+      replaceEmptySets(parDeclItem);
+      typeCheck(parDeclItem);
+      size_t& declared = _parDeclItems[declare(parDeclItem.identifier)];
+      if (declared == noItem) {
+        declared = i;
+      }
+    }
+    for (size_t i = 0; i < _model.varDeclItems.size(); ++i) {
+      VarDeclItem& varDeclItem = _model.varDeclItems[i];
+      replaceEmptySets(varDeclItem);
+      replaceParameters(varDeclItem);
+      const SymbolId id = declare(getIdentifier(varDeclItem));
+      size_t& declared = _varDeclItems[id];
+      if (declared != noItem) {
+        throwDuplicateVar(_symbols.name(id));
+      }
+      declared = i;
+    }
+    for (ConstraintItem& constraintItem : _model.constraintItems) {
+      replaceParameters(constraintItem);
+    }
   }
-  for (ConstraintItem& constraintItem : _model.constraintItems) {
-    replaceParameters(constraintItem);
+  {
+    const PhaseTimer timer(_stats, ParsePhase::VALIDATE);
+    for (const VarDeclItem& varDeclItem : _model.varDeclItems) {
+      validate(varDeclItem);
+    }
   }
-  for (const VarDeclItem& varDeclItem : _model.varDeclItems) {
-    validate(varDeclItem);
+  if (_stats != nullptr) {
+    _stats->phase(ParsePhase::REPLACE).numItems =
+        numSymbols + _model.constraintItems.size();
+    _stats->phase(ParsePhase::VALIDATE).numItems = _model.varDeclItems.size();
+  }
+}
+
+void ModelTransformer::addParDeclItem(ParDeclItem&& parDeclItem) {
+  replaceEmptySets(parDeclItem);
+  typeCheck(parDeclItem);
+  size_t& declared = _parDeclItems[declare(parDeclItem.identifier)];
+  if (declared == noItem) {
+    declared = _model.parDeclItems.size();
+    _model.parDeclItems.push_back(std::move(parDeclItem));
+  }
+}
+
+const Var& ModelTransformer::addVarDeclItem(VarDeclItem&& varDeclItem) {
+  replaceEmptySets(varDeclItem);
+  replaceParameters(varDeclItem);
+  const SymbolId id = declare(getIdentifier(varDeclItem));
+  size_t& declared = _varDeclItems[id];
+  if (declared != noItem) {
+    // the first declaration has already been passed to the handler and
+    // released
+    throwDuplicateVar(_symbols.name(id));
+  }
+  declared = _model.varDeclItems.size();
+  _model.varDeclItems.push_back(std::move(varDeclItem));
+  VarDeclItem& item = _model.varDeclItems[declared];
+  validate(item);
+  Var& var = _vars.emplace(id, transform(_vars, item));
+  _varMap.emplace(_symbols.name(id), var);
+  var.interpretAnnotations(_varMap);
+
+  // later items only look up the type of the declaration, so its (possibly
+  // large) contents are released
+  if (holds<BasicVarDecl>(item)) {
+    BasicVarDecl& basicVarDecl = get<BasicVarDecl>(item);
+    basicVarDecl.annotations = {};
+    basicVarDecl.expr.reset();
+  } else {
+    ArrayVarDecl& arrayVarDecl = get<ArrayVarDecl>(item);
+    arrayVarDecl.annotations = {};
+    arrayVarDecl.literals = {};
   }
+  return var;
 }
 
 fznparser::Annotation transformAnnotation(const parser::Annotation& annotation);
 
 AnnotationExpression transformAnnotationExpression(
     const parser::BasicAnnExpr& expr) {
-  if (expr.type() == typeid(bool)) {
-    return AnnotationExpression{get<bool>(expr)};
-  }
-  if (expr.type() == typeid(int64_t)) {
-    return AnnotationExpression{get<int64_t>(expr)};
-  }
-  if (expr.type() == typeid(double)) {
-    return AnnotationExpression{get<double>(expr)};
-  }
-  if (expr.type() == typeid(std::string)) {
-    return AnnotationExpression{get<std::string>(expr)};
-  }
-  if (isIntSet(expr.type())) {
-    return AnnotationExpression{toIntSet(expr)};
-  }
-  if (isFloatSet(expr.type())) {
-    return AnnotationExpression{toFloatSet(expr)};
-  }
-  if (expr.type() == typeid(x3::forward_ast<parser::Annotation>)) {
-    return AnnotationExpression{transformAnnotation(
-        get<x3::forward_ast<parser::Annotation>>(expr).get())};
-  }
-  throw FznException(
-      "Invalid Annotation variant type for annotation expression \"" +
-      toString(expr) + "\"");
+  return boost::apply_visitor(
+      [&](const auto& value) -> AnnotationExpression {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int64_t> ||
+                      std::is_same_v<T, double> ||
+                      std::is_same_v<T, std::string>) {
+          return AnnotationExpression{value};
+        } else if constexpr (std::is_same_v<
+                                 T, x3::forward_ast<parser::Annotation>>) {
+          return AnnotationExpression{transformAnnotation(value.get())};
+        } else if constexpr (std::is_same_v<T, FloatSetLiteralBounded> ||
+                             std::is_same_v<T, FloatSetLiteralSet>) {
+          return AnnotationExpression{toFloatSet(expr)};
+        } else {
+          return AnnotationExpression{toIntSet(expr)};
+        }
+      },
+      expr);
 }
 
 fznparser::Annotation transformAnnotation(
@@ -627,36 +739,36 @@ fznparser::Annotation transformAnnotation(
   return {annotation.identifier, std::move(expressions)};
 }
 
-Var ModelTransformer::transformVar(
-    const std::unordered_map<std::string, Var>& vars, const BasicVarDecl& var) {
+Var ModelTransformer::transformVar(const VarTable& vars,
+                                   const BasicVarDecl& var) {
   std::vector<fznparser::Annotation> annotations;
   annotations.reserve(var.annotations.size());
   for (const parser::Annotation& ann : var.annotations) {
     annotations.push_back(transformAnnotation(ann));
   }
   if (var.expr.has_value()) {
-    const BasicExpr expr = var.expr.value();
-    if (expr.type() == typeid(bool)) {
+    const BasicExpr& expr = var.expr.value();
+    if (holds<bool>(expr)) {
       return Var{std::make_shared<BoolVar>(
           BoolVar{get<bool>(expr), var.identifier, std::move(annotations)})};
     }
-    if (expr.type() == typeid(int64_t)) {
+    if (holds<int64_t>(expr)) {
       return Var{std::make_shared<IntVar>(
           IntVar{get<int64_t>(expr), var.identifier, std::move(annotations)})};
     }
-    if (expr.type() == typeid(double)) {
+    if (holds<double>(expr)) {
       return Var{std::make_shared<FloatVar>(
           FloatVar{get<double>(expr), var.identifier, std::move(annotations)})};
     }
-    if (isIntSet(expr.type())) {
+    if (isIntSet(expr)) {
       return Var{std::make_shared<SetVar>(
           SetVar{toIntSet(expr), var.identifier, std::move(annotations)})};
     }
-    if (expr.type() == typeid(std::string)) {
-      const auto& refIdentifier = get<std::string>(expr);
-      if (vars.contains(refIdentifier)) {
-        return Var{std::make_shared<VarReference>(
-            var.identifier, vars.at(refIdentifier), std::move(annotations))};
+    if (holds<std::string>(expr)) {
+      const Var* source = vars.find(get<std::string>(expr));
+      if (source != nullptr) {
+        return Var{std::make_shared<VarReference>(var.identifier, *source,
+                                                  std::move(annotations))};
       }
     }
   }
@@ -678,9 +790,8 @@ Var ModelTransformer::transformVar(
 }
 
 template <class ArrayType, class VarType, typename ParType>
-std::shared_ptr<ArrayType> generateVarArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayVarDecl& arrayVarDecl) {
+std::shared_ptr<ArrayType> generateVarArray(const VarTable& vars,
+                                            const ArrayVarDecl& arrayVarDecl) {
   std::vector<fznparser::Annotation> annotations;
   annotations.reserve(arrayVarDecl.annotations.size());
   for (const parser::Annotation& ann : arrayVarDecl.annotations) {
@@ -689,16 +800,16 @@ std::shared_ptr<ArrayType> generateVarArray(
   std::shared_ptr<ArrayType> res = std::make_shared<ArrayType>(
       arrayVarDecl.identifier, std::move(annotations));
   for (const BasicExpr& basicExpr : arrayVarDecl.literals) {
-    if (basicExpr.type() == typeid(std::string)) {
+    if (holds<std::string>(basicExpr)) {
       const std::string& identifier = get<std::string>(basicExpr);
-      const auto iter = vars.find(identifier);
-      if (iter == vars.end()) {
+      const Var* referenced = vars.find(identifier);
+      if (referenced == nullptr) {
         throw FznException(
             "Error when validating variable \"" + toString(arrayVarDecl) +
             "\": Reference to undefined " + toString(arrayVarDecl.type.type) +
             " variable with identifier \"" + identifier + "\"");
       }
-      Var var = iter->second;
+      Var var = *referenced;
       while (std::holds_alternative<std::shared_ptr<VarReference>>(var)) {
         var = get<std::shared_ptr<VarReference>>(var)->source();
       }
@@ -709,7 +820,7 @@ std::shared_ptr<ArrayType> generateVarArray(
                            "\". Got " + var.toString());
       }
       res->append(get<std::shared_ptr<VarType>>(var));
-    } else if (basicExpr.type() == typeid(ParType)) {
+    } else if (holds<ParType>(basicExpr)) {
       res->append(get<ParType>(basicExpr));
     } else {
       throw FznException("Invalid " + toString(arrayVarDecl.type.type) +
@@ -720,8 +831,7 @@ std::shared_ptr<ArrayType> generateVarArray(
 }
 
 std::shared_ptr<SetVarArray> generateSetVarArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayVarDecl& arrayVarDecl) {
+    const VarTable& vars, const ArrayVarDecl& arrayVarDecl) {
   std::vector<fznparser::Annotation> annotations;
   annotations.reserve(arrayVarDecl.annotations.size());
   for (const parser::Annotation& ann : arrayVarDecl.annotations) {
@@ -730,20 +840,20 @@ std::shared_ptr<SetVarArray> generateSetVarArray(
   auto res = std::make_shared<SetVarArray>(arrayVarDecl.identifier,
                                            std::move(annotations));
   for (const BasicExpr& basicExpr : arrayVarDecl.literals) {
-    if (basicExpr.type() == typeid(std::string)) {
+    if (holds<std::string>(basicExpr)) {
       const std::string& identifier = get<std::string>(basicExpr);
-      const auto iter = vars.find(identifier);
-      if (iter == vars.end()) {
+      const Var* var = vars.find(identifier);
+      if (var == nullptr) {
         throw FznException(
             "Reference to undefined set variable with identifier \"" +
             identifier + "\"");
       }
-      if (!std::holds_alternative<std::shared_ptr<SetVar>>(iter->second)) {
+      if (!std::holds_alternative<std::shared_ptr<SetVar>>(*var)) {
         throw FznException("Reference to non-set variable with identifier \"" +
                            identifier + "\"");
       }
-      res->append(get<std::shared_ptr<SetVar>>(iter->second));
-    } else if (isIntSet(basicExpr.type())) {
+      res->append(get<std::shared_ptr<SetVar>>(*var));
+    } else if (isIntSet(basicExpr)) {
       res->append(toIntSet(basicExpr));
     } else {
       throw FznException("Invalid bool variable array literal");
@@ -753,28 +863,27 @@ std::shared_ptr<SetVarArray> generateSetVarArray(
 }
 
 template <class ArrayType, class VarType, typename ParType>
-std::shared_ptr<ArrayType> generateArgArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayLiteral& arrayLiteral) {
+std::shared_ptr<ArrayType> generateArgArray(const VarTable& vars,
+                                            const ArrayLiteral& arrayLiteral) {
   std::shared_ptr<ArrayType> res = std::make_shared<ArrayType>("");
   for (const BasicExpr& basicExpr : arrayLiteral) {
-    if (basicExpr.type() == typeid(std::string)) {
+    if (holds<std::string>(basicExpr)) {
       const std::string& identifier = get<std::string>(basicExpr);
-      if (!vars.contains(identifier)) {
+      const Var* var = vars.find(identifier);
+      if (var == nullptr) {
         throw FznException(
             "Error when validating array literal \"" + toString(arrayLiteral) +
             "\": Reference to undefined variable with identifier \"" +
             identifier + "\"");
       }
-      const Var& var = vars.at(identifier);
-      if (!std::holds_alternative<std::shared_ptr<VarType>>(var)) {
+      if (!std::holds_alternative<std::shared_ptr<VarType>>(*var)) {
         throw FznException(
             "Reference type mismatch when parsing array literal \"" +
-            toString(arrayLiteral) + "\" and variable \"" + var.toString() +
+            toString(arrayLiteral) + "\" and variable \"" + var->toString() +
             "\"");
       }
-      res->append(get<std::shared_ptr<VarType>>(var));
-    } else if (basicExpr.type() == typeid(ParType)) {
+      res->append(get<std::shared_ptr<VarType>>(*var));
+    } else if (holds<ParType>(basicExpr)) {
       res->append(get<ParType>(basicExpr));
     } else {
       throw FznException("Invalid " + toString(arrayLiteral) +
@@ -785,27 +894,26 @@ std::shared_ptr<ArrayType> generateArgArray(
 }
 
 std::shared_ptr<SetVarArray> generateSetVarArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayLiteral& arrayLiteral) {
+    const VarTable& vars, const ArrayLiteral& arrayLiteral) {
   auto res = std::make_shared<SetVarArray>("");
   for (const BasicExpr& basicExpr : arrayLiteral) {
-    if (basicExpr.type() == typeid(std::string)) {
+    if (holds<std::string>(basicExpr)) {
       const std::string& identifier = get<std::string>(basicExpr);
-      const auto iter = vars.find(identifier);
-      if (iter == vars.end()) {
+      const Var* var = vars.find(identifier);
+      if (var == nullptr) {
         throw FznException(
             "Error when validating array literal \"" + toString(arrayLiteral) +
             "\": Reference to undefined variable with identifier \"" +
             identifier + "\"");
       }
-      if (!std::holds_alternative<std::shared_ptr<SetVar>>(iter->second)) {
+      if (!std::holds_alternative<std::shared_ptr<SetVar>>(*var)) {
         throw FznException(
             "Reference type mismatch when parsing array literal \"" +
-            toString(arrayLiteral) + "\" and variable \"" +
-            iter->second.toString() + "\"");
+            toString(arrayLiteral) + "\" and variable \"" + var->toString() +
+            "\"");
       }
-      res->append(get<std::shared_ptr<SetVar>>(iter->second));
-    } else if (isIntSet(basicExpr.type())) {
+      res->append(get<std::shared_ptr<SetVar>>(*var));
+    } else if (isIntSet(basicExpr)) {
       res->append(toIntSet(basicExpr));
     } else {
       throw FznException("Invalid " + toString(arrayLiteral) +
@@ -815,89 +923,106 @@ std::shared_ptr<SetVarArray> generateSetVarArray(
   return res;
 }
 
-const std::type_info& ModelTransformer::arrayType(
-    const std::unordered_map<std::string, Var>&,
+template <typename Literal>
+std::optional<ArgArrayType> elementType(const Literal& literal) {
+  if (holds<bool>(literal)) {
+    return ArgArrayType::BOOL;
+  }
+  if (holds<int64_t>(literal)) {
+    return ArgArrayType::INT;
+  }
+  if (holds<double>(literal)) {
+    return ArgArrayType::FLOAT;
+  }
+  if (isIntSet(literal)) {
+    return ArgArrayType::INT_SET;
+  }
+  if (isFloatSet(literal)) {
+    return ArgArrayType::FLOAT_SET;
+  }
+  return std::nullopt;
+}
+
+std::optional<ArgArrayType> ModelTransformer::arrayType(
     const ArrayLiteral& array) const {
   for (const BasicExpr& expr : array) {
-    if (expr.type() == typeid(std::string)) {
+    if (holds<std::string>(expr)) {
       const std::string& identifier = get<std::string>(expr);
-      const auto varDeclIter = _varDeclItems.find(identifier);
-      if (varDeclIter != _varDeclItems.end()) {
-        if (varDeclIter->second.type() != typeid(BasicVarDecl)) {
+      const Declaration declared = declaration(identifier);
+      if (declared.varDeclItem != nullptr) {
+        if (!holds<BasicVarDecl>(*declared.varDeclItem)) {
           throw FznException("Invalid array literal in argument array \"" +
                              toString(array) + "\", variable \"" +
-                             toString(varDeclIter->second) +
+                             toString(*declared.varDeclItem) +
                              "\" is a variable array");
         }
-        const auto& t = get<BasicVarDecl>(varDeclIter->second).type.type();
+        const BasicVarType& t = get<BasicVarDecl>(*declared.varDeclItem).type;
         if (isBoolVar(t)) {
-          return typeid(bool);
+          return ArgArrayType::BOOL;
         }
         if (isIntVar(t)) {
-          return typeid(int64_t);
+          return ArgArrayType::INT;
         }
         if (isFloatVar(t)) {
-          return typeid(double);
+          return ArgArrayType::FLOAT;
         }
         if (isSetVar(t)) {
-          return typeid(IntSetLiteralBounded);
+          return ArgArrayType::INT_SET;
         }
         throw FznException("Invalid array literal in argument array \"" +
                            toString(array) + "\", variable \"" +
-                           toString(varDeclIter->second) +
+                           toString(*declared.varDeclItem) +
                            "\" has invalid type");
       }
-      const auto parDeclIter = _parDeclItems.find(identifier);
-      if (parDeclIter != _parDeclItems.end()) {
-        return parDeclIter->second.expr.type();
+      if (declared.parDeclItem != nullptr) {
+        return elementType(declared.parDeclItem->expr);
       }
-      assert(varDeclIter == _varDeclItems.end());
-      assert(parDeclIter == _parDeclItems.end());
       throw FznException("Reference to undefined variable or parameter \"" +
                          identifier + "\" in array literal: \"" +
                          toString(array) + "\"");
     }
-    if (expr.type() != typeid(SetLiteralEmpty)) {
-      return expr.type();
+    if (!holds<SetLiteralEmpty>(expr)) {
+      return elementType(expr);
     }
   }
   // The array contains only empty set literals
-  return typeid(SetLiteralEmpty);
-}
-
-Arg ModelTransformer::transformArgArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayLiteral& array) const {
-  const auto& t = arrayType(vars, array);
-  if (t == typeid(bool)) {
-    return Arg{generateArgArray<BoolVarArray, BoolVar, bool>(vars, array)};
-  }
-  if (t == typeid(int64_t)) {
-    return Arg{generateArgArray<IntVarArray, IntVar, int64_t>(vars, array)};
-  }
-  if (t == typeid(double)) {
-    return Arg{generateArgArray<FloatVarArray, FloatVar, double>(vars, array)};
-  }
-  if (isIntSet(t)) {
-    return Arg{generateSetVarArray(vars, array)};
-  }
-  if (isFloatSet(t)) {
-    auto res = std::make_shared<FloatSetArray>();
-    for (const BasicExpr& expr : array) {
-      if (!isFloatSet(expr.type())) {
-        throw FznException("Invalid float set array literal");
+  return ArgArrayType::INT_SET;
+}
+
+Arg ModelTransformer::transformArgArray(const VarTable& vars,
+                                        const ArrayLiteral& array) const {
+  const std::optional<ArgArrayType> t = arrayType(array);
+  if (!t.has_value()) {
+    throw FznException("transformArgArray(): Invalid variant type: " +
+                       toString(array));
+  }
+  switch (t.value()) {
+    case ArgArrayType::BOOL:
+      return Arg{generateArgArray<BoolVarArray, BoolVar, bool>(vars, array)};
+    case ArgArrayType::INT:
+      return Arg{generateArgArray<IntVarArray, IntVar, int64_t>(vars, array)};
+    case ArgArrayType::FLOAT:
+      return Arg{
+          generateArgArray<FloatVarArray, FloatVar, double>(vars, array)};
+    case ArgArrayType::INT_SET:
+      return Arg{generateSetVarArray(vars, array)};
+    case ArgArrayType::FLOAT_SET: {
+      auto res = std::make_shared<FloatSetArray>();
+      for (const BasicExpr& expr : array) {
+        if (!isFloatSet(expr)) {
+          throw FznException("Invalid float set array literal");
+        }
+        res->push_back(toFloatSet(expr));
       }
-      res->push_back(toFloatSet(expr));
+      return res;
     }
-    return res;
   }
   throw FznException("transformArgArray(): Invalid variant type: " +
                      toString(array));
 }
 
-Var ModelTransformer::transformVarArray(
-    const std::unordered_map<std::string, Var>& vars,
-    const ArrayVarDecl& arrayVarDecl) {
+Var ModelTransformer::transformVarArray(const VarTable& vars,
+                                        const ArrayVarDecl& arrayVarDecl) {
   if (isBoolVar(arrayVarDecl)) {
     return Var{
         generateVarArray<BoolVarArray, BoolVar, bool>(vars, arrayVarDecl)};
@@ -917,19 +1042,17 @@ Var ModelTransformer::transformVarArray(
                      toString(arrayVarDecl));
 }
 
-Var ModelTransformer::transform(
-    const std::unordered_map<std::string, fznparser::Var>& vars,
-    const VarDeclItem& varDeclItem) {
-  return varDeclItem.type() == typeid(BasicVarDecl)
+Var ModelTransformer::transform(const VarTable& vars,
+                               const VarDeclItem& varDeclItem) {
+  return holds<BasicVarDecl>(varDeclItem)
              ? transformVar(vars, get<BasicVarDecl>(varDeclItem))
              : transformVarArray(vars, get<ArrayVarDecl>(varDeclItem));
 }
 
-SolveType ModelTransformer::transform(
-    const std::unordered_map<std::string, Var>& vars,
-    const parser::SolveItem& solveItem) const {
-  const std::vector<parser::Annotation> parserAnns =
-      solveItem.type() == typeid(SolveSatisfy)
+SolveType ModelTransformer::transform(const VarTable& vars,
+                                     const parser::SolveItem& solveItem) const {
+  const Annotations& parserAnns =
+      holds<SolveSatisfy>(solveItem)
           ? get<SolveSatisfy>(solveItem).annotations
           : get<SolveOptimize>(solveItem).annotations;
 
@@ -939,24 +1062,24 @@ SolveType ModelTransformer::transform(
     annotations.push_back(transformAnnotation(ann));
   }
 
-  if (solveItem.type() == typeid(SolveSatisfy)) {
+  if (holds<SolveSatisfy>(solveItem)) {
     return SolveType(std::move(annotations));
   }
   const SolveOptimize& solveOptimize = get<SolveOptimize>(solveItem);
-  if (solveOptimize.expr.type() != typeid(std::string)) {
+  if (!holds<std::string>(solveOptimize.expr)) {
     return SolveType(std::move(annotations));
   }
   const std::string& identifier = get<std::string>(solveOptimize.expr);
-  const auto iter = vars.find(identifier);
-  if (iter == vars.end()) {
-    if (_parDeclItems.contains(identifier)) {
+  const Var* var = vars.find(identifier);
+  if (var == nullptr) {
+    if (declaration(identifier).parDeclItem != nullptr) {
       return SolveType(std::move(annotations));
     }
     throw FznException(
         "Error when transforming solve type \"" + toString(solveItem) +
         "\": Reference to undefined variable \"" + identifier + "\"");
   }
-  if (isVarArray(iter->second)) {
+  if (isVarArray(*var)) {
     throw FznException(
         "Error when transforming solve item \"" + toString(solveItem) +
         "\": Cannot optimize over array variable with identifier \"" +
@@ -965,7 +1088,7 @@ SolveType ModelTransformer::transform(
   return {solveOptimize.type == OptimizationType::MINIMIZE
               ? ProblemType::MINIMIZE
               : ProblemType::MAXIMIZE,
-          iter->second, std::move(annotations)};
+          *var, std::move(annotations)};
 }
 
 bool isNonVarRef(const Var& var) {
@@ -1008,62 +1131,65 @@ Arg tryGetNonVarRef(const Var& var) {
                      var.identifier() + "\"");
 }
 
-Arg ModelTransformer::transformArgument(
-    const std::unordered_map<std::string, Var>& vars,
-    const parser::Expr& expr) {
-  if (expr.type() == typeid(bool)) {
-    return Arg{BoolArg{get<bool>(expr)}};
-  }
-  if (expr.type() == typeid(int64_t)) {
-    return Arg{IntArg{get<int64_t>(expr)}};
-  }
-  if (expr.type() == typeid(double)) {
-    return Arg{FloatArg{get<double>(expr)}};
-  }
-  if (isIntSet(expr.type())) {
-    return Arg{IntSetArg(toIntSet(expr))};
-  }
-  if (isFloatSet(expr.type())) {
-    return Arg{toFloatSet(expr)};
+Arg transformReference(const VarTable& vars, const parser::Expr& expr,
+                       const std::string& identifier) {
+  const Var* var = vars.find(identifier);
+  if (var == nullptr) {
+    throw FznException(
+        "Error when transforming argument \"" + toString(expr) +
+        "\": Reference to undefined variable \"" + identifier + "\"");
   }
-  if (expr.type() == typeid(ArrayLiteral)) {
-    return Arg{transformArgArray(vars, get<ArrayLiteral>(expr))};
+  if (isNonVarRef(*var)) {
+    return tryGetNonVarRef(*var);
   }
-  if (expr.type() == typeid(std::string)) {
-    const std::string& identifier = get<std::string>(expr);
-    const auto iter = vars.find(identifier);
-    if (iter == vars.end()) {
-      throw FznException(
-          "Error when transforming argument \"" + toString(expr) +
-          "\": Reference to undefined variable \"" + identifier + "\"");
-    }
-    if (isNonVarRef(iter->second)) {
-      return tryGetNonVarRef(iter->second);
-    }
-    if (std::holds_alternative<std::shared_ptr<VarReference>>(iter->second)) {
-      std::unordered_set<std::string> visited{identifier};
-      Var source = iter->second;
-      while (std::holds_alternative<std::shared_ptr<VarReference>>(source)) {
-        source = std::get<std::shared_ptr<VarReference>>(source)->source();
-        if (visited.contains(source.identifier())) {
-          throw FznException(
-              "Error when transforming argument \"" + toString(expr) +
-              "\": Circular reference in variable \"" + identifier + "\"");
-        }
-        visited.emplace(source.identifier());
-      }
-      if (isNonVarRef(source)) {
-        return tryGetNonVarRef(source);
+  if (std::holds_alternative<std::shared_ptr<VarReference>>(*var)) {
+    std::unordered_set<std::string> visited{identifier};
+    Var source = *var;
+    while (std::holds_alternative<std::shared_ptr<VarReference>>(source)) {
+      source = std::get<std::shared_ptr<VarReference>>(source)->source();
+      if (visited.contains(source.identifier())) {
+        throw FznException(
+            "Error when transforming argument \"" + toString(expr) +
+            "\": Circular reference in variable \"" + identifier + "\"");
       }
+      visited.emplace(source.identifier());
+    }
+    if (isNonVarRef(source)) {
+      return tryGetNonVarRef(source);
     }
   }
   throw FznException("Invalid variant type for argument \"" + toString(expr) +
                      "\"");
 }
 
+Arg ModelTransformer::transformArgument(const VarTable& vars,
+                                        const parser::Expr& expr) {
+  // dispatches on which() through a single jump table
+  return boost::apply_visitor(
+      [&](const auto& value) -> Arg {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, bool>) {
+          return Arg{BoolArg{value}};
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+          return Arg{IntArg{value}};
+        } else if constexpr (std::is_same_v<T, double>) {
+          return Arg{FloatArg{value}};
+        } else if constexpr (std::is_same_v<T, ArrayLiteral>) {
+          return Arg{transformArgArray(vars, value)};
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          return transformReference(vars, expr, value);
+        } else if constexpr (std::is_same_v<T, FloatSetLiteralBounded> ||
+                             std::is_same_v<T, FloatSetLiteralSet>) {
+          return Arg{std::make_shared<FloatSet>(toFloatSet(expr))};
+        } else {
+          return Arg{IntSetArg(toIntSet(expr))};
+        }
+      },
+      expr);
+}
+
 Constraint ModelTransformer::transform(
-    const std::unordered_map<std::string, Var>& vars,
-    const parser::ConstraintItem& constraintItem) {
+    const VarTable& vars, const parser::ConstraintItem& constraintItem) {
   std::vector<fznparser::Annotation> annotations;
   annotations.reserve(constraintItem.annotations.size());
   for (const parser::Annotation& ann : constraintItem.annotations) {
@@ -1080,24 +1206,123 @@ Constraint ModelTransformer::transform(
           std::move(annotations)};
 }
 
-fznparser::Model ModelTransformer::generateModel() {
-  std::unordered_map<std::string, Var> vars;
-  for (const VarDeclItem& varDeclItem : _model.varDeclItems) {
-    Var var = transform(vars, varDeclItem);
-    std::string identifier(var.identifier());
-    vars.emplace(std::make_pair<std::string, Var>(std::move(identifier),
-                                                  std::move(var)))
-        .first->second.interpretAnnotations(vars);
+// a thread is only worth it for at least this many constraints
+constexpr size_t minConstraintsPerThread = 512;
+// the number of constraints a thread claims at a time
+constexpr size_t constraintBlockSize = 64;
+
+std::vector<Constraint> ModelTransformer::transformConstraints(
+    const VarTable& vars, const std::unordered_map<std::string, Var>& varMap,
+    const size_t numThreads) {
+  const ArenaVector<ConstraintItem>& items = _model.constraintItems;
+  std::vector<Constraint> constraints;
+  constraints.reserve(items.size());
+  const size_t numWorkers =
+      std::min(numThreads, items.size() / minConstraintsPerThread);
+  if (numWorkers <= 1) {
+    for (const ConstraintItem& constraintItem : items) {
+      constraints.push_back(transform(vars, constraintItem));
+      constraints.back().interpretAnnotations(varMap);
+    }
+    return constraints;
+  }
+
+  // every constraint has its own slot, so the order of the constraints does
+  // not depend on the scheduling of the threads
+  std::vector<std::optional<Constraint>> slots(items.size());
+  std::atomic<size_t> nextBlock{0};
+  // the index of the first constraint that failed, so that the same
+  // exception is thrown as in a sequential transformation
+  std::atomic<size_t> failedAt{items.size()};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  const auto transformBlocks = [&] {
+    while (true) {
+      // blocks are claimed in order, so a block after a failed constraint
+      // cannot contain an earlier failure
+      const size_t begin = nextBlock.fetch_add(constraintBlockSize);
+      if (begin >= items.size() || begin > failedAt.load()) {
+        return;
+      }
+      const size_t end = std::min(begin + constraintBlockSize, items.size());
+      for (size_t i = begin; i < end; ++i) {
+        try {
+          slots[i].emplace(transform(vars, items[i]));
+          slots[i]->interpretAnnotations(varMap);
+        } catch (...) {
+          const std::scoped_lock lock(errorMutex);
+          if (i < failedAt.load()) {
+            failedAt.store(i);
+            error = std::current_exception();
+          }
+          return;
+        }
+      }
+    }
+  };
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(numWorkers - 1);
+    for (size_t i = 1; i < numWorkers; ++i) {
+      workers.emplace_back(transformBlocks);
+    }
+    transformBlocks();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  for (std::optional<Constraint>& slot : slots) {
+    constraints.push_back(std::move(slot.value()));
+  }
+  return constraints;
+}
+
+fznparser::Model ModelTransformer::generateModel(
+    const size_t numThreads, const bool buildOccurrenceIndex) {
+  VarTable vars(_symbols);
+  // the Model and the annotations look variables up by identifier
+  std::unordered_map<std::string, Var> varMap;
+  varMap.reserve(_model.varDeclItems.size());
+  {
+    const PhaseTimer timer(_stats, ParsePhase::VARIABLES);
+    for (const VarDeclItem& varDeclItem : _model.varDeclItems) {
+      const SymbolId id = _symbols.find(getIdentifier(varDeclItem)).value();
+      Var& var = vars.emplace(id, transform(vars, varDeclItem));
+      varMap.emplace(_symbols.name(id), var)
+          .first->second.interpretAnnotations(varMap);
+    }
   }
   std::vector<Constraint> constraints;
-  constraints.clear();
-  for (const ConstraintItem& constraintItem : _model.constraintItems) {
-    constraints.push_back(transform(vars, constraintItem));
-    constraints.back().interpretAnnotations(vars);
+  {
+    const PhaseTimer timer(_stats, ParsePhase::CONSTRAINTS);
+    constraints = transformConstraints(vars, varMap, numThreads);
+  }
+  if (_stats != nullptr) {
+    _stats->phase(ParsePhase::VARIABLES).numItems = _model.varDeclItems.size();
+    _stats->phase(ParsePhase::CONSTRAINTS).numItems = constraints.size();
   }
 
-  return {std::move(vars), std::move(constraints),
-          transform(vars, _model.solveItem)};
+  SolveType solveType = transform(vars, _model.solveItem);
+  fznparser::Model model(std::move(varMap), std::move(constraints),
+                         std::move(solveType));
+  if (buildOccurrenceIndex) {
+    const PhaseTimer timer(_stats, ParsePhase::CONSTRAINTS);
+    model.buildOccurrenceIndex();
+  }
+  return model;
+}
+
+Constraint ModelTransformer::transformConstraintItem(
+    ConstraintItem&& constraintItem) {
+  replaceParameters(constraintItem);
+  Constraint constraint = transform(_vars, constraintItem);
+  constraint.interpretAnnotations(_varMap);
+  return constraint;
+}
+
+SolveType ModelTransformer::transformSolveItem(
+    const SolveItem& solveItem) const {
+  return transform(_vars, solveItem);
 }
 
 }  // namespace fznparser
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "fznparser/transformer/symbolTable.hpp"
+
+#include <limits>
+
+#include "fznparser/except.hpp"
+
+namespace fznparser {
+
+void SymbolTable::reserve(const size_t size) { _ids.reserve(size); }
+
+SymbolId SymbolTable::intern(const std::string_view name) {
+  if (const auto iter = _ids.find(name); iter != _ids.end()) {
+    return iter->second;
+  }
+  if (_names.size() == std::numeric_limits<SymbolId>::max()) {
+    throw FznException("Too many identifiers");
+  }
+  const auto id = static_cast<SymbolId>(_names.size());
+  _ids.emplace(_names.emplace_back(name), id);
+  return id;
+}
+
+std::optional<SymbolId> SymbolTable::find(const std::string_view name) const {
+  const auto iter = _ids.find(name);
+  if (iter == _ids.end()) {
+    return std::nullopt;
+  }
+  return iter->second;
+}
+
+const std::string& SymbolTable::name(const SymbolId id) const {
+  return _names.at(id);
+}
+
+size_t SymbolTable::size() const noexcept { return _names.size(); }
+
+}  // namespace fznparser
@@ -1,19 +1,16 @@
 #include "fznparser/types.hpp"
 
+#include <boost/container_hash/hash.hpp>
 #include <algorithm>
+#include <bit>
 #include <functional>
-#include <numeric>
+#include <limits>
 
 #include "fznparser/except.hpp"
+#include "fznparser/simd.hpp"
 
 using std::get;
 
-std::vector<int64_t> sortAndRemoveDuplicates(std::vector<int64_t>& vals) {
-  std::ranges::sort(vals);
-  vals.erase(std::ranges::unique(vals).begin(), vals.end());
-  return vals;
-}
-
 std::vector<double> sortAndRemoveDuplicates(std::vector<double>& vals) {
   std::ranges::sort(vals);
   vals.erase(std::ranges::unique(vals).begin(), vals.end());
@@ -22,6 +19,51 @@ std::vector<double> sortAndRemoveDuplicates(std::vector<double>& vals) {
 
 namespace fznparser {
 
+// sets with at most this many elements are stored as their elements, which
+// elements() then returns, as most set literals in FlatZinc models are small
+constexpr size_t maxEnumeratedSize = 16;
+
+// the number of elements of lb..ub, which wraps around to 0 for the interval
+// of all int64_t values
+size_t intervalSize(const int64_t lb, const int64_t ub) {
+  return static_cast<size_t>(static_cast<uint64_t>(ub) -
+                             static_cast<uint64_t>(lb)) +
+         1;
+}
+
+std::vector<std::pair<int64_t, int64_t>> toIntervals(
+    const std::vector<int64_t>& sortedElements) {
+  std::vector<std::pair<int64_t, int64_t>> intervals;
+  for (const int64_t element : sortedElements) {
+    // the elements are unique, so the upper bound is less than the element
+    if (!intervals.empty() && intervals.back().second + 1 == element) {
+      ++intervals.back().second;
+    } else {
+      intervals.emplace_back(element, element);
+    }
+  }
+  return intervals;
+}
+
+// the index of the first bit at or after the position that is set, or
+// words.size() * 64 if there is none
+size_t nextSetBit(const std::vector<uint64_t>& words, const size_t position,
+                  const bool set = true) {
+  size_t word = position / 64;
+  if (word >= words.size()) {
+    return words.size() * 64;
+  }
+  const uint64_t flip = set ? 0 : ~uint64_t{0};
+  uint64_t bits = (words[word] ^ flip) & (~uint64_t{0} << (position % 64));
+  while (bits == 0) {
+    if (++word == words.size()) {
+      return words.size() * 64;
+    }
+    bits = words[word] ^ flip;
+  }
+  return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+}
+
 IntSet::IntSet(int64_t val) : _elements(std::make_pair(val, val)) {}
 IntSet::IntSet(int64_t lb, int64_t ub) {
   if (lb > ub) {
@@ -36,46 +78,229 @@ IntSet::IntSet(int64_t lb, int64_t ub) {
   _elements = std::make_pair(lb, ub);
 }
 
-IntSet::IntSet(std::vector<int64_t>&& elems)
-    : _elements(sortAndRemoveDuplicates(elems)) {}
+IntSet::IntSet(std::vector<int64_t>&& elems) {
+  std::ranges::sort(elems);
+  elems.erase(std::ranges::unique(elems).begin(), elems.end());
+  // kept as they are, so that elements() returns them for any set that is
+  // not an interval, e.g. the set literals of a model
+  _elements = std::move(elems);
+}
+
+IntSet::IntSet(std::vector<std::pair<int64_t, int64_t>>&& intervals) {
+  for (const auto& [lb, ub] : intervals) {
+    if (lb > ub) {
+      throw FznException("Lower bound cannot be greater than upper bound (" +
+                         std::to_string(lb) + " > " + std::to_string(ub) +
+                         ")");
+    }
+  }
+  std::ranges::sort(intervals);
+  // merge the intervals that overlap or are adjacent
+  size_t last = 0;
+  for (size_t i = 1; i < intervals.size(); ++i) {
+    if (intervals[last].second == std::numeric_limits<int64_t>::max() ||
+        intervals[i].first <= intervals[last].second + 1) {
+      intervals[last].second =
+          std::max(intervals[last].second, intervals[i].second);
+    } else {
+      intervals[++last] = intervals[i];
+    }
+  }
+  intervals.resize(std::min(intervals.size(), last + 1));
+  assign(std::move(intervals));
+}
+
+void IntSet::assign(std::vector<std::pair<int64_t, int64_t>>&& intervals) {
+  if (intervals.size() <= 1) {
+    if (intervals.empty()) {
+      _elements = std::vector<int64_t>{};
+    } else {
+      _elements = intervals.front();
+    }
+    return;
+  }
+  // the sizes of the representations in 64-bit words, where the number of
+  // elements saturates as it only matters when it is small
+  size_t numElements = 0;
+  for (const auto& [lb, ub] : intervals) {
+    const size_t width = intervalSize(lb, ub) - 1;
+    numElements = width >= std::numeric_limits<size_t>::max() - numElements
+                      ? std::numeric_limits<size_t>::max()
+                      : numElements + width + 1;
+  }
+  const size_t intervalWords = 2 * intervals.size();
+  const size_t bitsetWords =
+      (intervalSize(intervals.front().first, intervals.back().second) - 1) /
+          64 +
+      1;
+  if (numElements <= maxEnumeratedSize ||
+      (numElements <= intervalWords && numElements <= bitsetWords)) {
+    std::vector<int64_t> elems;
+    elems.reserve(numElements);
+    for (const auto& [lb, ub] : intervals) {
+      for (int64_t i = lb; i < ub; ++i) {
+        elems.push_back(i);
+      }
+      elems.push_back(ub);
+    }
+    _elements = std::move(elems);
+  } else if (bitsetWords <= intervalWords) {
+    Bitset bitset{intervals.front().first,
+                  std::vector<uint64_t>(bitsetWords, 0)};
+    for (const auto& [lb, ub] : intervals) {
+      const size_t first = intervalSize(bitset.offset, lb) - 1;
+      const size_t last = intervalSize(bitset.offset, ub) - 1;
+      for (size_t word = first / 64; word <= last / 64; ++word) {
+        const size_t from = word == first / 64 ? first % 64 : 0;
+        const size_t to = word == last / 64 ? last % 64 : 63;
+        bitset.words[word] |=
+            (~uint64_t{0} >> (63 - to)) & (~uint64_t{0} << from);
+      }
+    }
+    _elements = std::move(bitset);
+  } else {
+    _elements = std::move(intervals);
+  }
+}
 
 bool IntSet::contains(const int64_t val) const {
   if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
     auto [lb, ub] = get<std::pair<int64_t, int64_t>>(_elements);
     return lb <= val && val <= ub;
   }
-  return std::ranges::binary_search(get<std::vector<int64_t>>(_elements), val);
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    const std::vector<int64_t>& elems = get<std::vector<int64_t>>(_elements);
+    const size_t index = simd::lowerBound(elems, val);
+    return index < elems.size() && elems[index] == val;
+  }
+  if (holds_alternative<Bitset>(_elements)) {
+    const Bitset& bitset = get<Bitset>(_elements);
+    if (val < bitset.offset) {
+      return false;
+    }
+    const size_t bit = intervalSize(bitset.offset, val) - 1;
+    return bit / 64 < bitset.words.size() &&
+           ((bitset.words[bit / 64] >> (bit % 64)) & 1) != 0;
+  }
+  const auto& intervals =
+      get<std::vector<std::pair<int64_t, int64_t>>>(_elements);
+  // the first interval that starts after the value
+  const auto it = std::ranges::upper_bound(
+      intervals, val, {}, &std::pair<int64_t, int64_t>::first);
+  return it != intervals.begin() && val <= std::prev(it)->second;
+}
+
+void IntSet::contains(const std::span<const int64_t> values,
+                      const std::span<bool> results) const {
+  if (values.size() != results.size()) {
+    throw FznException("Expected as many results as values (" +
+                       std::to_string(results.size()) +
+                       " != " + std::to_string(values.size()) + ")");
+  }
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    auto [lb, ub] = get<std::pair<int64_t, int64_t>>(_elements);
+    for (size_t i = 0; i < values.size(); ++i) {
+      results[i] = lb <= values[i] && values[i] <= ub;
+    }
+  } else if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    const std::span<const int64_t> elems =
+        get<std::vector<int64_t>>(_elements);
+    // the elements before first are less than the previous value, so the
+    // search for an increasing value continues from there
+    size_t first = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (i > 0 && values[i] < values[i - 1]) {
+        first = 0;
+      }
+      first += simd::gallop(elems.subspan(first), values[i]);
+      results[i] = first < elems.size() && elems[first] == values[i];
+    }
+  } else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      results[i] = contains(values[i]);
+    }
+  }
 }
 
 size_t IntSet::size() const {
   if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
     auto [lb, ub] = get<std::pair<int64_t, int64_t>>(_elements);
-    return static_cast<size_t>(ub) - static_cast<size_t>(lb) + 1;
+    return intervalSize(lb, ub);
   }
-  return get<std::vector<int64_t>>(_elements).size();
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    return get<std::vector<int64_t>>(_elements).size();
+  }
+  size_t size = 0;
+  if (holds_alternative<Bitset>(_elements)) {
+    for (const uint64_t word : get<Bitset>(_elements).words) {
+      size += static_cast<size_t>(std::popcount(word));
+    }
+    return size;
+  }
+  for (const auto& [lb, ub] :
+       get<std::vector<std::pair<int64_t, int64_t>>>(_elements)) {
+    size += intervalSize(lb, ub);
+  }
+  return size;
 }
 
 int64_t IntSet::lowerBound() const {
-  return holds_alternative<std::pair<int64_t, int64_t>>(_elements)
-             ? get<std::pair<int64_t, int64_t>>(_elements).first
-             : get<std::vector<int64_t>>(_elements).front();
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    return get<std::pair<int64_t, int64_t>>(_elements).first;
+  }
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    return get<std::vector<int64_t>>(_elements).front();
+  }
+  if (holds_alternative<Bitset>(_elements)) {
+    // the lowest bit is set
+    return get<Bitset>(_elements).offset;
+  }
+  return get<std::vector<std::pair<int64_t, int64_t>>>(_elements)
+      .front()
+      .first;
 }
 
 int64_t IntSet::upperBound() const {
-  return holds_alternative<std::pair<int64_t, int64_t>>(_elements)
-             ? get<std::pair<int64_t, int64_t>>(_elements).second
-             : get<std::vector<int64_t>>(_elements).back();
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    return get<std::pair<int64_t, int64_t>>(_elements).second;
+  }
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    return get<std::vector<int64_t>>(_elements).back();
+  }
+  if (holds_alternative<Bitset>(_elements)) {
+    const Bitset& bitset = get<Bitset>(_elements);
+    // the highest bit is set
+    return static_cast<int64_t>(
+        static_cast<uint64_t>(bitset.offset) + bitset.words.size() * 64 - 1 -
+        static_cast<uint64_t>(std::countl_zero(bitset.words.back())));
+  }
+  return get<std::vector<std::pair<int64_t, int64_t>>>(_elements)
+      .back()
+      .second;
 }
 
 bool IntSet::isInterval() const {
-  return holds_alternative<std::pair<int64_t, int64_t>>(_elements) ||
-         (upperBound() - lowerBound() + 1 == static_cast<int64_t>(size()));
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    return true;
+  }
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    return upperBound() - lowerBound() + 1 == static_cast<int64_t>(size());
+  }
+  // interval lists and bitsets hold at least two intervals
+  return false;
+}
+
+bool IntSet::hasElements() const {
+  return holds_alternative<std::vector<int64_t>>(_elements);
 }
 
 const std::vector<int64_t>& IntSet::populateElements() {
-  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
-    std::vector<int64_t> elems(upperBound() - lowerBound() + 1);
-    std::iota(elems.begin(), elems.end(), lowerBound());
+  if (!hasElements()) {
+    std::vector<int64_t> elems;
+    elems.reserve(size());
+    for (const int64_t element : *this) {
+      elems.push_back(element);
+    }
     _elements = std::move(elems);
   }
   return get<std::vector<int64_t>>(_elements);
@@ -85,45 +310,209 @@ const std::vector<int64_t>& IntSet::elements() const {
   if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
     throw FznException("Cannot get elements from interval");
   }
+  if (!hasElements()) {
+    throw FznException(
+        "Cannot get elements from a set that does not hold them");
+  }
   return get<std::vector<int64_t>>(_elements);
 }
 
-bool IntSet::operator==(const IntSet& other) const {
-  if (isInterval() != other.isInterval()) {
-    return false;
+std::vector<std::pair<int64_t, int64_t>> IntSet::intervals() const {
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    return {get<std::pair<int64_t, int64_t>>(_elements)};
   }
-  if (isInterval() == other.isInterval()) {
-    return lowerBound() == other.lowerBound() &&
-           upperBound() == other.upperBound();
+  if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    return toIntervals(get<std::vector<int64_t>>(_elements));
   }
-  const std::vector<int64_t>& e1 = elements();
-  const std::vector<int64_t>& e2 = elements();
-  if (e1.size() != e2.size()) {
-    return false;
+  if (holds_alternative<Bitset>(_elements)) {
+    const Bitset& bitset = get<Bitset>(_elements);
+    std::vector<std::pair<int64_t, int64_t>> intervals;
+    const size_t numBits = bitset.words.size() * 64;
+    for (size_t first = 0; first < numBits;
+         first = nextSetBit(bitset.words, first)) {
+      const size_t end = nextSetBit(bitset.words, first, false);
+      intervals.emplace_back(
+          static_cast<int64_t>(static_cast<uint64_t>(bitset.offset) + first),
+          static_cast<int64_t>(static_cast<uint64_t>(bitset.offset) + end -
+                               1));
+      first = end;
+    }
+    return intervals;
   }
-  for (size_t i = 0; i < e1.size(); ++i) {
-    if (e1[i] != e2[i]) {
+  return get<std::vector<std::pair<int64_t, int64_t>>>(_elements);
+}
+
+IntSet::const_iterator IntSet::begin() const {
+  if (hasElements() && elements().empty()) {
+    return end();
+  }
+  return {this, 0, lowerBound()};
+}
+
+IntSet::const_iterator IntSet::end() const {
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements) ||
+      holds_alternative<std::vector<int64_t>>(_elements)) {
+    return {this, size(), 0};
+  }
+  if (holds_alternative<Bitset>(_elements)) {
+    return {this, get<Bitset>(_elements).words.size() * 64, 0};
+  }
+  return {this, get<std::vector<std::pair<int64_t, int64_t>>>(_elements).size(),
+          0};
+}
+
+void IntSet::advance(size_t& position, int64_t& value) const {
+  // the position of the end iterator goes with the value 0
+  if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
+    value = ++position == size() ? 0 : value + 1;
+  } else if (holds_alternative<std::vector<int64_t>>(_elements)) {
+    const std::vector<int64_t>& elems = get<std::vector<int64_t>>(_elements);
+    value = ++position < elems.size() ? elems[position] : 0;
+  } else if (holds_alternative<Bitset>(_elements)) {
+    const Bitset& bitset = get<Bitset>(_elements);
+    position = nextSetBit(bitset.words, position + 1);
+    value = position < bitset.words.size() * 64
+                ? static_cast<int64_t>(static_cast<uint64_t>(bitset.offset) +
+                                       position)
+                : 0;
+  } else {
+    const auto& intervals =
+        get<std::vector<std::pair<int64_t, int64_t>>>(_elements);
+    if (value < intervals[position].second) {
+      ++value;
+    } else {
+      value = ++position < intervals.size() ? intervals[position].first : 0;
+    }
+  }
+}
+
+IntSet IntSet::intersect(const IntSet& other) const {
+  const std::vector<std::pair<int64_t, int64_t>> lhs = intervals();
+  const std::vector<std::pair<int64_t, int64_t>> rhs = other.intervals();
+  std::vector<std::pair<int64_t, int64_t>> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < lhs.size() && j < rhs.size()) {
+    const int64_t lb = std::max(lhs[i].first, rhs[j].first);
+    const int64_t ub = std::min(lhs[i].second, rhs[j].second);
+    if (lb <= ub) {
+      result.emplace_back(lb, ub);
+    }
+    // the interval that ends first does not intersect any later interval
+    if (lhs[i].second < rhs[j].second) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return IntSet(std::move(result));
+}
+
+IntSet IntSet::unite(const IntSet& other) const {
+  std::vector<std::pair<int64_t, int64_t>> result = intervals();
+  const std::vector<std::pair<int64_t, int64_t>> rhs = other.intervals();
+  result.insert(result.end(), rhs.begin(), rhs.end());
+  return IntSet(std::move(result));
+}
+
+IntSet IntSet::subtract(const IntSet& other) const {
+  const std::vector<std::pair<int64_t, int64_t>> rhs = other.intervals();
+  std::vector<std::pair<int64_t, int64_t>> result;
+  size_t j = 0;
+  for (auto [lb, ub] : intervals()) {
+    while (j < rhs.size() && rhs[j].second < lb) {
+      ++j;
+    }
+    bool covered = false;
+    for (size_t k = j; k < rhs.size() && rhs[k].first <= ub; ++k) {
+      if (lb < rhs[k].first) {
+        result.emplace_back(lb, rhs[k].first - 1);
+      }
+      if (ub <= rhs[k].second) {
+        covered = true;
+        break;
+      }
+      lb = rhs[k].second + 1;
+    }
+    if (!covered) {
+      result.emplace_back(lb, ub);
+    }
+  }
+  return IntSet(std::move(result));
+}
+
+bool IntSet::isSubsetOf(const IntSet& other) const {
+  if (hasElements() && other.hasElements()) {
+    return simd::includes(other.elements(), elements());
+  }
+  const std::vector<std::pair<int64_t, int64_t>> rhs = other.intervals();
+  size_t j = 0;
+  // the intervals are maximal, so each interval of the subset is within a
+  // single interval of the other set
+  for (const auto& [lb, ub] : intervals()) {
+    while (j < rhs.size() && rhs[j].second < lb) {
+      ++j;
+    }
+    if (j == rhs.size() || lb < rhs[j].first || rhs[j].second < ub) {
       return false;
     }
   }
   return true;
 }
 
+bool IntSet::operator==(const IntSet& other) const {
+  if (hasElements() && other.hasElements()) {
+    // which is a memcmp that the C library vectorizes
+    return std::ranges::equal(elements(), other.elements());
+  }
+  // the empty set is always stored as its elements
+  if ((hasElements() && elements().empty()) ||
+      (other.hasElements() && other.elements().empty())) {
+    return false;
+  }
+  if (size() != other.size() || lowerBound() != other.lowerBound() ||
+      upperBound() != other.upperBound()) {
+    return false;
+  }
+  if (holds_alternative<Bitset>(_elements) &&
+      holds_alternative<Bitset>(other._elements)) {
+    // the bitsets have the same offset, as the lower bounds are equal
+    const std::vector<uint64_t>& words = get<Bitset>(_elements).words;
+    const std::vector<uint64_t>& otherWords =
+        get<Bitset>(other._elements).words;
+    return std::ranges::equal(words, otherWords);
+  }
+  // the maximal intervals of a set are unique
+  return intervals() == other.intervals();
+}
+
 bool IntSet::operator!=(const IntSet& other) const {
   return !operator==(other);
 }
 
+size_t IntSet::hash() const {
+  if (hasElements() && elements().empty()) {
+    return 0;
+  }
+  // equal sets are stored differently, but have the same bounds
+  size_t seed = 0;
+  boost::hash_combine(seed, isInterval());
+  boost::hash_combine(seed, lowerBound());
+  boost::hash_combine(seed, upperBound());
+  return seed;
+}
+
 std::string IntSet::toString() const {
   if (holds_alternative<std::pair<int64_t, int64_t>>(_elements)) {
     auto [lb, ub] = get<std::pair<int64_t, int64_t>>(_elements);
     return std::to_string(lb) + ".." + std::to_string(ub);
   }
   std::string str = "{";
-  for (size_t i = 0; i < get<std::vector<int64_t>>(_elements).size(); ++i) {
-    if (i != 0) {
+  for (const int64_t element : *this) {
+    if (str.size() > 1) {
       str += ", ";
     }
-    str += std::to_string(get<std::vector<int64_t>>(_elements)[i]);
+    str += std::to_string(element);
   }
   return str + "}";
 }
@@ -170,6 +559,10 @@ bool FloatSet::isInterval() const {
          (lowerBound() == upperBound());
 }
 
+bool FloatSet::hasElements() const {
+  return holds_alternative<std::vector<double>>(_elements);
+}
+
 bool FloatSet::operator==(const FloatSet& other) const {
   if (isInterval() != other.isInterval()) {
     return false;
@@ -195,6 +588,17 @@ bool FloatSet::operator!=(const FloatSet& other) const {
   return !operator==(other);
 }
 
+size_t FloatSet::hash() const {
+  if (hasElements() && elements().empty()) {
+    return 0;
+  }
+  size_t seed = 0;
+  boost::hash_combine(seed, isInterval());
+  boost::hash_combine(seed, lowerBound());
+  boost::hash_combine(seed, upperBound());
+  return seed;
+}
+
 std::string FloatSet::toString() const {
   if (holds_alternative<std::pair<double, double>>(_elements)) {
     auto [lb, ub] = get<std::pair<double, double>>(_elements);
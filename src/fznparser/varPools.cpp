@@ -0,0 +1,293 @@
+#include "fznparser/varPools.hpp"
+
+#include <ranges>
+
+#include "fznparser/except.hpp"
+
+namespace fznparser {
+
+uint32_t poolIndex(const size_t size) {
+  if (size > BoolHandle::maxIndex) {
+    throw FznException("Too many elements for a 32-bit handle");
+  }
+  return static_cast<uint32_t>(size);
+}
+
+template <typename ParType, class VarType>
+Handle<VarType> VarPools::addParameter(Pool<ParType, VarType>& pool,
+                                       const ParType& par) {
+  const uint32_t index = poolIndex(pool.pars.size());
+  pool.pars.push_back(par);
+  return Handle<VarType>::parameter(index);
+}
+
+template <typename ParType, class VarType>
+Handle<VarType> VarPools::addVar(Pool<ParType, VarType>& pool,
+                                 const VarType& var, Indices& indices) {
+  const auto [it, inserted] =
+      indices.emplace(&var, poolIndex(pool.vars.size()));
+  if (inserted) {
+    pool.vars.push_back(var);
+  }
+  return Handle<VarType>::var(it->second);
+}
+
+template <class ArrayType, typename ParType, class VarType>
+ArrayHandle<ArrayType> VarPools::addArray(Pool<ParType, VarType>& pool,
+                                          const ArrayType& array,
+                                          Indices& indices) {
+  const uint32_t index = poolIndex(pool.arrayOffsets.size() - 1);
+  const auto [it, inserted] = indices.emplace(&array, index);
+  if (!inserted) {
+    return {it->second};
+  }
+  for (const auto element : array) {
+    pool.elements.push_back(element.isParameter()
+                                ? addParameter(pool, element.parameter())
+                                : addVar(pool, *element.var(), indices));
+  }
+  pool.arrayOffsets.push_back(poolIndex(pool.elements.size()));
+  return {index};
+}
+
+ArrayHandle<FloatSetArray> VarPools::addArray(const FloatSetArray& array) {
+  const uint32_t index = poolIndex(_floatSetArrayOffsets.size() - 1);
+  // float sets cannot be copy assigned, which vector::insert requires
+  for (const FloatSet& floatSet : array) {
+    _floatSetArrayElements.push_back(floatSet);
+  }
+  _floatSetArrayOffsets.push_back(poolIndex(_floatSetArrayElements.size()));
+  return {index};
+}
+
+PooledVar VarPools::addVar(const Var& var, Indices& indices) {
+  if (std::holds_alternative<std::shared_ptr<BoolVar>>(var)) {
+    return addVar(_bools, *std::get<std::shared_ptr<BoolVar>>(var), indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<IntVar>>(var)) {
+    return addVar(_ints, *std::get<std::shared_ptr<IntVar>>(var), indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<FloatVar>>(var)) {
+    return addVar(_floats, *std::get<std::shared_ptr<FloatVar>>(var),
+                  indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<SetVar>>(var)) {
+    return addVar(_sets, *std::get<std::shared_ptr<SetVar>>(var), indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<BoolVarArray>>(var)) {
+    return addArray(_bools, *std::get<std::shared_ptr<BoolVarArray>>(var),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<IntVarArray>>(var)) {
+    return addArray(_ints, *std::get<std::shared_ptr<IntVarArray>>(var),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<FloatVarArray>>(var)) {
+    return addArray(_floats, *std::get<std::shared_ptr<FloatVarArray>>(var),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<SetVarArray>>(var)) {
+    return addArray(_sets, *std::get<std::shared_ptr<SetVarArray>>(var),
+                    indices);
+  }
+  return addVar(std::get<std::shared_ptr<VarReference>>(var)->source(),
+                indices);
+}
+
+PooledArg VarPools::addArg(const Arg& arg, Indices& indices) {
+  if (std::holds_alternative<BoolArg>(arg)) {
+    const BoolArg& boolArg = std::get<BoolArg>(arg);
+    return boolArg.isParameter()
+               ? addParameter(_bools, boolArg.parameter())
+               : addVar(_bools,
+                        *std::get<std::shared_ptr<const BoolVar>>(boolArg),
+                        indices);
+  }
+  if (std::holds_alternative<IntArg>(arg)) {
+    const IntArg& intArg = std::get<IntArg>(arg);
+    return intArg.isParameter()
+               ? addParameter(_ints, intArg.parameter())
+               : addVar(_ints,
+                        *std::get<std::shared_ptr<const IntVar>>(intArg),
+                        indices);
+  }
+  if (std::holds_alternative<FloatArg>(arg)) {
+    const FloatArg& floatArg = std::get<FloatArg>(arg);
+    return floatArg.isParameter()
+               ? addParameter(_floats, floatArg.parameter())
+               : addVar(_floats,
+                        *std::get<std::shared_ptr<const FloatVar>>(floatArg),
+                        indices);
+  }
+  if (std::holds_alternative<IntSetArg>(arg)) {
+    const IntSetArg& setArg = std::get<IntSetArg>(arg);
+    return setArg.isParameter()
+               ? addParameter(_sets, setArg.parameter())
+               : addVar(_sets,
+                        *std::get<std::shared_ptr<const SetVar>>(setArg),
+                        indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<FloatSet>>(arg)) {
+    _floatSets.push_back(*std::get<std::shared_ptr<FloatSet>>(arg));
+    return FloatSetHandle{poolIndex(_floatSets.size() - 1)};
+  }
+  if (std::holds_alternative<std::shared_ptr<BoolVarArray>>(arg)) {
+    return addArray(_bools, *std::get<std::shared_ptr<BoolVarArray>>(arg),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<IntVarArray>>(arg)) {
+    return addArray(_ints, *std::get<std::shared_ptr<IntVarArray>>(arg),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<FloatVarArray>>(arg)) {
+    return addArray(_floats, *std::get<std::shared_ptr<FloatVarArray>>(arg),
+                    indices);
+  }
+  if (std::holds_alternative<std::shared_ptr<SetVarArray>>(arg)) {
+    return addArray(_sets, *std::get<std::shared_ptr<SetVarArray>>(arg),
+                    indices);
+  }
+  return addArray(*std::get<std::shared_ptr<FloatSetArray>>(arg));
+}
+
+VarPools::VarPools(const std::unordered_map<std::string, Var>& vars,
+                   const std::vector<Constraint>& constraints) {
+  Indices indices;
+  indices.reserve(vars.size());
+  _vars.reserve(vars.size());
+  for (const Var& var : vars | std::views::values) {
+    _vars.push_back(addVar(var, indices));
+  }
+  std::unordered_map<std::string, uint32_t> identifiers;
+  _constraintIdentifiers.reserve(constraints.size());
+  _argumentOffsets.reserve(constraints.size() + 1);
+  for (const Constraint& constraint : constraints) {
+    const auto [it, inserted] = identifiers.emplace(
+        constraint.identifier(), poolIndex(_identifiers.size()));
+    if (inserted) {
+      _identifiers.push_back(constraint.identifier());
+    }
+    _constraintIdentifiers.push_back(it->second);
+    for (const Arg& arg : constraint.arguments()) {
+      _arguments.push_back(addArg(arg, indices));
+    }
+    _argumentOffsets.push_back(poolIndex(_arguments.size()));
+  }
+}
+
+template <class VarType>
+const VarType& pooledVar(const std::vector<VarType>& vars,
+                         const Handle<VarType> handle) {
+  if (handle.isParameter()) {
+    throw FznException("Not the handle of a variable");
+  }
+  return vars.at(handle.index());
+}
+
+template <class Pars, class VarType>
+const typename Pars::value_type& pooledParameter(
+    const Pars& pars, const Handle<VarType> handle) {
+  if (!handle.isParameter()) {
+    throw FznException("Not the handle of a parameter");
+  }
+  return pars.at(handle.index());
+}
+
+// the elements at index in a pool of ranges with the offsets
+template <typename T>
+std::span<const T> pooledRange(const std::vector<T>& elements,
+                               const std::vector<uint32_t>& offsets,
+                               const uint32_t index) {
+  if (static_cast<size_t>(index) + 1 >= offsets.size()) {
+    throw FznException("Invalid handle: " + std::to_string(index));
+  }
+  return {elements.data() + offsets[index],
+          elements.data() + offsets[index + 1]};
+}
+
+size_t VarPools::numConstraints() const {
+  return _constraintIdentifiers.size();
+}
+
+std::span<const PooledVar> VarPools::vars() const { return _vars; }
+
+const std::string& VarPools::identifier(const uint32_t constraint) const {
+  return _identifiers[_constraintIdentifiers.at(constraint)];
+}
+
+std::span<const PooledArg> VarPools::arguments(
+    const uint32_t constraint) const {
+  return pooledRange(_arguments, _argumentOffsets, constraint);
+}
+
+std::span<const BoolVar> VarPools::boolVars() const { return _bools.vars; }
+
+std::span<const IntVar> VarPools::intVars() const { return _ints.vars; }
+
+std::span<const FloatVar> VarPools::floatVars() const { return _floats.vars; }
+
+std::span<const SetVar> VarPools::setVars() const { return _sets.vars; }
+
+const BoolVar& VarPools::var(const BoolHandle handle) const {
+  return pooledVar(_bools.vars, handle);
+}
+
+const IntVar& VarPools::var(const IntHandle handle) const {
+  return pooledVar(_ints.vars, handle);
+}
+
+const FloatVar& VarPools::var(const FloatHandle handle) const {
+  return pooledVar(_floats.vars, handle);
+}
+
+const SetVar& VarPools::var(const SetHandle handle) const {
+  return pooledVar(_sets.vars, handle);
+}
+
+bool VarPools::parameter(const BoolHandle handle) const {
+  return pooledParameter(_bools.pars, handle);
+}
+
+int64_t VarPools::parameter(const IntHandle handle) const {
+  return pooledParameter(_ints.pars, handle);
+}
+
+double VarPools::parameter(const FloatHandle handle) const {
+  return pooledParameter(_floats.pars, handle);
+}
+
+const IntSet& VarPools::parameter(const SetHandle handle) const {
+  return pooledParameter(_sets.pars, handle);
+}
+
+const FloatSet& VarPools::parameter(const FloatSetHandle handle) const {
+  return _floatSets.at(handle.index);
+}
+
+std::span<const BoolHandle> VarPools::elements(
+    const ArrayHandle<BoolVarArray> handle) const {
+  return pooledRange(_bools.elements, _bools.arrayOffsets, handle.index);
+}
+
+std::span<const IntHandle> VarPools::elements(
+    const ArrayHandle<IntVarArray> handle) const {
+  return pooledRange(_ints.elements, _ints.arrayOffsets, handle.index);
+}
+
+std::span<const FloatHandle> VarPools::elements(
+    const ArrayHandle<FloatVarArray> handle) const {
+  return pooledRange(_floats.elements, _floats.arrayOffsets, handle.index);
+}
+
+std::span<const SetHandle> VarPools::elements(
+    const ArrayHandle<SetVarArray> handle) const {
+  return pooledRange(_sets.elements, _sets.arrayOffsets, handle.index);
+}
+
+std::span<const FloatSet> VarPools::elements(
+    const ArrayHandle<FloatSetArray> handle) const {
+  return pooledRange(_floatSetArrayElements, _floatSetArrayOffsets,
+                     handle.index);
+}
+
+}  // namespace fznparser
@@ -126,6 +126,10 @@ IntVar::IntVar(std::vector<int64_t>&& vals, const std::string& identifier,
                std::vector<Annotation>&& annotations)
     : VarBase(identifier, std::move(annotations)), _domain(std::move(vals)) {}
 
+IntVar::IntVar(IntSet&& domain, const std::string& identifier,
+               std::vector<Annotation>&& annotations)
+    : VarBase(identifier, std::move(annotations)), _domain(std::move(domain)) {}
+
 const IntSet& IntVar::domain() const { return _domain; }
 
 bool IntVar::contains(const int64_t& val) const {
@@ -240,8 +244,8 @@ SetVar::SetVar(const IntSet& domain, const std::string& identifier,
                std::vector<Annotation>&& annotations)
     : VarBase(identifier, std::move(annotations)), _domain(domain) {}
 
-bool SetVar::contains(const IntSet&) const {
-  throw FznException("Not yet implemented");
+bool SetVar::contains(const IntSet& val) const {
+  return val.isSubsetOf(_domain);
 }
 IntSet SetVar::lowerBound() const { return _domain; }
 IntSet SetVar::upperBound() const { return _domain; }
@@ -318,12 +322,12 @@ std::vector<shared_ptr<const BoolVar>> BoolVarArray::toVarVector(
     fznparser::Model& model) {
   std::vector<shared_ptr<const BoolVar>> params;
   params.clear();
-  for (size_t i = 0; i < this->size(); ++i) {
-    if (std::holds_alternative<bool>((*this)[i])) {
+  for (const auto element : *this) {
+    if (element.isParameter()) {
       params.emplace_back(
-          shared_ptr<const BoolVar>(model.boolVarPar(get<bool>((*this)[i]))));
+          shared_ptr<const BoolVar>(model.boolVarPar(element.parameter())));
     } else {
-      params.emplace_back(get<shared_ptr<const BoolVar>>((*this)[i]));
+      params.emplace_back(element.var());
     }
   }
   return params;
@@ -334,19 +338,17 @@ bool BoolVarArray::operator==(const BoolVarArray& other) const {
       annotations().size() != other.annotations().size()) {
     return false;
   }
-  for (size_t i = 0; i < size(); ++i) {
-    if (std::holds_alternative<bool>(at(i))) {
-      if (!std::holds_alternative<bool>(other.at(i)) ||
-          get<bool>(at(i)) != get<bool>(other.at(i))) {
-        return false;
-      }
+  for (auto it = begin(), otherIt = other.begin(); it != end();
+       ++it, ++otherIt) {
+    const auto element = *it;
+    const auto otherElement = *otherIt;
+    if (element.isParameter() != otherElement.isParameter()) {
+      return false;
     }
-    if (std::holds_alternative<shared_ptr<const BoolVar>>(at(i))) {
-      if (!std::holds_alternative<shared_ptr<const BoolVar>>(other.at(i)) ||
-          get<shared_ptr<const BoolVar>>(at(i))->operator!=(
-              *get<shared_ptr<const BoolVar>>(other.at(i)))) {
-        return false;
-      }
+    if (element.isParameter()
+            ? element.parameter() != otherElement.parameter()
+            : element.var()->operator!=(*otherElement.var())) {
+      return false;
     }
   }
   for (size_t i = 0; i < annotations().size(); ++i) {
@@ -367,14 +369,15 @@ std::string BoolVarArray::toString() const {
           ? "["
           : ("array[1.." + std::to_string(size()) + "] of" +
              (isParArray() ? "" : " var") + " bool: " + identifier() + " = [");
-  for (size_t i = 0; i < size(); ++i) {
-    if (i != 0) {
+  for (auto it = begin(); it != end(); ++it) {
+    if (it != begin()) {
       s += ", ";
     }
-    if (std::holds_alternative<bool>(at(i))) {
-      s += get<bool>(at(i)) ? "true" : "false";
+    const auto element = *it;
+    if (element.isParameter()) {
+      s += element.parameter() ? "true" : "false";
     } else {
-      s += get<shared_ptr<const BoolVar>>(at(i))->identifier();
+      s += element.var()->identifier();
     }
   }
   s += "]";
@@ -394,12 +397,12 @@ std::vector<shared_ptr<const IntVar>> IntVarArray::toVarVector(
     fznparser::Model& model) {
   std::vector<shared_ptr<const IntVar>> params;
   params.clear();
-  for (size_t i = 0; i < this->size(); ++i) {
-    if (std::holds_alternative<int64_t>((*this)[i])) {
-      params.emplace_back(shared_ptr<const IntVar>(
-          model.addIntVarPar(get<int64_t>((*this)[i]))));
+  for (const auto element : *this) {
+    if (element.isParameter()) {
+      params.emplace_back(
+          shared_ptr<const IntVar>(model.addIntVarPar(element.parameter())));
     } else {
-      params.emplace_back(get<shared_ptr<const IntVar>>((*this)[i]));
+      params.emplace_back(element.var());
     }
   }
   return params;
@@ -410,19 +413,17 @@ bool IntVarArray::operator==(const IntVarArray& other) const {
       annotations().size() != other.annotations().size()) {
     return false;
   }
-  for (size_t i = 0; i < size(); ++i) {
-    if (std::holds_alternative<int64_t>(at(i))) {
-      if (!std::holds_alternative<int64_t>(other.at(i)) ||
-          get<int64_t>(at(i)) != get<int64_t>(other.at(i))) {
-        return false;
-      }
+  for (auto it = begin(), otherIt = other.begin(); it != end();
+       ++it, ++otherIt) {
+    const auto element = *it;
+    const auto otherElement = *otherIt;
+    if (element.isParameter() != otherElement.isParameter()) {
+      return false;
     }
-    if (std::holds_alternative<shared_ptr<const IntVar>>(at(i))) {
-      if (!std::holds_alternative<shared_ptr<const IntVar>>(other.at(i)) ||
-          get<shared_ptr<const IntVar>>(at(i))->operator!=(
-              *get<shared_ptr<const IntVar>>(other.at(i)))) {
-        return false;
-      }
+    if (element.isParameter()
+            ? element.parameter() != otherElement.parameter()
+            : element.var()->operator!=(*otherElement.var())) {
+      return false;
     }
   }
   for (size_t i = 0; i < annotations().size(); ++i) {
@@ -443,14 +444,15 @@ std::string IntVarArray::toString() const {
           ? "["
           : ("array[1.." + std::to_string(size()) + "] of" +
              (isParArray() ? "" : " var") + " int: " + identifier() + " = [");
-  for (size_t i = 0; i < size(); ++i) {
-    if (i != 0) {
+  for (auto it = begin(); it != end(); ++it) {
+    if (it != begin()) {
       s += ", ";
     }
-    if (std::holds_alternative<int64_t>(at(i))) {
-      s += std::to_string(get<int64_t>(at(i)));
+    const auto element = *it;
+    if (element.isParameter()) {
+      s += std::to_string(element.parameter());
     } else {
-      s += get<shared_ptr<const IntVar>>(at(i))->identifier();
+      s += element.var()->identifier();
     }
   }
   s += "]";
@@ -470,12 +472,12 @@ std::vector<shared_ptr<const FloatVar>> FloatVarArray::toVarVector(
     fznparser::Model& model) {
   std::vector<shared_ptr<const FloatVar>> params;
   params.clear();
-  for (size_t i = 0; i < this->size(); ++i) {
-    if (std::holds_alternative<double>((*this)[i])) {
+  for (const auto element : *this) {
+    if (element.isParameter()) {
       params.emplace_back(shared_ptr<const FloatVar>(
-          model.addFloatVarPar(get<double>((*this)[i]))));
+          model.addFloatVarPar(element.parameter())));
     } else {
-      params.emplace_back(get<shared_ptr<const FloatVar>>((*this)[i]));
+      params.emplace_back(element.var());
     }
   }
   return params;
@@ -486,19 +488,17 @@ bool FloatVarArray::operator==(const FloatVarArray& other) const {
       annotations().size() != other.annotations().size()) {
     return false;
   }
-  for (size_t i = 0; i < size(); ++i) {
-    if (std::holds_alternative<double>(at(i))) {
-      if (!std::holds_alternative<double>(other.at(i)) ||
-          get<double>(at(i)) != get<double>(other.at(i))) {
-        return false;
-      }
+  for (auto it = begin(), otherIt = other.begin(); it != end();
+       ++it, ++otherIt) {
+    const auto element = *it;
+    const auto otherElement = *otherIt;
+    if (element.isParameter() != otherElement.isParameter()) {
+      return false;
     }
-    if (std::holds_alternative<shared_ptr<const FloatVar>>(at(i))) {
-      if (!std::holds_alternative<shared_ptr<const FloatVar>>(other.at(i)) ||
-          get<shared_ptr<const FloatVar>>(at(i))->operator!=(
-              *get<shared_ptr<const FloatVar>>(other.at(i)))) {
-        return false;
-      }
+    if (element.isParameter()
+            ? element.parameter() != otherElement.parameter()
+            : element.var()->operator!=(*otherElement.var())) {
+      return false;
     }
   }
   for (size_t i = 0; i < annotations().size(); ++i) {
@@ -519,14 +519,15 @@ std::string FloatVarArray::toString() const {
           ? "["
           : ("array[1.." + std::to_string(size()) + "] of" +
              (isParArray() ? "" : " var") + " float: " + identifier() + " = [");
-  for (size_t i = 0; i < size(); ++i) {
-    if (i != 0) {
+  for (auto it = begin(); it != end(); ++it) {
+    if (it != begin()) {
       s += ", ";
     }
-    if (std::holds_alternative<double>(at(i))) {
-      s += std::to_string(get<double>(at(i)));
+    const auto element = *it;
+    if (element.isParameter()) {
+      s += std::to_string(element.parameter());
     } else {
-      s += get<shared_ptr<const FloatVar>>(at(i))->identifier();
+      s += element.var()->identifier();
     }
   }
   s += "]";
@@ -546,12 +547,12 @@ std::vector<shared_ptr<const SetVar>> SetVarArray::toVarVector(
     fznparser::Model& model) {
   std::vector<shared_ptr<const SetVar>> params;
   params.clear();
-  for (size_t i = 0; i < this->size(); ++i) {
-    if (std::holds_alternative<IntSet>((*this)[i])) {
-      params.emplace_back(shared_ptr<const SetVar>(
-          model.addSetVarPar(get<IntSet>((*this)[i]))));
+  for (const auto element : *this) {
+    if (element.isParameter()) {
+      params.emplace_back(
+          shared_ptr<const SetVar>(model.addSetVarPar(element.parameter())));
     } else {
-      params.emplace_back(get<shared_ptr<const SetVar>>((*this)[i]));
+      params.emplace_back(element.var());
     }
   }
   return params;
@@ -562,19 +563,17 @@ bool SetVarArray::operator==(const SetVarArray& other) const {
       annotations().size() != other.annotations().size()) {
     return false;
   }
-  for (size_t i = 0; i < size(); ++i) {
-    if (std::holds_alternative<IntSet>(at(i))) {
-      if (!std::holds_alternative<IntSet>(other.at(i)) ||
-          get<IntSet>(at(i)).operator!=(get<IntSet>(other.at(i)))) {
-        return false;
-      }
+  for (auto it = begin(), otherIt = other.begin(); it != end();
+       ++it, ++otherIt) {
+    const auto element = *it;
+    const auto otherElement = *otherIt;
+    if (element.isParameter() != otherElement.isParameter()) {
+      return false;
     }
-    if (std::holds_alternative<shared_ptr<const SetVar>>(at(i))) {
-      if (!std::holds_alternative<shared_ptr<const SetVar>>(other.at(i)) ||
-          get<shared_ptr<const SetVar>>(at(i))->operator!=(
-              *get<shared_ptr<const SetVar>>(other.at(i)))) {
-        return false;
-      }
+    if (element.isParameter()
+            ? element.parameter() != otherElement.parameter()
+            : element.var()->operator!=(*otherElement.var())) {
+      return false;
     }
   }
   for (size_t i = 0; i < annotations().size(); ++i) {
@@ -595,14 +594,15 @@ std::string SetVarArray::toString() const {
                       : ("array[1.." + std::to_string(size()) + "] of" +
                          (isParArray() ? " int set" : " var set") + ": " +
                          identifier() + " = [");
-  for (size_t i = 0; i < size(); ++i) {
-    if (i != 0) {
+  for (auto it = begin(); it != end(); ++it) {
+    if (it != begin()) {
       s += ", ";
     }
-    if (std::holds_alternative<IntSet>(_vars.at(i))) {
-      s += get<IntSet>(_vars.at(i)).toString();
+    const auto element = *it;
+    if (element.isParameter()) {
+      s += element.parameter().toString();
     } else {
-      s += get<shared_ptr<const SetVar>>(_vars.at(i))->identifier();
+      s += element.var()->identifier();
     }
   }
   s += "]";
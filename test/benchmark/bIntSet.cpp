@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "fznparser/simd.hpp"
+#include "fznparser/types.hpp"
+
+namespace fznparser::benchmarks {
+
+/**
+ * @brief A domain like the time slots of a timetabling model, whose elements
+ * are too far apart to be stored as intervals or a bitset.
+ */
+std::vector<int64_t> sparseDomain(const size_t size) {
+  std::mt19937_64 generator(size);
+  std::uniform_int_distribution<int64_t> gap(2, 200);
+  std::vector<int64_t> domain;
+  domain.reserve(size);
+  int64_t element = 0;
+  for (size_t i = 0; i < size; ++i) {
+    element += gap(generator);
+    domain.push_back(element);
+  }
+  return domain;
+}
+
+/**
+ * @brief Values within the bounds of the domain, of which about half are in
+ * it.
+ */
+std::vector<int64_t> queries(const std::vector<int64_t>& domain,
+                             const size_t size, const bool sorted) {
+  std::mt19937_64 generator(size + 1);
+  std::uniform_int_distribution<size_t> index(0, domain.size() - 1);
+  std::uniform_int_distribution<int64_t> value(domain.front(), domain.back());
+  std::vector<int64_t> values;
+  values.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    values.push_back(i % 2 == 0 ? domain[index(generator)] : value(generator));
+  }
+  if (sorted) {
+    std::ranges::sort(values);
+  }
+  return values;
+}
+
+constexpr size_t numQueries = 1 << 12;
+
+void intSetContains(benchmark::State& state) {
+  const IntSet set(sparseDomain(state.range(0)));
+  const std::vector<int64_t> values =
+      queries(set.elements(), numQueries, false);
+  state.SetLabel(simd::instructionSet());
+  for (auto _ : state) {
+    size_t found = 0;
+    for (const int64_t value : values) {
+      found += set.contains(value) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+// the lookup that IntSet::contains used to do
+void binarySearchContains(benchmark::State& state) {
+  const std::vector<int64_t> domain = sparseDomain(state.range(0));
+  const std::vector<int64_t> values = queries(domain, numQueries, false);
+  for (auto _ : state) {
+    size_t found = 0;
+    for (const int64_t value : values) {
+      found += std::ranges::binary_search(domain, value) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+void intSetBatchContains(benchmark::State& state) {
+  const IntSet set(sparseDomain(state.range(0)));
+  const std::vector<int64_t> values =
+      queries(set.elements(), numQueries, state.range(1) != 0);
+  const std::unique_ptr<bool[]> results = std::make_unique<bool[]>(numQueries);
+  state.SetLabel(simd::instructionSet());
+  for (auto _ : state) {
+    set.contains(values, std::span<bool>(results.get(), numQueries));
+    benchmark::DoNotOptimize(results.get());
+  }
+  state.SetItemsProcessed(state.iterations() * numQueries);
+}
+
+void intSetEquality(benchmark::State& state) {
+  const IntSet set(sparseDomain(state.range(0)));
+  const IntSet copy(sparseDomain(state.range(0)));
+  state.SetLabel(simd::instructionSet());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set == copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// an element-by-element comparison, as IntSet::operator== meant to do
+void rangesEquality(benchmark::State& state) {
+  const std::vector<int64_t> domain = sparseDomain(state.range(0));
+  const std::vector<int64_t> copy = sparseDomain(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::ranges::equal(domain, copy));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// each element of the domain with the probability 1 / inverseProbability
+std::vector<int64_t> randomSubset(const std::vector<int64_t>& domain,
+                                  const int64_t inverseProbability) {
+  std::mt19937_64 generator(domain.size() + 2);
+  std::bernoulli_distribution keep(1.0 /
+                                   static_cast<double>(inverseProbability));
+  std::vector<int64_t> subset;
+  for (const int64_t element : domain) {
+    if (keep(generator)) {
+      subset.push_back(element);
+    }
+  }
+  return subset;
+}
+
+void intSetSubset(benchmark::State& state) {
+  const IntSet set(sparseDomain(state.range(0)));
+  const IntSet subset(randomSubset(set.elements(), state.range(1)));
+  state.SetLabel(simd::instructionSet());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(subset.isSubsetOf(set));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rangesIncludes(benchmark::State& state) {
+  const std::vector<int64_t> domain = sparseDomain(state.range(0));
+  const std::vector<int64_t> subset = randomSubset(domain, state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::ranges::includes(domain, subset));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(intSetContains)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(binarySearchContains)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(intSetBatchContains)
+    ->ArgsProduct({benchmark::CreateRange(1 << 8, 1 << 20, 16), {0, 1}});
+BENCHMARK(intSetEquality)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(rangesEquality)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(intSetSubset)
+    ->ArgsProduct({benchmark::CreateRange(1 << 8, 1 << 20, 16), {2, 64}});
+BENCHMARK(rangesIncludes)
+    ->ArgsProduct({benchmark::CreateRange(1 << 8, 1 << 20, 16), {2, 64}});
+
+}  // namespace fznparser::benchmarks
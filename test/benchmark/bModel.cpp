@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "./benchmarkData.hpp"
+#include "fznparser/model.hpp"
+#include "fznparser/parser.hpp"
+
+namespace fznparser::benchmarks {
+
+void modelToString(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  size_t bytes = 0;
+  for (auto _ : state) {
+    const std::string str = model.toString();
+    bytes = str.size();
+  }
+  // the bytes that are produced rather than consumed
+  setProcessed(state, numItems(model), bytes);
+}
+
+void modelDestruction(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::optional<Model> copy;
+    copy.emplace(parseFznString(fzn, {.useTokenizer = true}));
+    state.ResumeTiming();
+    copy.reset();
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+void occurrenceIndex(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  for (auto _ : state) {
+    const OccurrenceIndex index(model.vars(), model.constraints());
+    benchmark::DoNotOptimize(index.numOccurrences());
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+void definesVarGraph(benchmark::State& state, const std::string& fzn) {
+  const Model model =
+      parseFznString(fzn, {.useTokenizer = true, .buildOccurrenceIndex = true});
+  for (auto _ : state) {
+    const DefinesVarGraph graph(model.constraints(), model.occurrenceIndex());
+    benchmark::DoNotOptimize(graph.topologicalOrder().size());
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+void modelEquality(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  // the same constraints in reverse order, which are matched by hash
+  std::unordered_map<std::string, Var> vars = model.vars();
+  std::vector<Constraint> constraints(model.constraints().rbegin(),
+                                      model.constraints().rend());
+  SolveType solveType = model.solveType();
+  const Model reversed(std::move(vars), std::move(constraints),
+                       std::move(solveType));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(model == reversed);
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+// the lower bounds of the int variables in the arguments of the constraints,
+// read through the shared pointers of the model
+void argumentTraversal(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const Constraint& constraint : model.constraints()) {
+      for (const Arg& arg : constraint.arguments()) {
+        if (std::holds_alternative<IntArg>(arg)) {
+          const IntArg& intArg = std::get<IntArg>(arg);
+          sum += intArg.isParameter() ? 0 : intArg.var()->lowerBound();
+        } else if (std::holds_alternative<std::shared_ptr<IntVarArray>>(arg)) {
+          for (const auto element :
+               *std::get<std::shared_ptr<IntVarArray>>(arg)) {
+            sum += element.isParameter() ? 0 : element.var()->lowerBound();
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+// the same lower bounds, read through the handles of the pools
+void varPoolsTraversal(benchmark::State& state, const std::string& fzn) {
+  Model model = parseFznString(fzn, {.useTokenizer = true});
+  model.buildVarPools();
+  const VarPools& pools = model.varPools();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (uint32_t c = 0; c < pools.numConstraints(); ++c) {
+      for (const PooledArg& arg : pools.arguments(c)) {
+        if (std::holds_alternative<IntHandle>(arg)) {
+          const IntHandle handle = std::get<IntHandle>(arg);
+          sum += handle.isParameter() ? 0 : pools.var(handle).lowerBound();
+        } else if (std::holds_alternative<ArrayHandle<IntVarArray>>(arg)) {
+          for (const IntHandle handle :
+               pools.elements(std::get<ArrayHandle<IntVarArray>>(arg))) {
+            sum += handle.isParameter() ? 0 : pools.var(handle).lowerBound();
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+void buildVarPools(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  for (auto _ : state) {
+    const VarPools pools(model.vars(), model.constraints());
+    benchmark::DoNotOptimize(pools.numConstraints());
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+const bool modelToStringRegistered =
+    registerModelBenchmark("modelToString", modelToString);
+const bool modelDestructionRegistered =
+    registerModelBenchmark("modelDestruction", modelDestruction);
+const bool occurrenceIndexRegistered =
+    registerModelBenchmark("occurrenceIndex", occurrenceIndex);
+const bool definesVarGraphRegistered =
+    registerModelBenchmark("definesVarGraph", definesVarGraph);
+const bool modelEqualityRegistered =
+    registerModelBenchmark("modelEquality", modelEquality);
+const bool argumentTraversalRegistered =
+    registerModelBenchmark("argumentTraversal", argumentTraversal);
+const bool varPoolsTraversalRegistered =
+    registerModelBenchmark("varPoolsTraversal", varPoolsTraversal);
+const bool buildVarPoolsRegistered =
+    registerModelBenchmark("buildVarPools", buildVarPools);
+
+}  // namespace fznparser::benchmarks
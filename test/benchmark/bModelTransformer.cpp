@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "./benchmarkData.hpp"
+#include "fznparser/parser/descentParser.hpp"
+#include "fznparser/parser/grammarAst.hpp"
+#include "fznparser/transformer/modelTransformer.hpp"
+
+namespace fznparser::benchmarks {
+
+/**
+ * @brief Measures constructing the transformer, which replaces parameters
+ * and validates the declarations.
+ */
+void transformerConstruction(benchmark::State& state, const std::string& fzn) {
+  const parser::Model model = parser::DescentParser(fzn).model();
+  for (auto _ : state) {
+    state.PauseTiming();
+    parser::Model copy = model;
+    std::optional<ModelTransformer> transformer;
+    state.ResumeTiming();
+    transformer.emplace(std::move(copy));
+    state.PauseTiming();
+    transformer.reset();
+    state.ResumeTiming();
+  }
+  setProcessed(state, numItems(model), fzn.size());
+}
+
+/**
+ * @brief Measures generating the model from a constructed transformer, which
+ * transforms the variables, the constraints and the solve item.
+ */
+void generateModel(benchmark::State& state, const std::string& fzn) {
+  ModelTransformer transformer(parser::DescentParser(fzn).model());
+  int64_t items = 0;
+  for (auto _ : state) {
+    std::optional<Model> model;
+    model.emplace(transformer.generateModel());
+    state.PauseTiming();
+    items = numItems(model.value());
+    model.reset();
+    state.ResumeTiming();
+  }
+  setProcessed(state, items, fzn.size());
+}
+
+/**
+ * @brief Measures transforming the constraint items of a model, once all of
+ * its declarations have been added.
+ */
+void transformConstraints(benchmark::State& state, const std::string& fzn) {
+  const parser::Model model = parser::DescentParser(fzn).model();
+
+  ModelTransformer transformer;
+  for (parser::ParDeclItem parDeclItem : model.parDeclItems) {
+    transformer.addParDeclItem(std::move(parDeclItem));
+  }
+  for (parser::VarDeclItem varDeclItem : model.varDeclItems) {
+    transformer.addVarDeclItem(std::move(varDeclItem));
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    parser::ArenaVector<parser::ConstraintItem> constraintItems =
+        model.constraintItems;
+    state.ResumeTiming();
+    for (parser::ConstraintItem& constraintItem : constraintItems) {
+      benchmark::DoNotOptimize(
+          transformer.transformConstraintItem(std::move(constraintItem)));
+    }
+  }
+  setProcessed(state, static_cast<int64_t>(model.constraintItems.size()),
+               fzn.size());
+}
+
+const bool transformerConstructionRegistered =
+    registerModelBenchmark("transformerConstruction", transformerConstruction);
+const bool generateModelRegistered =
+    registerModelBenchmark("generateModel", generateModel);
+const bool transformConstraintsRegistered =
+    registerModelBenchmark("transformConstraints", transformConstraints);
+
+}  // namespace fznparser::benchmarks
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/spirit/home/x3.hpp>
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "./benchmarkData.hpp"
+#include "fznparser/except.hpp"
+#include "fznparser/parser/arena.hpp"
+#include "fznparser/parser/descentParser.hpp"
+#include "fznparser/parser/grammarDef.hpp"
+
+namespace fznparser::benchmarks {
+
+namespace x3 = boost::spirit::x3;
+
+/**
+ * @brief Measures parsing the FlatZinc into the AST with the X3 grammar. The
+ * AST is allocated from an arena like in parseFznString.
+ */
+void x3Parse(benchmark::State& state, const std::string& fzn) {
+  int64_t items = 0;
+  for (auto _ : state) {
+    parser::Arena arena(fzn.size());
+    const parser::Arena::Scope scope(arena);
+    parser::Model model;
+    auto first = fzn.begin();
+    if (!x3::phrase_parse(first, fzn.end(), parser::model, parser::skipper,
+                          model) ||
+        first != fzn.end()) {
+      throw FznException("Could not parse FlatZinc");
+    }
+    items = numItems(model);
+  }
+  setProcessed(state, items, fzn.size());
+}
+
+/**
+ * @brief Measures parsing the FlatZinc into the AST with the tokenizer and
+ * recursive-descent parser.
+ */
+void descentParse(benchmark::State& state, const std::string& fzn) {
+  int64_t items = 0;
+  for (auto _ : state) {
+    parser::Arena arena(fzn.size());
+    const parser::Arena::Scope scope(arena);
+    const parser::Model model = parser::DescentParser(fzn).model();
+    items = numItems(model);
+  }
+  setProcessed(state, items, fzn.size());
+}
+
+// the coefficients of a large float_lin_le, printed as the shortest literals
+// that round-trip, a quarter of them with exponents
+std::string floatCoefficients(const size_t size) {
+  std::mt19937_64 rng(size);
+  std::uniform_real_distribution<double> coefficient(-1000, 1000);
+  std::string fzn = "[";
+  for (size_t i = 0; i < size; ++i) {
+    const double value = i % 4 == 0 ? coefficient(rng) * 1e-9
+                                    : coefficient(rng);
+    char buffer[32];
+    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer),
+                                         value, std::chars_format::scientific);
+    fzn.append(i == 0 ? "" : ", ").append(buffer, ptr);
+  }
+  return fzn + "]";
+}
+
+template <class FloatParser>
+void floatArray(benchmark::State& state, const FloatParser& floatParser) {
+  const std::string fzn = floatCoefficients(state.range(0));
+  const auto array = x3::lit('[') >> (floatParser % ',') >> x3::lit(']');
+  for (auto _ : state) {
+    std::vector<double> coefficients;
+    auto first = fzn.begin();
+    if (!x3::phrase_parse(first, fzn.end(), array, parser::skipper,
+                          coefficients) ||
+        first != fzn.end()) {
+      throw FznException("Could not parse the float array");
+    }
+    benchmark::DoNotOptimize(coefficients.data());
+  }
+  setProcessed(state, state.range(0), fzn.size());
+}
+
+void floatLiteralArray(benchmark::State& state) {
+  floatArray(state, parser::float_literal);
+}
+
+// the real parser that float_literal used, which does not round correctly
+template <typename ValueType>
+struct StrictRealPolicies : x3::strict_real_policies<ValueType> {
+  static bool const allow_leading_dot = false;
+  static bool const allow_trailing_dot = false;
+};
+
+void x3RealArray(benchmark::State& state) {
+  floatArray(state, x3::real_parser<double, StrictRealPolicies<double>>{});
+}
+
+BENCHMARK(floatLiteralArray)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(x3RealArray)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+// the coefficients of a large int_lin_le, with a line break after every ten
+std::string intCoefficients(const size_t size) {
+  std::mt19937_64 rng(size);
+  std::uniform_int_distribution<int64_t> coefficient(-1000, 1000);
+  std::string fzn = "[";
+  for (size_t i = 0; i < size; ++i) {
+    fzn += i == 0 ? "" : i % 10 == 0 ? ",\n" : ", ";
+    fzn += std::to_string(coefficient(rng));
+  }
+  return fzn + "]";
+}
+
+template <class ArrayParser>
+void intArray(benchmark::State& state, const ArrayParser& arrayParser) {
+  const std::string fzn = intCoefficients(state.range(0));
+  for (auto _ : state) {
+    parser::Arena arena(fzn.size());
+    const parser::Arena::Scope scope(arena);
+    parser::ArrayLiteral literals;
+    auto first = fzn.begin();
+    if (!x3::phrase_parse(first, fzn.end(), arrayParser, parser::skipper,
+                          literals) ||
+        first != fzn.end()) {
+      throw FznException("Could not parse the int array");
+    }
+    benchmark::DoNotOptimize(literals.data());
+  }
+  setProcessed(state, state.range(0), fzn.size());
+}
+
+void arrayLiteralInts(benchmark::State& state) {
+  intArray(state, parser::array_literal);
+}
+
+// the element by element rule that array_literal used
+void elementwiseArrayInts(benchmark::State& state) {
+  intArray(state, x3::rule<struct elementwise_array, parser::ArrayLiteral>{
+                      "elementwise_array"} =
+                      x3::lit('[') >> -(parser::basic_expr % ',') >>
+                      x3::lit(']'));
+}
+
+BENCHMARK(arrayLiteralInts)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(elementwiseArrayInts)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+const bool x3ParseRegistered = registerModelBenchmark("x3Parse", x3Parse);
+const bool descentParseRegistered =
+    registerModelBenchmark("descentParse", descentParse);
+
+}  // namespace fznparser::benchmarks
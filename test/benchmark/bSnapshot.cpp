@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "./benchmarkData.hpp"
+#include "fznparser/model.hpp"
+#include "fznparser/parser.hpp"
+#include "fznparser/snapshot.hpp"
+
+namespace fznparser::benchmarks {
+
+std::string toSnapshot(const Model& model) {
+  std::stringstream ss;
+  writeSnapshot(model, ss);
+  return ss.str();
+}
+
+void snapshotWrite(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  size_t bytes = 0;
+  for (auto _ : state) {
+    const std::string snapshot = toSnapshot(model);
+    bytes = snapshot.size();
+  }
+  // the bytes that are produced rather than consumed
+  setProcessed(state, numItems(model), bytes);
+}
+
+void snapshotRead(benchmark::State& state, const std::string& fzn) {
+  const Model model = parseFznString(fzn, {.useTokenizer = true});
+  const std::string snapshot = toSnapshot(model);
+  for (auto _ : state) {
+    const Model loaded = readSnapshotString(snapshot);
+    benchmark::DoNotOptimize(loaded.numConstraints());
+  }
+  setProcessed(state, numItems(model), snapshot.size());
+}
+
+const bool snapshotWriteRegistered =
+    registerModelBenchmark("snapshotWrite", snapshotWrite);
+const bool snapshotReadRegistered =
+    registerModelBenchmark("snapshotRead", snapshotRead);
+
+}  // namespace fznparser::benchmarks
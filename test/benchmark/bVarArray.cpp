@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "fznparser/variables.hpp"
+
+namespace fznparser::benchmarks {
+
+// one variable for every 16 constants, like the coefficients and variables of
+// a large int_lin_le
+IntVarArray mostlyConstants(const size_t size) {
+  const auto var = std::make_shared<IntVar>(0, 10, "x");
+  IntVarArray array("array");
+  array.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (i % 16 == 0) {
+      array.append(var);
+    } else {
+      array.append(static_cast<int64_t>(i));
+    }
+  }
+  return array;
+}
+
+void varArrayAppend(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mostlyConstants(state.range(0)).size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void varArrayScan(benchmark::State& state) {
+  const IntVarArray array = mostlyConstants(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto element : array) {
+      sum += element.isParameter() ? element.parameter()
+                                   : element.var()->lowerBound();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// the elements as VarArrayTemplate used to store them
+void variantVectorScan(benchmark::State& state) {
+  const auto var = std::make_shared<const IntVar>(0, 10, "x");
+  std::vector<std::variant<int64_t, std::shared_ptr<const IntVar>>> array;
+  array.reserve(state.range(0));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    if (i % 16 == 0) {
+      array.emplace_back(var);
+    } else {
+      array.emplace_back(i);
+    }
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto& element : array) {
+      sum += std::holds_alternative<int64_t>(element)
+                 ? std::get<int64_t>(element)
+                 : std::get<std::shared_ptr<const IntVar>>(element)
+                       ->lowerBound();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(varArrayAppend)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(varArrayScan)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(variantVectorScan)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+}  // namespace fznparser::benchmarks
@@ -0,0 +1,74 @@
+#include "./benchmarkData.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "modelGenerator.hpp"
+
+namespace fznparser::benchmarks {
+
+const std::vector<std::string>& modelFiles() {
+  static const std::vector<std::string> files{
+      "car_sequencing.fzn", "magic_square.fzn", "n_queens.fzn",
+      "tsp_alldiff.fzn"};
+  return files;
+}
+
+const std::vector<size_t>& scaledSizes() {
+  static const std::vector<size_t> sizes{1000, 10000, 100000};
+  return sizes;
+}
+
+bool registerModelBenchmark(const std::string& name, const ModelBenchmark run) {
+  for (const std::string& file : modelFiles()) {
+    benchmark::RegisterBenchmark(
+        (name + "/" + file).c_str(),
+        [run, file](benchmark::State& state) { run(state, readModel(file)); })
+        ->Unit(benchmark::kMicrosecond);
+  }
+  for (const size_t numVars : scaledSizes()) {
+    benchmark::RegisterBenchmark(
+        (name + "/scaled_" + std::to_string(numVars)).c_str(),
+        [run, numVars](benchmark::State& state) {
+          run(state, scaledModel(numVars));
+        })
+        ->Unit(benchmark::kMillisecond);
+  }
+  return true;
+}
+
+std::string readModel(const std::string& filename) {
+  std::ifstream input(std::string(FZN_DIR) + "/" + filename);
+  return {std::istreambuf_iterator<char>(input),
+          std::istreambuf_iterator<char>()};
+}
+
+std::string scaledModel(const size_t numVars) {
+  return generator::generateModel(
+      {.numVars = numVars,
+       .numAliases = numVars / 10,
+       .numArrays = numVars / 100,
+       .numLinear = numVars,
+       .chainLength = numVars / 10,
+       .numAnnotatedVars = numVars / 2,
+       .numAnnotatedConstraints = numVars / 2});
+}
+
+int64_t numItems(const parser::Model& model) {
+  return static_cast<int64_t>(
+      model.predicateItems.size() + model.parDeclItems.size() +
+      model.varDeclItems.size() + model.constraintItems.size() + 1);
+}
+
+int64_t numItems(const Model& model) {
+  return static_cast<int64_t>(model.numVars() + model.numConstraints());
+}
+
+void setProcessed(benchmark::State& state, const int64_t items,
+                  const size_t bytes) {
+  state.SetItemsProcessed(state.iterations() * items);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+}  // namespace fznparser::benchmarks
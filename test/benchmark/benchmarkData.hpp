@@ -0,0 +1,48 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "fznparser/model.hpp"
+#include "fznparser/parser/grammarAst.hpp"
+
+namespace fznparser::benchmarks {
+
+using ModelBenchmark = void (*)(benchmark::State&, const std::string& fzn);
+
+/**
+ * @brief Registers the benchmark as "<name>/<model>" for every model in
+ * FZN_DIR and for scaled models of increasing size. The FlatZinc of a model
+ * is only read or generated when its benchmark runs.
+ *
+ * @return true, so that it can initialise a namespace-scope constant
+ */
+bool registerModelBenchmark(const std::string& name, ModelBenchmark);
+
+std::string readModel(const std::string& filename);
+
+/**
+ * @brief Generates a model with numVars int variables and as many linear
+ * constraints, plus aliases, arrays and a defines_var chain proportional to
+ * numVars.
+ */
+std::string scaledModel(size_t numVars);
+
+/**
+ * @return the number of items of the model, counting the solve item
+ */
+int64_t numItems(const parser::Model&);
+/**
+ * @return the number of variables and constraints of the model
+ */
+int64_t numItems(const Model&);
+
+/**
+ * @brief Reports the items and bytes processed per second, given the number
+ * processed per iteration.
+ */
+void setProcessed(benchmark::State&, int64_t items, size_t bytes);
+
+}  // namespace fznparser::benchmarks
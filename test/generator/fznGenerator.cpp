@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "./modelGenerator.hpp"
+
+using fznparser::generator::GeneratorOptions;
+
+void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program << " [--<option> <value>]...\n"
+      << "Writes a generated FlatZinc model to standard output. The same\n"
+      << "options always produce the same model.\n\n"
+      << "Options (default):\n"
+      << "  --seed (0)\n"
+      << "  --vars (1000)                  int variables\n"
+      << "  --domain-bound (1000)          domain -bound..bound of each var\n"
+      << "  --aliases (100)                variables equal to another one\n"
+      << "  --arrays (10)                  var arrays, each in an\n"
+      << "                                 all_different constraint\n"
+      << "  --array-size (100)\n"
+      << "  --linear (1000)                int_lin_le constraints\n"
+      << "  --linear-terms (10)            terms per int_lin_le constraint\n"
+      << "  --chain (100)                  length of the defines_var chain\n"
+      << "  --annotated-vars (100)         vars annotated with output_var\n"
+      << "  --annotated-constraints (100)  constraints annotated with "
+         "domain\n"
+      << "  --scale (1)                    multiplies all counts but the\n"
+      << "                                 array size and linear terms\n";
+}
+
+int main(int argc, char* argv[]) {
+  GeneratorOptions options;
+  size_t scale = 1;
+  const std::map<std::string, size_t*> counts{
+      {"--vars", &options.numVars},
+      {"--aliases", &options.numAliases},
+      {"--arrays", &options.numArrays},
+      {"--array-size", &options.arraySize},
+      {"--linear", &options.numLinear},
+      {"--linear-terms", &options.linearTerms},
+      {"--chain", &options.chainLength},
+      {"--annotated-vars", &options.numAnnotatedVars},
+      {"--annotated-constraints", &options.numAnnotatedConstraints},
+      {"--scale", &scale}};
+
+  for (int i = 1; i < argc; i += 2) {
+    const std::string option = argv[i];
+    if (i + 1 >= argc) {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    try {
+      if (option == "--seed") {
+        options.seed = std::stoull(argv[i + 1]);
+      } else if (option == "--domain-bound") {
+        options.domainBound = std::stoll(argv[i + 1]);
+      } else if (const auto count = counts.find(option);
+                 count != counts.end()) {
+        *count->second = std::stoull(argv[i + 1]);
+      } else {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    } catch (const std::logic_error&) {
+      std::cerr << "Invalid value for " << option << ": " << argv[i + 1]
+                << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (size_t* count :
+       {&options.numVars, &options.numAliases, &options.numArrays,
+        &options.numLinear, &options.chainLength, &options.numAnnotatedVars,
+        &options.numAnnotatedConstraints}) {
+    *count *= scale;
+  }
+
+  std::ios::sync_with_stdio(false);
+  fznparser::generator::generateModel(options, std::cout);
+  return std::cout.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
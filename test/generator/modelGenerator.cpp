@@ -0,0 +1,103 @@
+#include "./modelGenerator.hpp"
+
+#include <sstream>
+
+namespace fznparser::generator {
+
+uint64_t SplitMix64::next() {
+  uint64_t z = (_state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+uint64_t SplitMix64::below(const uint64_t bound) {
+  // the modulo bias is irrelevant for generating test data
+  return bound == 0 ? 0 : next() % bound;
+}
+
+int64_t SplitMix64::between(const int64_t lowerBound,
+                            const int64_t upperBound) {
+  const auto range = static_cast<uint64_t>(upperBound - lowerBound) + 1;
+  return lowerBound + static_cast<int64_t>(below(range));
+}
+
+void writeAnnotation(std::ostream& out, const bool annotate,
+                     const char* annotation) {
+  if (annotate) {
+    out << " :: " << annotation;
+  }
+}
+
+void generateModel(const GeneratorOptions& options, std::ostream& out) {
+  SplitMix64 rng(options.seed);
+  const auto randomVar = [&]() { return rng.below(options.numVars); };
+  const int64_t bound = options.domainBound;
+  const bool hasVars = options.numVars > 0;
+
+  out << "predicate fzn_all_different_int(array [int] of var int: x);\n";
+
+  for (size_t i = 0; i < options.numVars; ++i) {
+    out << "var " << -bound << ".." << bound << ": x" << i;
+    writeAnnotation(out, i < options.numAnnotatedVars, "output_var");
+    out << ";\n";
+  }
+  if (hasVars) {
+    for (size_t i = 0; i < options.numAliases; ++i) {
+      out << "var " << -bound << ".." << bound << ": a" << i << " = x"
+          << randomVar() << ";\n";
+    }
+  }
+  for (size_t i = 0; i < options.chainLength; ++i) {
+    out << "var int: y" << i << " :: is_defined_var;\n";
+  }
+  if (hasVars) {
+    for (size_t i = 0; i < options.numArrays; ++i) {
+      out << "array [1.." << options.arraySize << "] of var int: xs" << i
+          << " = [";
+      for (size_t j = 0; j < options.arraySize; ++j) {
+        out << (j == 0 ? "x" : ", x") << randomVar();
+      }
+      out << "];\n";
+    }
+  }
+
+  if (hasVars) {
+    for (size_t i = 0; i < options.numLinear; ++i) {
+      out << "constraint int_lin_le([";
+      for (size_t j = 0; j < options.linearTerms; ++j) {
+        out << (j == 0 ? "" : ", ") << rng.between(-10, 10);
+      }
+      out << "], [";
+      for (size_t j = 0; j < options.linearTerms; ++j) {
+        out << (j == 0 ? "x" : ", x") << randomVar();
+      }
+      out << "], " << rng.between(-bound, bound) << ")";
+      writeAnnotation(out, i < options.numAnnotatedConstraints, "domain");
+      out << ";\n";
+    }
+    for (size_t i = 0; i < options.numArrays; ++i) {
+      out << "constraint fzn_all_different_int(xs" << i << ");\n";
+    }
+  }
+  for (size_t i = 0; i < options.chainLength; ++i) {
+    // y<i> = y<i-1> + d, where y<-1> is a random x
+    out << "constraint int_lin_eq([1, -1], [";
+    if (i == 0) {
+      out << (hasVars ? "x" + std::to_string(randomVar()) : "0");
+    } else {
+      out << "y" << i - 1;
+    }
+    out << ", y" << i << "], " << rng.between(-10, 10) << ") :: defines_var(y"
+        << i << ");\n";
+  }
+  out << "solve satisfy;\n";
+}
+
+std::string generateModel(const GeneratorOptions& options) {
+  std::ostringstream out;
+  generateModel(options, out);
+  return std::move(out).str();
+}
+
+}  // namespace fznparser::generator
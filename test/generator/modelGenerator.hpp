@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace fznparser::generator {
+
+/**
+ * @brief A splitmix64 pseudo-random number generator. It is tiny, fast and,
+ * unlike the standard distributions, produces the same sequence on every
+ * platform.
+ */
+class SplitMix64 {
+  uint64_t _state;
+
+ public:
+  explicit SplitMix64(uint64_t seed) : _state(seed) {}
+
+  uint64_t next();
+  /**
+   * @return a number in [0, bound), or 0 if bound is 0
+   */
+  uint64_t below(uint64_t bound);
+  /**
+   * @return a number in [lowerBound, upperBound]
+   */
+  int64_t between(int64_t lowerBound, int64_t upperBound);
+};
+
+/**
+ * @brief The items of a generated model, which are all int variables and
+ * linear constraints over them.
+ */
+struct GeneratorOptions {
+  uint64_t seed{0};
+  // var -domainBound..domainBound: x<i>;
+  size_t numVars{1000};
+  int64_t domainBound{1000};
+  // var ...: a<i> = x<j>;
+  size_t numAliases{100};
+  // array [1..arraySize] of var int: xs<i> = [x<j>, ...];
+  size_t numArrays{10};
+  size_t arraySize{100};
+  // constraint int_lin_le([c, ...], [x<j>, ...], d);
+  size_t numLinear{1000};
+  size_t linearTerms{10};
+  // constraint int_lin_eq([1, -1], [y<i-1>, y<i>], d) :: defines_var(y<i>);
+  size_t chainLength{100};
+  // the number of variables annotated with output_var and of linear
+  // constraints annotated with domain
+  size_t numAnnotatedVars{100};
+  size_t numAnnotatedConstraints{100};
+};
+
+/**
+ * @brief Writes a valid FlatZinc model that only depends on the options.
+ */
+void generateModel(const GeneratorOptions&, std::ostream&);
+std::string generateModel(const GeneratorOptions&);
+
+}  // namespace fznparser::generator
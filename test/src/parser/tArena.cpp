@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+
+#include "fznparser/parser/arena.hpp"
+
+namespace fznparser::testing {
+
+using namespace fznparser::parser;
+
+TEST(arena, heap_without_scope) {
+  EXPECT_EQ(currentArena(), std::pmr::new_delete_resource());
+  const ArenaVector<int64_t> values{1, 2, 3};
+  EXPECT_EQ(values.get_allocator().resource(), std::pmr::new_delete_resource());
+}
+
+TEST(arena, nested_scopes) {
+  Arena outer;
+  Arena inner;
+  {
+    const Arena::Scope outerScope(outer);
+    EXPECT_EQ(currentArena(), outer.resource());
+    {
+      const Arena::Scope innerScope(inner);
+      EXPECT_EQ(currentArena(), inner.resource());
+      const ArenaVector<int64_t> values{1, 2, 3};
+      EXPECT_EQ(values.get_allocator().resource(), inner.resource());
+    }
+    EXPECT_EQ(currentArena(), outer.resource());
+  }
+  EXPECT_EQ(currentArena(), std::pmr::new_delete_resource());
+}
+
+TEST(arena, containers_keep_their_arena) {
+  Arena first;
+  Arena second;
+  ArenaVector<int64_t> values;
+  {
+    const Arena::Scope scope(first);
+    values = ArenaVector<int64_t>{1, 2, 3};
+  }
+  EXPECT_EQ(values.get_allocator().resource(), first.resource());
+
+  const Arena::Scope scope(second);
+  // moving takes the arena along, while copying allocates from the current
+  // arena
+  const ArenaVector<int64_t> moved(std::move(values));
+  EXPECT_EQ(moved.get_allocator().resource(), first.resource());
+  ArenaVector<int64_t> moveAssigned;
+  {
+    const Arena::Scope firstScope(first);
+    ArenaVector<int64_t> source{4, 5};
+    moveAssigned = std::move(source);
+  }
+  EXPECT_EQ(moveAssigned.get_allocator().resource(), first.resource());
+  const ArenaVector<int64_t> copy(moved);
+  EXPECT_EQ(copy.get_allocator().resource(), second.resource());
+  EXPECT_EQ(copy, moved);
+}
+
+}  // namespace fznparser::testing
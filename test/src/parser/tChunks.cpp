@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fznparser/parser/chunks.hpp"
+
+namespace fznparser::testing {
+
+using namespace fznparser::parser;
+
+std::string join(const std::vector<std::string_view>& chunks) {
+  std::string joined;
+  for (const std::string_view chunk : chunks) {
+    joined += chunk;
+  }
+  return joined;
+}
+
+TEST(chunks, split_at_items) {
+  const std::string fzn =
+      "var int: a;\nvar int: b;\nvar int: c;\nvar int: d;\nsolve satisfy;\n";
+  const std::vector<std::string_view> chunks = splitIntoChunks(fzn, 3, 1);
+  ASSERT_EQ(chunks.size(), 3);
+  for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+    EXPECT_EQ(chunks.at(i).back(), ';') << chunks.at(i);
+  }
+  EXPECT_EQ(join(chunks), fzn);
+}
+
+TEST(chunks, min_chunk_size) {
+  const std::string fzn = "var int: a;\nvar int: b;\nsolve satisfy;\n";
+  EXPECT_EQ(splitIntoChunks(fzn, 8, fzn.size()).size(), 1);
+  EXPECT_EQ(splitIntoChunks(fzn, 1, 1).size(), 1);
+  EXPECT_EQ(splitIntoChunks("", 4, 1).size(), 1);
+}
+
+TEST(chunks, strings_and_comments) {
+  const std::string fzn =
+      "% a; comment\n"
+      "var int: a :: ann(\"x;y\\\";z\");\n"
+      "solve satisfy;";
+  const std::vector<std::string_view> chunks = splitIntoChunks(fzn, 8, 1);
+  ASSERT_EQ(chunks.size(), 2);
+  EXPECT_EQ(chunks.front(), fzn.substr(0, fzn.find("solve") - 1));
+  EXPECT_EQ(join(chunks), fzn);
+}
+
+TEST(chunks, escaped_backslash) {
+  // the string literal ends after the escaped backslash
+  const std::string fzn =
+      "var int: a :: ann(\"x;\\\\\");\n"
+      "var int: b :: ann(\";\");\n"
+      "solve satisfy;";
+  const std::vector<std::string_view> chunks = splitIntoChunks(fzn, 8, 1);
+  ASSERT_EQ(chunks.size(), 3);
+  EXPECT_EQ(chunks.front(), fzn.substr(0, fzn.find('\n')));
+  EXPECT_EQ(join(chunks), fzn);
+}
+
+}  // namespace fznparser::testing
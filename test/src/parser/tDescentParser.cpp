@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <boost/spirit/home/x3.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "./../testData.hpp"
+#include "./expectEq.hpp"
+#include "fznparser/except.hpp"
+#include "fznparser/parser/descentParser.hpp"
+#include "fznparser/parser/grammarDef.hpp"
+#include "fznparser/parser/lexer.hpp"
+
+namespace fznparser::testing {
+
+using namespace fznparser::parser;
+
+namespace x3 = boost::spirit::x3;
+
+template <typename T, typename ItemParser>
+void testItemData(const vector<pair<vector<std::string>, T>> &data,
+                  const ItemParser &parseItem) {
+  for (const auto &[tokens, expected] : data) {
+    for (const std::string &p : padding()) {
+      const std::string input = flatten(tokens, p);
+      DescentParser descentParser(input);
+      const std::optional<T> actual = parseItem(descentParser);
+      ASSERT_TRUE(actual.has_value()) << ("\"" + input + "\"");
+      ASSERT_TRUE(descentParser.atEnd()) << ("\"" + input + "\"");
+      expect_eq(actual.value(), expected, input);
+      if (tokens.size() == 1) {
+        break;
+      }
+    }
+  }
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path);
+  EXPECT_TRUE(file.is_open()) << "Could not open file: " << path;
+  return std::string{std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>()};
+}
+
+// the X3 grammar is the reference implementation
+void expectSameAsX3(const std::string &path) {
+  const std::string content = readFile(path);
+  parser::Model expected;
+  auto iter = content.begin();
+  ASSERT_TRUE(x3::phrase_parse(iter, content.end(), parser::model,
+                               parser::skipper, expected))
+      << path;
+  ASSERT_TRUE(iter == content.end()) << path;
+  expect_eq(DescentParser(content).model(), expected, path);
+}
+
+TEST(lexer, tokens) {
+  Lexer lexer(
+      "x_1 :: -0x1F..0o17 1.5e3 2E-1 -3 \"a \\\" b\" % comment\n"
+      "[]{}(),;=:");
+  const std::vector<TokenKind> expectedKinds{
+      TokenKind::IDENTIFIER,    TokenKind::DOUBLE_COLON,
+      TokenKind::INT_LITERAL,   TokenKind::DOT_DOT,
+      TokenKind::INT_LITERAL,   TokenKind::FLOAT_LITERAL,
+      TokenKind::FLOAT_LITERAL, TokenKind::INT_LITERAL,
+      TokenKind::STRING_LITERAL, TokenKind::LEFT_BRACKET,
+      TokenKind::RIGHT_BRACKET, TokenKind::LEFT_BRACE,
+      TokenKind::RIGHT_BRACE,   TokenKind::LEFT_PAREN,
+      TokenKind::RIGHT_PAREN,   TokenKind::COMMA,
+      TokenKind::SEMICOLON,     TokenKind::EQUALS,
+      TokenKind::COLON,         TokenKind::END};
+  std::vector<Token> tokens;
+  for (const TokenKind kind : expectedKinds) {
+    EXPECT_EQ(lexer.token().kind, kind) << toString(kind);
+    tokens.push_back(lexer.token());
+    lexer.advance();
+  }
+  EXPECT_EQ(tokens.at(0).text, "x_1");
+  EXPECT_EQ(tokens.at(2).intValue, -31);
+  EXPECT_EQ(tokens.at(4).intValue, 15);
+  EXPECT_EQ(tokens.at(5).floatValue, 1500.0);
+  EXPECT_EQ(tokens.at(6).floatValue, 0.2);
+  EXPECT_EQ(tokens.at(7).intValue, -3);
+  EXPECT_EQ(tokens.at(8).text, "a \\\" b");
+  EXPECT_EQ(lexer.line(), 2);
+}
+
+TEST(lexer, escaped_backslash) {
+  // the string literal ends after the escaped backslash
+  Lexer lexer(R"("a\\" "b")");
+  EXPECT_EQ(lexer.token().text, R"(a\\)");
+  lexer.advance();
+  EXPECT_EQ(lexer.token().text, "b");
+}
+
+TEST(lexer, float_underflow) {
+  EXPECT_EQ(Lexer("1e-400").token().floatValue, 0.0);
+  EXPECT_TRUE(std::signbit(Lexer("-0.001e-400").token().floatValue));
+  EXPECT_EQ(Lexer("1e-310").token().floatValue, 1e-310);
+}
+
+TEST(lexer, invalid) {
+  EXPECT_THROW(Lexer("99999999999999999999"), FznException);
+  EXPECT_THROW(Lexer("\"unterminated"), FznException);
+  EXPECT_THROW(Lexer("."), FznException);
+  EXPECT_THROW(Lexer("- 1"), FznException);
+  EXPECT_THROW(Lexer("+1"), FznException);
+  EXPECT_THROW(Lexer("+-1"), FznException);
+  EXPECT_THROW(Lexer("1e400"), FznException);
+  EXPECT_THROW(Lexer("#"), FznException);
+}
+
+TEST(descent_parser, predicate_item) {
+  testItemData(predicate_item_data_pos(),
+               [](DescentParser &p) { return p.predicateItem(); });
+}
+
+TEST(descent_parser, par_decl_item) {
+  testItemData(par_decl_item_data_pos(),
+               [](DescentParser &p) { return p.parDeclItem(); });
+}
+
+TEST(descent_parser, var_decl_item) {
+  testItemData(var_decl_item_data_pos(),
+               [](DescentParser &p) { return p.varDeclItem(); });
+}
+
+TEST(descent_parser, constraint_item) {
+  testItemData(constraint_item_data_pos(),
+               [](DescentParser &p) { return p.constraintItem(); });
+}
+
+TEST(descent_parser, solve_item) {
+  testItemData(solve_item_data_pos(),
+               [](DescentParser &p) { return p.solveItem(); });
+}
+
+TEST(descent_parser, model) {
+  testItemData(model_data_pos(), [](DescentParser &p) {
+    return std::optional<parser::Model>{p.model()};
+  });
+}
+
+TEST(descent_parser, other_item_kind) {
+  DescentParser descentParser("constraint int_le(x, 1);\nsolve satisfy;");
+  EXPECT_FALSE(descentParser.predicateItem().has_value());
+  EXPECT_FALSE(descentParser.parDeclItem().has_value());
+  EXPECT_FALSE(descentParser.varDeclItem().has_value());
+  EXPECT_FALSE(descentParser.solveItem().has_value());
+  EXPECT_TRUE(descentParser.constraintItem().has_value());
+  EXPECT_TRUE(descentParser.solveItem().has_value());
+  EXPECT_TRUE(descentParser.atEnd());
+}
+
+TEST(descent_parser, invalid) {
+  for (const std::string input :
+       {"", "var int: x;", "var int: x\nsolve satisfy;",
+        "solve satisfy; var int: x;", "var 1..2.0: x;\nsolve satisfy;",
+        "constraint int_le(x, {1, 2.0});\nsolve satisfy;",
+        "array [2..3] of int: a = [1, 2];\nsolve satisfy;",
+        "solve optimize x;", "int: x = +-1;\nsolve satisfy;",
+        "float: x = +1.5;\nsolve satisfy;"}) {
+    EXPECT_THROW(DescentParser(input).model(), FznException)
+        << ("\"" + input + "\"");
+  }
+  try {
+    DescentParser("var int: x;\nvar int y;\nsolve satisfy;").model();
+    FAIL();
+  } catch (const FznException &e) {
+    EXPECT_NE(std::string(e.what()).find("line 2"), std::string::npos)
+        << e.what();
+  }
+}
+
+TEST(descent_parser, leading_underscore) {
+  // like the X3 grammar, only var-par-identifiers can start with an
+  // underscore
+  const parser::Model model =
+      DescentParser(
+          "int: _n = 1;\nvar int: _x;\narray [1..1] of var int: _xs = [_x];\n"
+          "constraint int_le(_x, _n);\nsolve minimize _x;")
+          .model();
+  EXPECT_EQ(model.parDeclItems.size(), 1);
+  EXPECT_EQ(model.varDeclItems.size(), 2);
+  for (const std::string input :
+       {"predicate _p(int: x);\nsolve satisfy;",
+        "predicate p(int: _x);\nsolve satisfy;",
+        "var int: x :: _output_var;\nsolve satisfy;",
+        "constraint _int_le(1, 2);\nsolve satisfy;"}) {
+    EXPECT_THROW(DescentParser(input).model(), FznException)
+        << ("\"" + input + "\"");
+  }
+}
+
+TEST(descent_parser, same_as_x3_on_stubs) {
+  for (const std::string name :
+       {"annotations", "comments", "constraints", "maximize_objective",
+        "minimize_objective", "parameters", "predicates", "satisfy_empty",
+        "variable_arrays", "variables"}) {
+    expectSameAsX3(std::string(STUB_DIR) + "/" + name + ".fzn");
+  }
+}
+
+TEST(descent_parser, same_as_x3_on_models) {
+  for (const auto &entry : std::filesystem::directory_iterator(FZN_DIR)) {
+    if (entry.path().extension() == ".fzn") {
+      expectSameAsX3(entry.path().string());
+    }
+  }
+}
+
+}  // namespace fznparser::testing
@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <bit>
 #include <boost/spirit/home/x3.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
+#include <random>
 #include <regex>
 #include <string>
 #include <unordered_map>
@@ -48,6 +53,28 @@ namespace x3 = boost::spirit::x3;
 TEST(int_literal_test, test_data) { create_rule_test(int64_t, int_literal); }
 
 TEST(float_literal_test, test_data) { create_rule_test(double, float_literal); }
+TEST(float_literal_test, round_trip) {
+  std::mt19937_64 rng(0);
+  for (int i = 0; i < 100000; ++i) {
+    const auto bits = rng();
+    const double expected = std::bit_cast<double>(bits);
+    if (!std::isfinite(expected)) {
+      continue;
+    }
+    char buffer[32];
+    const auto [ptr, ec] =
+        std::to_chars(buffer, buffer + sizeof(buffer), expected,
+                      std::chars_format::scientific);
+    const std::string input(buffer, ptr);
+    double actual;
+    auto iter = input.begin();
+    ASSERT_TRUE(x3::phrase_parse(iter, input.end(), float_literal,
+                                 parser::skipper, actual))
+        << input;
+    ASSERT_TRUE(iter == input.end()) << input;
+    EXPECT_EQ(std::bit_cast<uint64_t>(actual), bits) << input;
+  }
+}
 TEST(identifier_test, test_data) { create_rule_test(std::string, identifier); }
 TEST(var_par_identifier_test, test_data) {
   create_rule_test(std::string, var_par_identifier);
@@ -165,6 +192,65 @@ TEST(basic_expr_test, manual) {
 TEST(array_literal_test, test_data) {
   create_rule_test(ArrayLiteral, array_literal);
 }
+TEST(array_literal_test, int_runs) {
+  // the element by element rules that the array rules used
+  const auto arrayReference = rule<struct array_reference, ArrayLiteral>{
+      "array_reference"} = lit('[') >> -(basic_expr % ',') >> lit(']');
+  const auto parArrayReference =
+      rule<struct par_array_reference, ParArrayLiteral>{
+          "par_array_reference"} =
+          lit('[') >> -(basic_literal_expr % ',') >> lit(']');
+  const std::vector<std::string> others{
+      "x",    "true", "1..3", "1 .. 3", "1.5",    "-2e3",
+      "0x1F", "-0o7", "{}",   "{1, 2}", "7 % c\n", "-9223372036854775808"};
+  std::mt19937_64 generator(4);
+  std::uniform_int_distribution<int64_t> value(-1000000, 1000000);
+  std::uniform_int_distribution<size_t> other(0, others.size() - 1);
+  std::bernoulli_distribution isOther(0.02);
+  for (const size_t size : {0, 1, 2, 100, 1000, 5000}) {
+    std::string input = "[";
+    for (size_t i = 0; i < size; ++i) {
+      input += i == 0 ? "" : i % 10 == 0 ? ",\n  " : ", ";
+      input += isOther(generator) ? others[other(generator)]
+                                  : std::to_string(value(generator));
+    }
+    input += "]";
+    for (const std::string &candidate : {input, input.substr(1),
+                                         input.substr(0, input.size() - 1),
+                                         input.substr(0, input.size() / 2)}) {
+      ArrayLiteral actual;
+      ArrayLiteral expected;
+      auto iter = candidate.begin();
+      auto expectedIter = candidate.begin();
+      const bool parsed = x3::phrase_parse(iter, candidate.end(), array_literal,
+                                           parser::skipper, actual);
+      ASSERT_EQ(parsed,
+                x3::phrase_parse(expectedIter, candidate.end(), arrayReference,
+                                 parser::skipper, expected))
+          << candidate;
+      ASSERT_TRUE(parsed || candidate != input) << candidate;
+      if (parsed) {
+        ASSERT_TRUE(iter == expectedIter) << candidate;
+        expect_eq(actual, expected, candidate);
+      }
+      ParArrayLiteral parActual;
+      ParArrayLiteral parExpected;
+      iter = candidate.begin();
+      expectedIter = candidate.begin();
+      const bool parParsed =
+          x3::phrase_parse(iter, candidate.end(), par_array_literal,
+                           parser::skipper, parActual);
+      ASSERT_EQ(parParsed, x3::phrase_parse(expectedIter, candidate.end(),
+                                            parArrayReference, parser::skipper,
+                                            parExpected))
+          << candidate;
+      if (parParsed) {
+        ASSERT_TRUE(iter == expectedIter) << candidate;
+        expect_eq(parActual, parExpected, candidate);
+      }
+    }
+  }
+}
 TEST(expr_test, test_data) { create_rule_test(Expr, expr); }
 TEST(expr_test, manual) {
   std::string input = " information ";
@@ -263,11 +349,11 @@ TEST(model, manual) {
   ASSERT_TRUE(iter == input.end()) << ("\"" + input + "\"");
   expect_eq(
       actual,
-      parser::Model{std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-                    std::vector<VarDeclItem>{BasicVarDecl{
+      parser::Model{ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+                    ArenaVector<VarDeclItem>{BasicVarDecl{
                         BasicVarIntTypeUnbounded{}, std::string{"a"},
                         Annotations{}, std::optional<BasicExpr>{}}},
-                    std::vector<ConstraintItem>{},
+                    ArenaVector<ConstraintItem>{},
                     SolveItem{SolveSatisfy{Annotations{}}}},
       input);
 }
@@ -298,7 +384,7 @@ TEST(predicate_item, manual) {
   ASSERT_TRUE(iter == input.end()) << ("\"" + input + "\"");
   expect_eq(actual,
             PredicateItem{std::string{"pred"},
-                          std::vector<PredParam>{PredParam{
+                          ArenaVector<PredParam>{PredParam{
                               PredParamType{BasicVarIntTypeUnbounded{}},
                               std::string{"a"}}}},
             input);
@@ -314,13 +400,13 @@ TEST(predicate_item, manual_model) {
       << ("\"" + input + "\"");
   ASSERT_TRUE(iter == input.end()) << ("\"" + input + "\"");
   expect_eq(actual,
-            Model{std::vector<PredicateItem>{PredicateItem{
+            Model{ArenaVector<PredicateItem>{PredicateItem{
                       std::string{"pred"},
-                      std::vector<PredParam>{
+                      ArenaVector<PredParam>{
                           PredParam{PredParamType{BasicVarIntTypeUnbounded{}},
                                     std::string{"a"}}}}},
-                  std::vector<ParDeclItem>{}, std::vector<VarDeclItem>{},
-                  std::vector<ConstraintItem>{},
+                  ArenaVector<ParDeclItem>{}, ArenaVector<VarDeclItem>{},
+                  ArenaVector<ConstraintItem>{},
                   SolveItem{SolveSatisfy{Annotations{}}}},
             input);
 }
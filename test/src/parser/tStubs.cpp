@@ -51,11 +51,11 @@ TEST(stubs, annotations) {
   test_stub(
       "annotations.fzn",
       parser::Model{
-          std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-          std::vector<VarDeclItem>{
+          ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+          ArenaVector<VarDeclItem>{
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"a"},
                            Annotations{Annotation{std::string{"output_var"},
-                                                  std::vector<AnnExpr>{}}},
+                                                  ArenaVector<AnnExpr>{}}},
                            std::optional<BasicExpr>{std::nullopt}},
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"b"},
                            Annotations{},
@@ -71,19 +71,19 @@ TEST(stubs, annotations) {
                   std::string{"arr"},
                   Annotations{
                       Annotation{std::string{"output_array"},
-                                 std::vector<AnnExpr>{std::vector<BasicAnnExpr>{
+                                 ArenaVector<AnnExpr>{ArenaVector<BasicAnnExpr>{
                                      IntSetLiteralBounded{1, 2},
                                      IntSetLiteralBounded{1, 2}}}}},
                   ArrayLiteral{std::string{"b"}, std::string{"c"},
                                std::string{"c"}, std::string{"d"}}}},
-          std::vector<ConstraintItem>{ConstraintItem{
+          ArenaVector<ConstraintItem>{ConstraintItem{
               std::string{"int_plus"},
-              std::vector<Expr>{std::string{"a"}, std::string{"b"},
+              ArenaVector<Expr>{std::string{"a"}, std::string{"b"},
                                 std::string{"c"}},
               Annotations{Annotation{
                   std::string{"defines_var"},
-                  std::vector<AnnExpr>{std::vector<BasicAnnExpr>{
-                      Annotation{std::string{"c"}, std::vector<AnnExpr>{}}}}}}
+                  ArenaVector<AnnExpr>{ArenaVector<BasicAnnExpr>{
+                      Annotation{std::string{"c"}, ArenaVector<AnnExpr>{}}}}}}
 
           }},
           SolveSatisfy{}});
@@ -93,11 +93,11 @@ TEST(stubs, constraints) {
   test_stub(
       "constraints.fzn",
       parser::Model{
-          std::vector<PredicateItem>{},
-          std::vector<ParDeclItem>{ParDeclItem{
+          ArenaVector<PredicateItem>{},
+          ArenaVector<ParDeclItem>{ParDeclItem{
               BasicParTypeArray{{2}, BasicParType::INT}, std::string{"coeffs"},
               ParExpr{ParArrayLiteral{int64_t{1}, int64_t{-1}}}}},
-          std::vector<VarDeclItem>{
+          ArenaVector<VarDeclItem>{
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"v1"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
@@ -144,21 +144,21 @@ TEST(stubs, constraints) {
                                std::string{"X_INTRODUCED_2060_"},
                                std::string{"X_INTRODUCED_2146_"},
                                std::string{"X_INTRODUCED_2232_"}}}},
-          std::vector<ConstraintItem>{
+          ArenaVector<ConstraintItem>{
               ConstraintItem{std::string{"int_lin_eq"},
-                             std::vector<Expr>{std::string{"coeffs"},
+                             ArenaVector<Expr>{std::string{"coeffs"},
                                                ArrayLiteral{std::string{"v1"},
                                                             std::string{"v2"}},
                                                int64_t{2}},
                              Annotations{}},
               ConstraintItem{std::string{"set_in"},
-                             std::vector<Expr>{
+                             ArenaVector<Expr>{
                                  std::string{"v1"},
-                                 IntSetLiteralSet{std::vector<int64_t>{1, 4}}},
+                                 IntSetLiteralSet{ArenaVector<int64_t>{1, 4}}},
                              Annotations{}},
               ConstraintItem{
                   std::string{"array_int_minimum"},
-                  std::vector<Expr>{std::string{"X_INTRODUCED_2233_"},
+                  ArenaVector<Expr>{std::string{"X_INTRODUCED_2233_"},
                                     std::string{"information"}},
                   Annotations{}}},
           SolveSatisfy{}});
@@ -167,11 +167,11 @@ TEST(stubs, constraints) {
 TEST(stubs, maximize_objective) {
   test_stub(
       "maximize_objective.fzn",
-      parser::Model{std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-                    std::vector<VarDeclItem>{BasicVarDecl{
+      parser::Model{ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+                    ArenaVector<VarDeclItem>{BasicVarDecl{
                         BasicVarIntTypeUnbounded{}, std::string{"a"},
                         Annotations{}, std::optional<BasicExpr>{std::nullopt}}},
-                    std::vector<ConstraintItem>{},
+                    ArenaVector<ConstraintItem>{},
                     SolveOptimize{Annotations{}, OptimizationType::MAXIMIZE,
                                   BasicExpr{std::string{"a"}}}});
 }
@@ -179,11 +179,11 @@ TEST(stubs, maximize_objective) {
 TEST(stubs, minimize_objective) {
   test_stub(
       "minimize_objective.fzn",
-      parser::Model{std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-                    std::vector<VarDeclItem>{BasicVarDecl{
+      parser::Model{ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+                    ArenaVector<VarDeclItem>{BasicVarDecl{
                         BasicVarIntTypeUnbounded{}, std::string{"a"},
                         Annotations{}, std::optional<BasicExpr>{std::nullopt}}},
-                    std::vector<ConstraintItem>{},
+                    ArenaVector<ConstraintItem>{},
                     SolveOptimize{Annotations{}, OptimizationType::MINIMIZE,
                                   BasicExpr{std::string{"a"}}}});
 }
@@ -192,8 +192,8 @@ TEST(stubs, parameters) {
   test_stub(
       "parameters.fzn",
       parser::Model{
-          std::vector<PredicateItem>{},
-          std::vector<ParDeclItem>{
+          ArenaVector<PredicateItem>{},
+          ArenaVector<ParDeclItem>{
               ParDeclItem{BasicParType::INT, std::string{"n"},
                           ParExpr{int64_t{4}}},
               ParDeclItem{BasicParType::BOOL, std::string{"bF"},
@@ -210,15 +210,15 @@ TEST(stubs, parameters) {
                                                   bool{true}}}},
               ParDeclItem{
                   BasicParType::SET_OF_INT, std::string{"explicitSet"},
-                  ParExpr{IntSetLiteralSet{std::vector<int64_t>{1, 4, 5}}}},
+                  ParExpr{IntSetLiteralSet{ArenaVector<int64_t>{1, 4, 5}}}},
               ParDeclItem{BasicParType::SET_OF_INT, std::string{"intervalSet"},
                           ParExpr{IntSetLiteralBounded{1, 10}}},
               ParDeclItem{BasicParTypeArray{{2}, BasicParType::SET_OF_INT},
                           std::string{"sets"},
                           ParExpr{ParArrayLiteral{
-                              IntSetLiteralSet{std::vector<int64_t>{4, 50, 55}},
+                              IntSetLiteralSet{ArenaVector<int64_t>{4, 50, 55}},
                               IntSetLiteralBounded{1, 10}}}}},
-          std::vector<VarDeclItem>{}, std::vector<ConstraintItem>{},
+          ArenaVector<VarDeclItem>{}, ArenaVector<ConstraintItem>{},
           SolveSatisfy{}});
 }
 
@@ -226,26 +226,26 @@ TEST(stubs, predicates) {
   test_stub(
       "predicates.fzn",
       parser::Model{
-          std::vector<PredicateItem>{
-              PredicateItem{"pred", std::vector<PredParam>{}},
+          ArenaVector<PredicateItem>{
+              PredicateItem{"pred", ArenaVector<PredParam>{}},
               PredicateItem{"pred_1",
-                            std::vector<PredParam>{PredParam{
+                            ArenaVector<PredParam>{PredParam{
                                 BasicVarIntTypeUnbounded{}, std::string{"a"}}}},
               PredicateItem{
                   "int_eq_imp",
-                  std::vector<PredParam>{
+                  ArenaVector<PredParam>{
                       PredParam{BasicVarIntTypeUnbounded{}, std::string{"a"}},
                       PredParam{BasicVarIntTypeUnbounded{}, std::string{"b"}},
                       PredParam{BasicVarBoolType{}, std::string{"r"}}}}},
-          std::vector<ParDeclItem>{}, std::vector<VarDeclItem>{},
-          std::vector<ConstraintItem>{}, SolveSatisfy{}});
+          ArenaVector<ParDeclItem>{}, ArenaVector<VarDeclItem>{},
+          ArenaVector<ConstraintItem>{}, SolveSatisfy{}});
 }
 
 TEST(stubs, satisfy_empty) {
   test_stub(
       "satisfy_empty.fzn",
-      parser::Model{std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-                    std::vector<VarDeclItem>{}, std::vector<ConstraintItem>{},
+      parser::Model{ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+                    ArenaVector<VarDeclItem>{}, ArenaVector<ConstraintItem>{},
                     SolveSatisfy{}});
 }
 
@@ -253,8 +253,8 @@ TEST(stubs, variable_arrays) {
   test_stub(
       "variable_arrays.fzn",
       parser::Model{
-          std::vector<PredicateItem>{}, std::vector<ParDeclItem>{},
-          std::vector<VarDeclItem>{
+          ArenaVector<PredicateItem>{}, ArenaVector<ParDeclItem>{},
+          ArenaVector<VarDeclItem>{
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"v1"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
@@ -272,23 +272,23 @@ TEST(stubs, variable_arrays) {
                   ArrayVarType{IndexSet{3}, BasicVarBoolType{}},
                   std::string{"array2"}, Annotations{},
                   ArrayLiteral{std::string{"v3"}, bool{true}, bool{false}}}},
-          std::vector<ConstraintItem>{}, SolveSatisfy{}});
+          ArenaVector<ConstraintItem>{}, SolveSatisfy{}});
 }
 
 TEST(stubs, variables) {
   test_stub(
       "variables.fzn",
       parser::Model{
-          std::vector<PredicateItem>{},
-          std::vector<ParDeclItem>{ParDeclItem{
+          ArenaVector<PredicateItem>{},
+          ArenaVector<ParDeclItem>{ParDeclItem{
               BasicParType::INT, std::string{"n"}, ParExpr{int64_t{3}}}},
-          std::vector<VarDeclItem>{
+          ArenaVector<VarDeclItem>{
               BasicVarDecl{BasicVarBoolType{}, std::string{"v1"}, Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
               BasicVarDecl{BasicVarIntTypeBounded{0, 5}, std::string{"v2"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
-              BasicVarDecl{BasicVarIntTypeSet{std::vector<int64_t>{3, 5, 10}},
+              BasicVarDecl{BasicVarIntTypeSet{ArenaVector<int64_t>{3, 5, 10}},
                            std::string{"v3"}, Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
               BasicVarDecl{BasicVarIntTypeBounded{1, 5}, std::string{"v4"},
@@ -299,23 +299,23 @@ TEST(stubs, variables) {
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"v6"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}}},
-          std::vector<ConstraintItem>{}, SolveSatisfy{}});
+          ArenaVector<ConstraintItem>{}, SolveSatisfy{}});
 }
 
 TEST(stubs, comments) {
   test_stub(
       "comments.fzn",
       parser::Model{
-          std::vector<PredicateItem>{},
-          std::vector<ParDeclItem>{ParDeclItem{
+          ArenaVector<PredicateItem>{},
+          ArenaVector<ParDeclItem>{ParDeclItem{
               BasicParType::INT, std::string{"n"}, ParExpr{int64_t{3}}}},
-          std::vector<VarDeclItem>{
+          ArenaVector<VarDeclItem>{
               BasicVarDecl{BasicVarBoolType{}, std::string{"v1"}, Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
               BasicVarDecl{BasicVarIntTypeBounded{0, 5}, std::string{"v2"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
-              BasicVarDecl{BasicVarIntTypeSet{std::vector<int64_t>{3, 5, 10}},
+              BasicVarDecl{BasicVarIntTypeSet{ArenaVector<int64_t>{3, 5, 10}},
                            std::string{"v3"}, Annotations{},
                            std::optional<BasicExpr>{std::nullopt}},
               BasicVarDecl{BasicVarIntTypeBounded{1, 5}, std::string{"v4"},
@@ -326,7 +326,7 @@ TEST(stubs, comments) {
               BasicVarDecl{BasicVarIntTypeUnbounded{}, std::string{"v6"},
                            Annotations{},
                            std::optional<BasicExpr>{std::nullopt}}},
-          std::vector<ConstraintItem>{}, SolveSatisfy{}});
+          ArenaVector<ConstraintItem>{}, SolveSatisfy{}});
 }
 
 }  // namespace fznparser::testing
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "fznparser/arguments.hpp"
+#include "fznparser/model.hpp"
+
+namespace fznparser::testing {
+
+TEST(arguments, compact) {
+  EXPECT_LE(sizeof(BoolArg), 24);
+  EXPECT_LE(sizeof(IntArg), 24);
+  EXPECT_LE(sizeof(FloatArg), 24);
+  EXPECT_LE(sizeof(IntSetArg), 24);
+  EXPECT_LE(sizeof(Arg), 32);
+}
+
+TEST(arguments, int_set_arg) {
+  const IntSetArg parameter(IntSet(std::vector<int64_t>{1, 4}));
+  ASSERT_TRUE(parameter.isParameter());
+  EXPECT_TRUE(parameter.isFixed());
+  EXPECT_EQ(parameter.parameter(), IntSet(std::vector<int64_t>{1, 4}));
+  EXPECT_EQ(&parameter.toParameter(), &parameter.parameter());
+  EXPECT_THROW(static_cast<void>(parameter.var()), FznException);
+
+  // copies share the set
+  const IntSetArg copy = parameter;
+  EXPECT_EQ(&copy.parameter(), &parameter.parameter());
+  EXPECT_EQ(copy, parameter);
+
+  Model model;
+  const std::shared_ptr<const SetVar> par = parameter.toVar(model);
+  EXPECT_EQ(par->upperBound(), parameter.parameter());
+  // the set variable is only created once, also for copies
+  EXPECT_EQ(parameter.toVar(model), par);
+  EXPECT_EQ(copy.toVar(model), par);
+  Model other;
+  EXPECT_EQ(copy.toVar(other), par);
+
+  const IntSetArg var(std::make_shared<const SetVar>(1, 4, "s"));
+  ASSERT_FALSE(var.isParameter());
+  EXPECT_FALSE(var.isFixed());
+  EXPECT_EQ(var.toVar(model), var.var());
+  EXPECT_THROW(static_cast<void>(var.parameter()), FznException);
+  EXPECT_NE(var, parameter);
+}
+
+TEST(arguments, int_set_arg_to_var_from_threads) {
+  const IntSetArg parameter(IntSet(std::vector<int64_t>{1, 4}));
+  std::vector<Model> models(4);
+  std::vector<std::shared_ptr<const SetVar>> vars(models.size());
+  {
+    std::vector<std::jthread> threads;
+    for (size_t i = 0; i < models.size(); ++i) {
+      threads.emplace_back([&, i] {
+        const IntSetArg copy = parameter;
+        vars[i] = copy.toVar(models[i]);
+      });
+    }
+  }
+  for (const std::shared_ptr<const SetVar>& var : vars) {
+    EXPECT_EQ(var, vars.front());
+  }
+}
+
+TEST(arguments, float_set_arg) {
+  const Arg arg(std::make_shared<FloatSet>(0.5, 1.5));
+  const Arg same(std::make_shared<FloatSet>(0.5, 1.5));
+  const Arg other(std::make_shared<FloatSet>(0.5, 2.5));
+  EXPECT_FALSE(arg.isArray());
+  EXPECT_EQ(arg, same);
+  EXPECT_EQ(arg.hash(), same.hash());
+  EXPECT_NE(arg, other);
+  EXPECT_EQ(arg.toString(), FloatSet(0.5, 1.5).toString());
+}
+
+}  // namespace fznparser::testing
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "fznparser/parser.hpp"
+
+namespace fznparser::testing {
+
+std::vector<uint32_t> toVector(const std::span<const uint32_t> span) {
+  return {span.begin(), span.end()};
+}
+
+TEST(definesVarGraph, topological_order) {
+  Model model = parseFznString(
+      "var 1..9: a;\n"
+      "var 1..9: b :: is_defined_var;\n"
+      "var 1..9: c :: is_defined_var;\n"
+      "var 1..9: d :: is_defined_var;\n"
+      "constraint int_plus(c, b, d) :: defines_var(d);\n"
+      "constraint int_plus(b, a, c) :: defines_var(c);\n"
+      "constraint int_le(c, d);\n"
+      "constraint int_plus(a, a, b) :: defines_var(b);\n"
+      "solve satisfy;\n");
+  model.buildDefinesVarGraph();
+  const DefinesVarGraph& graph = model.definesVarGraph();
+  EXPECT_EQ(graph.numDefiningConstraints(), 3);
+  EXPECT_EQ(toVector(graph.successors(3)), (std::vector<uint32_t>{0, 1}));
+  EXPECT_EQ(toVector(graph.successors(1)), std::vector<uint32_t>{0});
+  EXPECT_TRUE(graph.successors(0).empty());
+  EXPECT_TRUE(graph.successors(2).empty());
+  EXPECT_THROW(static_cast<void>(graph.successors(4)), FznException);
+
+  EXPECT_EQ(toVector(graph.topologicalOrder()),
+            (std::vector<uint32_t>{3, 1, 0}));
+  EXPECT_FALSE(graph.hasCycle());
+}
+
+TEST(definesVarGraph, cycles) {
+  Model model = parseFznString(
+      "var 1..9: w;\n"
+      "var 1..9: x :: is_defined_var;\n"
+      "var 1..9: y :: is_defined_var;\n"
+      "var 1..9: z :: is_defined_var;\n"
+      "var 1..9: v :: is_defined_var;\n"
+      "constraint int_plus(y, w, x) :: defines_var(x);\n"
+      "constraint int_plus(x, w, y) :: defines_var(y);\n"
+      "constraint int_plus(x, w, z) :: defines_var(z);\n"
+      "constraint int_plus(w, w, v) :: defines_var(v);\n"
+      "solve satisfy;\n");
+  model.buildDefinesVarGraph();
+  const DefinesVarGraph& graph = model.definesVarGraph();
+  EXPECT_TRUE(graph.hasCycle());
+  // the constraint defining z is not on the cycle, but depends on it
+  EXPECT_EQ(toVector(graph.cyclicConstraints()),
+            (std::vector<uint32_t>{0, 1, 2}));
+  EXPECT_EQ(toVector(graph.topologicalOrder()), std::vector<uint32_t>{3});
+}
+
+TEST(definesVarGraph, orders_models) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    Model model = parseFznFile(filename, {.buildOccurrenceIndex = true});
+    model.buildDefinesVarGraph();
+    const DefinesVarGraph& graph = model.definesVarGraph();
+    EXPECT_FALSE(graph.hasCycle()) << filename;
+    EXPECT_EQ(graph.topologicalOrder().size(), graph.numDefiningConstraints())
+        << filename;
+    std::vector<bool> ordered(model.numConstraints(), false);
+    for (const uint32_t constraint : graph.topologicalOrder()) {
+      ordered[constraint] = true;
+      for (const uint32_t successor : graph.successors(constraint)) {
+        EXPECT_FALSE(ordered[successor]) << filename;
+      }
+    }
+  }
+}
+
+TEST(definesVarGraph, is_optional) {
+  Model model = parseFznString(
+      "var 1..3: x :: is_defined_var;\n"
+      "constraint int_eq(x, 2) :: defines_var(x);\n"
+      "solve satisfy;\n");
+  EXPECT_FALSE(model.hasDefinesVarGraph());
+  EXPECT_THROW(model.definesVarGraph(), FznException);
+
+  model.buildDefinesVarGraph();
+  EXPECT_TRUE(model.hasDefinesVarGraph());
+  EXPECT_EQ(toVector(model.definesVarGraph().topologicalOrder()),
+            std::vector<uint32_t>{0});
+  model.addConstraint(Constraint("int_le", {IntArg{1}, IntArg{2}}));
+  EXPECT_FALSE(model.hasDefinesVarGraph());
+}
+
+}  // namespace fznparser::testing
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "fznparser/except.hpp"
+#include "fznparser/types.hpp"
+
+namespace fznparser::testing {
+
+using Intervals = std::vector<std::pair<int64_t, int64_t>>;
+
+std::vector<int64_t> toVector(const IntSet& set) {
+  return {set.begin(), set.end()};
+}
+
+std::vector<int64_t> range(const int64_t lb, const int64_t ub,
+                           const int64_t step = 1) {
+  std::vector<int64_t> elements;
+  for (int64_t i = lb; i <= ub; i += step) {
+    elements.push_back(i);
+  }
+  return elements;
+}
+
+// the set of the elements, built from intervals so that it is stored as
+// compactly as possible
+IntSet compact(const std::vector<int64_t>& elements) {
+  Intervals intervals;
+  for (const int64_t element : elements) {
+    intervals.emplace_back(element, element);
+  }
+  return IntSet(std::move(intervals));
+}
+
+TEST(intSet, keeps_elements) {
+  const IntSet set(std::vector<int64_t>{5, 1, 3, 1});
+  EXPECT_TRUE(set.hasElements());
+  EXPECT_EQ(set.elements(), (std::vector<int64_t>{1, 3, 5}));
+  EXPECT_EQ(set.toString(), "{1, 3, 5}");
+
+  // a set literal keeps its elements, however many there are
+  const IntSet literal(range(1, 35, 2));
+  EXPECT_TRUE(literal.hasElements());
+  EXPECT_FALSE(literal.isInterval());
+  EXPECT_EQ(literal.elements(), range(1, 35, 2));
+
+  // elements that are too sparse for intervals or a bitset
+  const IntSet sparse = compact(range(0, 100000, 1000));
+  EXPECT_TRUE(sparse.hasElements());
+  EXPECT_EQ(sparse.size(), 101);
+}
+
+TEST(intSet, stores_dense_sets_as_a_bitset) {
+  const IntSet set = compact(range(-100, 100, 2));
+  EXPECT_FALSE(set.hasElements());
+  EXPECT_FALSE(set.isInterval());
+  EXPECT_THROW(static_cast<void>(set.elements()), FznException);
+  EXPECT_EQ(set.size(), 101);
+  EXPECT_EQ(set.lowerBound(), -100);
+  EXPECT_EQ(set.upperBound(), 100);
+  for (int64_t i = -102; i <= 102; ++i) {
+    EXPECT_EQ(set.contains(i), i % 2 == 0 && -100 <= i && i <= 100) << i;
+  }
+  EXPECT_EQ(toVector(set), range(-100, 100, 2));
+  EXPECT_EQ(set.intervals().size(), 101);
+
+  // the elements of an interval
+  EXPECT_TRUE(IntSet(range(1, 100)).isInterval());
+  const IntSet interval = compact(range(1, 100));
+  EXPECT_TRUE(interval.isInterval());
+  EXPECT_EQ(interval.toString(), "1..100");
+}
+
+TEST(intSet, stores_ranges_as_intervals) {
+  const IntSet set(Intervals{{3000000000, 4000000000},
+                             {-1000000000, 1000000000},
+                             {1000000001, 1000000005},
+                             {-5, 5}});
+  EXPECT_FALSE(set.hasElements());
+  EXPECT_FALSE(set.isInterval());
+  EXPECT_EQ(set.intervals(),
+            (Intervals{{-1000000000, 1000000005}, {3000000000, 4000000000}}));
+  EXPECT_EQ(set.size(), 3000000007);
+  EXPECT_EQ(set.lowerBound(), -1000000000);
+  EXPECT_EQ(set.upperBound(), 4000000000);
+  EXPECT_TRUE(set.contains(1000000005));
+  EXPECT_FALSE(set.contains(1000000006));
+  EXPECT_FALSE(set.contains(2999999999));
+  EXPECT_TRUE(set.contains(3000000000));
+  EXPECT_FALSE(set.contains(-1000000001));
+
+  auto it = set.begin();
+  for (int i = 0; i < 3; ++i) {
+    ++it;
+  }
+  EXPECT_EQ(*it, -999999997);
+
+  const IntSet small(Intervals{{1, 3}, {7, 8}});
+  EXPECT_EQ(toVector(small), (std::vector<int64_t>{1, 2, 3, 7, 8}));
+  EXPECT_THROW(IntSet(Intervals{{2, 1}}), FznException);
+}
+
+TEST(intSet, set_algebra) {
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const IntSet lhs(Intervals{{0, 1000000000}, {2000000000, max}});
+  const IntSet rhs(Intervals{{-10, 10}, {500, 3000000000}});
+
+  EXPECT_EQ(lhs.intersect(rhs).intervals(),
+            (Intervals{{0, 10}, {500, 1000000000}, {2000000000, 3000000000}}));
+  EXPECT_EQ(lhs.unite(rhs).intervals(), (Intervals{{-10, max}}));
+  EXPECT_EQ(lhs.subtract(rhs).intervals(),
+            (Intervals{{11, 499}, {3000000001, max}}));
+  EXPECT_EQ(rhs.subtract(lhs).intervals(),
+            (Intervals{{-10, -1}, {1000000001, 1999999999}}));
+  EXPECT_TRUE(lhs.subtract(lhs).hasElements());
+  EXPECT_EQ(lhs.subtract(lhs).size(), 0);
+
+  EXPECT_FALSE(rhs.isSubsetOf(lhs));
+  EXPECT_TRUE(lhs.intersect(rhs).isSubsetOf(lhs));
+  EXPECT_TRUE(lhs.intersect(rhs).isSubsetOf(rhs));
+  EXPECT_TRUE(IntSet(1, 0).isSubsetOf(rhs));
+
+  // sets that are stored differently
+  const IntSet bitset = compact(range(0, 200, 2));
+  const IntSet elements(std::vector<int64_t>{1, 2, 4, 300});
+  EXPECT_EQ(toVector(bitset.intersect(elements)),
+            (std::vector<int64_t>{2, 4}));
+  EXPECT_EQ(bitset.unite(IntSet(0, 200)).intervals(), (Intervals{{0, 200}}));
+  EXPECT_TRUE(IntSet(std::vector<int64_t>{2, 4}).isSubsetOf(bitset));
+  EXPECT_FALSE(elements.isSubsetOf(bitset));
+}
+
+TEST(intSet, equality) {
+  // equal bounds, but different elements
+  EXPECT_FALSE(IntSet(std::vector<int64_t>{1, 3, 5}) ==
+               IntSet(std::vector<int64_t>{1, 4, 5}));
+  EXPECT_TRUE(IntSet(std::vector<int64_t>{1, 3, 5}) ==
+              IntSet(std::vector<int64_t>{5, 3, 1}));
+  EXPECT_TRUE(IntSet(std::vector<int64_t>{1, 2, 3}) == IntSet(1, 3));
+  EXPECT_FALSE(IntSet(1, 0) == IntSet(1, 1));
+  EXPECT_TRUE(IntSet(1, 0) == IntSet(std::vector<int64_t>{}));
+
+  const IntSet bitset = compact(range(0, 200, 2));
+  IntSet populated = compact(range(0, 200, 2));
+  populated.populateElements();
+  EXPECT_TRUE(bitset == populated);
+  EXPECT_EQ(bitset.hash(), populated.hash());
+  EXPECT_TRUE(bitset == IntSet(range(0, 200, 2)));
+  EXPECT_EQ(bitset.hash(), IntSet(range(0, 200, 2)).hash());
+  EXPECT_FALSE(bitset == IntSet(range(0, 200, 4)).unite(IntSet(200)));
+  EXPECT_FALSE(IntSet(Intervals{{0, 100}, {200, 300}}) ==
+               IntSet(Intervals{{0, 99}, {199, 300}}));
+}
+
+TEST(intSet, batch_contains) {
+  const std::vector<int64_t> values{-1, 0, 1, 2, 3, 4, 5, 1000, 1001, 2, 0};
+  for (const IntSet& set :
+       {IntSet(0, 4), IntSet(range(0, 2000, 2)), compact(range(0, 2000, 2)),
+        IntSet(range(0, 2000, 200)),
+        IntSet(Intervals{{0, 2}, {1000, 3000}}), IntSet(1, 0)}) {
+    bool results[11];
+    set.contains(values, results);
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(results[i], set.contains(values[i]))
+          << set.toString() << ": " << values[i];
+    }
+  }
+  bool results[2];
+  EXPECT_THROW(IntSet(0, 4).contains(values, results), FznException);
+}
+
+TEST(intSet, populates_elements) {
+  IntSet set(Intervals{{1, 20}, {31, 50}});
+  EXPECT_FALSE(set.hasElements());
+  std::vector<int64_t> expected = range(1, 20);
+  for (const int64_t element : range(31, 50)) {
+    expected.push_back(element);
+  }
+  EXPECT_EQ(set.populateElements(), expected);
+  EXPECT_TRUE(set.hasElements());
+  EXPECT_EQ(set.intervals(), (Intervals{{1, 20}, {31, 50}}));
+}
+
+}  // namespace fznparser::testing
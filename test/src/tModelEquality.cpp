@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "fznparser/parser.hpp"
+
+namespace fznparser::testing {
+
+const std::string declarations =
+    "var 1..9: x;\n"
+    "var 1..9: y;\n"
+    "var bool: b;\n"
+    "array [1..2] of var int: xs = [x, y];\n";
+
+Model modelWith(const std::vector<std::string>& constraints) {
+  std::string fzn = declarations;
+  for (const std::string& constraint : constraints) {
+    fzn += "constraint " + constraint + ";\n";
+  }
+  return parseFznString(fzn + "solve satisfy;\n");
+}
+
+TEST(modelEquality, hashes_equal_constraints_equally) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    const Model model = parseFznFile(filename);
+    const Model other = parseFznFile(filename);
+    std::unordered_set<size_t> hashes;
+    for (size_t i = 0; i < model.numConstraints(); ++i) {
+      const Constraint& constraint = model.constraints().at(i);
+      EXPECT_EQ(constraint.hash(), other.constraints().at(i).hash());
+      for (size_t a = 0; a < constraint.arguments().size(); ++a) {
+        EXPECT_EQ(constraint.arguments().at(a).hash(),
+                  other.constraints().at(i).arguments().at(a).hash());
+      }
+      hashes.insert(constraint.hash());
+    }
+    // the constraints of these models are distinct
+    EXPECT_EQ(hashes.size(), model.numConstraints()) << filename;
+  }
+}
+
+TEST(modelEquality, ignores_constraint_order) {
+  const Model model = modelWith({"int_le(x, y)", "int_lin_le([1, 2], xs, 5)",
+                                 "bool_clause([b], [])", "int_le(x, y)"});
+  EXPECT_TRUE(model ==
+              modelWith({"int_le(x, y)", "bool_clause([b], [])",
+                         "int_le(x, y)", "int_lin_le([1, 2], xs, 5)"}));
+  EXPECT_TRUE(model !=
+              modelWith({"int_le(x, y)", "int_lin_le([1, 2], xs, 6)",
+                         "bool_clause([b], [])", "int_le(x, y)"}));
+  EXPECT_TRUE(model != modelWith({"int_le(x, y)", "int_lin_le([1, 2], xs, 5)",
+                                  "bool_clause([b], []) :: domain",
+                                  "int_le(x, y)"}));
+  // the same constraints, but not as many times
+  EXPECT_TRUE(model !=
+              modelWith({"int_le(x, y)", "int_lin_le([1, 2], xs, 5)",
+                         "bool_clause([b], [])", "bool_clause([b], [])"}));
+}
+
+TEST(modelEquality, removes_duplicate_constraints) {
+  Model model = modelWith(
+      {"int_le(x, y)", "int_lin_le([1, 2], [x, y], 5)", "int_le(x, y)",
+       "int_le(y, x)", "int_lin_le([1, 2], xs, 5)",
+       "int_lin_le([1, 2], [x, y], 5)", "int_le(x, y) :: domain"});
+  model.buildOccurrenceIndex();
+  EXPECT_EQ(model.removeDuplicateConstraints(), 2);
+  EXPECT_FALSE(model.hasOccurrenceIndex());
+  // the first of the equal constraints are kept, in order
+  EXPECT_TRUE(model == modelWith({"int_le(x, y)",
+                                  "int_lin_le([1, 2], [x, y], 5)",
+                                  "int_le(y, x)", "int_lin_le([1, 2], xs, 5)",
+                                  "int_le(x, y) :: domain"}));
+  EXPECT_EQ(model.constraints().at(2).toString(), "int_le(y, x)");
+  EXPECT_EQ(model.removeDuplicateConstraints(), 0);
+  EXPECT_EQ(model.numConstraints(), 5);
+}
+
+}  // namespace fznparser::testing
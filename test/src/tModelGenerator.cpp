@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "fznparser/parser.hpp"
+#include "modelGenerator.hpp"
+
+namespace fznparser::testing {
+
+using generator::GeneratorOptions;
+
+TEST(model_generator, splitmix64_is_deterministic) {
+  generator::SplitMix64 rng(1234567);
+  // the first outputs of the reference implementation for the seed
+  EXPECT_EQ(rng.next(), 6457827717110365317u);
+  EXPECT_EQ(rng.next(), 3203168211198807973u);
+  EXPECT_EQ(rng.next(), 9817491932198370423u);
+  for (size_t i = 0; i < 1000; ++i) {
+    const int64_t value = rng.between(-3, 3);
+    EXPECT_GE(value, -3);
+    EXPECT_LE(value, 3);
+  }
+}
+
+TEST(model_generator, same_options_same_model) {
+  const GeneratorOptions options{.seed = 7, .numVars = 200, .numLinear = 300};
+  EXPECT_EQ(generator::generateModel(options),
+            generator::generateModel(options));
+  EXPECT_NE(generator::generateModel(options),
+            generator::generateModel({.seed = 8,
+                                      .numVars = options.numVars,
+                                      .numLinear = options.numLinear}));
+}
+
+TEST(model_generator, model_parses) {
+  const GeneratorOptions options{.seed = 3,
+                                 .numVars = 500,
+                                 .numAliases = 50,
+                                 .numArrays = 5,
+                                 .arraySize = 20,
+                                 .numLinear = 400,
+                                 .linearTerms = 8,
+                                 .chainLength = 30,
+                                 .numAnnotatedVars = 10,
+                                 .numAnnotatedConstraints = 10};
+  const Model model = parseFznString(generator::generateModel(options));
+  EXPECT_EQ(model.numVars(),
+            options.numVars + options.numAliases + options.chainLength +
+                options.numArrays);
+  EXPECT_EQ(model.numConstraints(),
+            options.numLinear + options.numArrays + options.chainLength);
+  for (size_t i = 0; i < options.chainLength; ++i) {
+    const Constraint& constraint =
+        model.constraints().at(model.numConstraints() - 1 - i);
+    ASSERT_TRUE(constraint.definedVar().has_value());
+    EXPECT_EQ(constraint.definedVar()->identifier(),
+              "y" + std::to_string(options.chainLength - 1 - i));
+  }
+}
+
+}  // namespace fznparser::testing
@@ -165,9 +165,10 @@ FznData get_fzn_data(const std::string& path) {
   return data;
 }
 
-void test_fzn_predicate_items(boost::spirit::istream_iterator& file_iterator,
-                              const boost::spirit::istream_iterator& eof,
-                              std::vector<parser::PredicateItem>& predicates) {
+void test_fzn_predicate_items(
+    boost::spirit::istream_iterator& file_iterator,
+    const boost::spirit::istream_iterator& eof,
+    parser::ArenaVector<parser::PredicateItem>& predicates) {
   while (true) {
     parser::PredicateItem predicateItem;
     if (!x3::phrase_parse(file_iterator, eof, parser::predicate_item, x3::space,
@@ -178,9 +179,10 @@ void test_fzn_predicate_items(boost::spirit::istream_iterator& file_iterator,
   }
 }
 
-void test_fzn_par_decl_items(boost::spirit::istream_iterator& file_iterator,
-                             const boost::spirit::istream_iterator& eof,
-                             std::vector<parser::ParDeclItem>& parDeclItems) {
+void test_fzn_par_decl_items(
+    boost::spirit::istream_iterator& file_iterator,
+    const boost::spirit::istream_iterator& eof,
+    parser::ArenaVector<parser::ParDeclItem>& parDeclItems) {
   while (true) {
     parser::ParDeclItem parDeclItem;
     if (!x3::phrase_parse(file_iterator, eof, parser::par_decl_item, x3::space,
@@ -191,9 +193,10 @@ void test_fzn_par_decl_items(boost::spirit::istream_iterator& file_iterator,
   }
 }
 
-void test_fzn_var_decl_items(boost::spirit::istream_iterator& file_iterator,
-                             const boost::spirit::istream_iterator& eof,
-                             std::vector<parser::VarDeclItem>& varDeclItems) {
+void test_fzn_var_decl_items(
+    boost::spirit::istream_iterator& file_iterator,
+    const boost::spirit::istream_iterator& eof,
+    parser::ArenaVector<parser::VarDeclItem>& varDeclItems) {
   while (true) {
     parser::VarDeclItem varDeclItem;
     if (!x3::phrase_parse(file_iterator, eof, parser::var_decl_item, x3::space,
@@ -207,7 +210,7 @@ void test_fzn_var_decl_items(boost::spirit::istream_iterator& file_iterator,
 void test_fzn_constraint_items(
     boost::spirit::istream_iterator& file_iterator,
     const boost::spirit::istream_iterator& eof,
-    std::vector<parser::ConstraintItem>& constraintItems) {
+    parser::ArenaVector<parser::ConstraintItem>& constraintItems) {
   while (true) {
     parser::ConstraintItem constraintItem;
     if (!x3::phrase_parse(file_iterator, eof, parser::constraint_item,
@@ -232,10 +235,12 @@ void test_fzn_model_breakdown(const std::string& path) {
       eof;
 
   parser::Model resModel{
-      std::vector<parser::PredicateItem>{}, std::vector<parser::ParDeclItem>{},
-      std::vector<parser::VarDeclItem>{}, std::vector<parser::ConstraintItem>{},
+      parser::ArenaVector<parser::PredicateItem>{},
+      parser::ArenaVector<parser::ParDeclItem>{},
+      parser::ArenaVector<parser::VarDeclItem>{},
+      parser::ArenaVector<parser::ConstraintItem>{},
       parser::SolveItem{
-          parser::SolveSatisfy{std::vector<parser::Annotation>{}}}};
+          parser::SolveSatisfy{parser::ArenaVector<parser::Annotation>{}}}};
   test_fzn_predicate_items(file_iterator, eof, resModel.predicateItems);
   test_fzn_par_decl_items(file_iterator, eof, resModel.parDeclItems);
   test_fzn_var_decl_items(file_iterator, eof, resModel.varDeclItems);
@@ -275,10 +280,12 @@ void test_fzn_model_breakdown(const std::string& path) {
 
 void test_fzn_model(const std::string& path) {
   parser::Model resModel{
-      std::vector<parser::PredicateItem>{}, std::vector<parser::ParDeclItem>{},
-      std::vector<parser::VarDeclItem>{}, std::vector<parser::ConstraintItem>{},
+      parser::ArenaVector<parser::PredicateItem>{},
+      parser::ArenaVector<parser::ParDeclItem>{},
+      parser::ArenaVector<parser::VarDeclItem>{},
+      parser::ArenaVector<parser::ConstraintItem>{},
       parser::SolveItem{
-          parser::SolveSatisfy{std::vector<parser::Annotation>{}}}};
+          parser::SolveSatisfy{parser::ArenaVector<parser::Annotation>{}}}};
   std::ifstream input_file(path);
   EXPECT_TRUE(input_file.is_open()) << "Could not open file: " << path;
   boost::spirit::istream_iterator file_iterator(input_file >> std::noskipws),
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "fznparser/parser.hpp"
+
+namespace fznparser::testing {
+
+std::vector<Occurrence> occurrencesOf(const Model& model,
+                                      const std::string& identifier) {
+  const OccurrenceIndex& index = model.occurrenceIndex();
+  const Var var = model.var(identifier);
+  const std::optional<uint32_t> id =
+      index.id(*std::get<std::shared_ptr<IntVar>>(var));
+  EXPECT_TRUE(id.has_value()) << identifier;
+  EXPECT_EQ(index.var(*id), var);
+  const std::span<const Occurrence> occurrences = index.occurrences(*id);
+  return {occurrences.begin(), occurrences.end()};
+}
+
+TEST(occurrenceIndex, occurrences) {
+  const Model model = parseFznString(
+      "var 1..3: x;\n"
+      "var 1..3: y;\n"
+      "var 1..3: z;\n"
+      "var int: alias = y;\n"
+      "array [1..3] of var int: xs = [x, 7, y];\n"
+      "constraint int_lin_eq([1, -1], [x, y], 0);\n"
+      "constraint int_le(x, 3);\n"
+      "constraint fzn_all_different_int(xs);\n"
+      "constraint int_le(alias, x);\n"
+      "solve satisfy;\n",
+      {.buildOccurrenceIndex = true});
+  ASSERT_TRUE(model.hasOccurrenceIndex());
+  const OccurrenceIndex& index = model.occurrenceIndex();
+  // neither the array nor the reference has an id
+  EXPECT_EQ(index.numVars(), 3);
+  EXPECT_EQ(index.numOccurrences(), 7);
+
+  EXPECT_EQ(occurrencesOf(model, "x"),
+            (std::vector<Occurrence>{
+                {0, 1, 0}, {1, 0, 0}, {2, 0, 0}, {3, 1, 0}}));
+  EXPECT_EQ(occurrencesOf(model, "y"),
+            (std::vector<Occurrence>{{0, 1, 1}, {2, 0, 2}, {3, 0, 0}}));
+  EXPECT_TRUE(occurrencesOf(model, "z").empty());
+  EXPECT_FALSE(
+      index.id(*std::get<std::shared_ptr<IntVarArray>>(model.var("xs")))
+          .has_value());
+  EXPECT_THROW(static_cast<void>(index.occurrences(3)), FznException);
+}
+
+TEST(occurrenceIndex, matches_arguments) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    const Model model =
+        parseFznFile(filename, {.buildOccurrenceIndex = true});
+    const OccurrenceIndex& index = model.occurrenceIndex();
+    for (uint32_t id = 0; id < index.numVars(); ++id) {
+      const Var& var = index.var(id);
+      for (const Occurrence& occurrence : index.occurrences(id)) {
+        const Arg& arg = model.constraints()
+                             .at(occurrence.constraint)
+                             .arguments()
+                             .at(occurrence.argument);
+        if (arg.isArray()) {
+          EXPECT_EQ(std::get<std::shared_ptr<IntVarArray>>(arg)
+                        ->at(occurrence.element),
+                    (std::variant<int64_t, std::shared_ptr<const IntVar>>(
+                        std::get<std::shared_ptr<IntVar>>(var))))
+              << filename;
+        } else {
+          EXPECT_EQ(std::get<IntArg>(arg).var(),
+                    std::get<std::shared_ptr<IntVar>>(var))
+              << filename;
+        }
+      }
+    }
+  }
+}
+
+TEST(occurrenceIndex, is_optional) {
+  Model model = parseFznString("var 1..3: x;\nsolve satisfy;\n");
+  EXPECT_FALSE(model.hasOccurrenceIndex());
+  EXPECT_THROW(model.occurrenceIndex(), FznException);
+
+  model.buildOccurrenceIndex();
+  EXPECT_TRUE(model.hasOccurrenceIndex());
+  model.addConstraint(Constraint("int_le", {IntArg{1}, IntArg{2}}));
+  EXPECT_FALSE(model.hasOccurrenceIndex());
+}
+
+}  // namespace fznparser::testing
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "fznparser/parseCache.hpp"
+#include "fznparser/parser.hpp"
+
+namespace fznparser::testing {
+
+namespace fs = std::filesystem;
+
+// an empty directory for the cache of the test
+fs::path cacheDirectory(const std::string& name) {
+  const fs::path directory =
+      fs::temp_directory_path() / ("fznparser_cache_" + name);
+  fs::remove_all(directory);
+  return directory;
+}
+
+TEST(parseCache, content_hash) {
+  EXPECT_EQ(contentHash("solve satisfy;\n").size(), 32);
+  EXPECT_EQ(contentHash("solve satisfy;\n"), contentHash("solve satisfy;\n"));
+  EXPECT_NE(contentHash(""), contentHash(std::string(1, '\0')));
+  EXPECT_NE(contentHash("var 1..2: x;\nvar 1..3: y;\n"),
+            contentHash("var 1..3: y;\nvar 1..2: x;\n"));
+  EXPECT_NE(contentHash(std::string(17, 'a')),
+            contentHash(std::string(18, 'a')));
+}
+
+TEST(parseCache, parse_stores_and_loads) {
+  const fs::path directory = cacheDirectory("parse_stores_and_loads");
+  const ParseCache cache(directory, 1 << 20);
+  const std::string filename = std::string(FZN_DIR) + "/magic_square.fzn";
+  const Model model = parseFznFile(filename);
+
+  const Model parsed = parseFznFile(filename, {.cache = &cache});
+  EXPECT_TRUE(parsed == model);
+  EXPECT_GT(cache.sizeInBytes(), 0);
+
+  // the model is loaded from the cache rather than parsed, so a different
+  // model stored for the same content is returned instead
+  const std::string fzn = "var 1..3: x;\nsolve satisfy;\n";
+  cache.store(fzn, model);
+  EXPECT_TRUE(parseFznString(fzn, {.cache = &cache}) == model);
+  fs::remove_all(directory);
+}
+
+TEST(parseCache, evicts_least_recently_used) {
+  const fs::path directory = cacheDirectory("evicts_least_recently_used");
+  const std::string fzns[] = {"var 1..3: x;\nsolve satisfy;\n",
+                              "var 1..4: x;\nsolve satisfy;\n",
+                              "var 1..5: x;\nsolve satisfy;\n"};
+  const ParseCache unbounded(directory, UINTMAX_MAX);
+  for (const std::string& fzn : fzns) {
+    const Model model = parseFznString(fzn, {.cache = &unbounded});
+  }
+  const uintmax_t entrySize = fs::file_size(unbounded.entryPath(fzns[0]));
+  EXPECT_EQ(unbounded.sizeInBytes(), 3 * entrySize);
+
+  // the first model is used last
+  const auto now = fs::file_time_type::clock::now();
+  for (size_t i = 0; i < 3; ++i) {
+    fs::last_write_time(unbounded.entryPath(fzns[(i + 1) % 3]),
+                        now - std::chrono::hours(3 - i));
+  }
+  unbounded.evict(2 * entrySize);
+  EXPECT_FALSE(fs::exists(unbounded.entryPath(fzns[1])));
+  EXPECT_TRUE(fs::exists(unbounded.entryPath(fzns[2])));
+  EXPECT_TRUE(fs::exists(unbounded.entryPath(fzns[0])));
+
+  // storing a model evicts down to the size cap
+  const ParseCache cache(directory, 2 * entrySize);
+  EXPECT_TRUE(cache.store(fzns[1], parseFznString(fzns[1])));
+  EXPECT_FALSE(fs::exists(cache.entryPath(fzns[2])));
+  EXPECT_EQ(cache.sizeInBytes(), 2 * entrySize);
+  fs::remove_all(directory);
+}
+
+TEST(parseCache, replaces_unreadable_entries) {
+  const fs::path directory = cacheDirectory("replaces_unreadable_entries");
+  const ParseCache cache(directory, 1 << 20);
+  const std::string fzn = "var 1..3: x;\nsolve satisfy;\n";
+  std::ofstream(cache.entryPath(fzn), std::ios::binary) << "FZNSNAP";
+  EXPECT_FALSE(cache.load(fzn).has_value());
+  EXPECT_FALSE(fs::exists(cache.entryPath(fzn)));
+
+  const Model model = parseFznString(fzn);
+  EXPECT_TRUE(parseFznString(fzn, {.cache = &cache}) == model);
+  EXPECT_TRUE(cache.load(fzn).has_value());
+  fs::remove_all(directory);
+}
+
+TEST(parseCache, checks_the_content_of_entries) {
+  const fs::path directory = cacheDirectory("checks_the_content_of_entries");
+  const ParseCache cache(directory, 1 << 20);
+  const std::string fzn = "var 1..3: x;\nsolve satisfy;\n";
+  const std::string other = "var 1..4: x;\nsolve satisfy;\n";
+  ASSERT_TRUE(cache.store(other, parseFznString(other)));
+
+  // the entry of other content at the path of the content, as if their
+  // contentHash collided
+  fs::copy_file(cache.entryPath(other), cache.entryPath(fzn));
+  EXPECT_FALSE(cache.load(fzn).has_value());
+  EXPECT_FALSE(fs::exists(cache.entryPath(fzn)));
+  EXPECT_TRUE(cache.load(other).has_value());
+  fs::remove_all(directory);
+}
+
+}  // namespace fznparser::testing
@@ -4,6 +4,7 @@
 #include <boost/spirit/include/support_istream_iterator.hpp>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <regex>
 #include <string>
 #include <vector>
@@ -70,4 +71,220 @@ TEST(parser, tsp_alldiff) {
   EXPECT_EQ(outputIndexSetSizes.at(0), 17);
 }
 
+TEST(parser, missing_file) {
+  EXPECT_THROW(parseFznFile(std::string(FZN_DIR) + "/does_not_exist.fzn"),
+               FznException);
+}
+
+TEST(parser, mapped_file_matches_istream) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    std::ifstream fznFile(filename);
+    const fznparser::Model streamModel = parseFznIstream(fznFile);
+    EXPECT_TRUE(parseFznFile(filename) == streamModel) << filename;
+  }
+}
+
+TEST(parser, string_view_matches_file) {
+  const std::string filename = std::string(FZN_DIR) + "/magic_square.fzn";
+  std::ifstream fznFile(filename);
+  std::string content{std::istreambuf_iterator<char>(fznFile),
+                      std::istreambuf_iterator<char>()};
+  const fznparser::Model fileModel = parseFznFile(filename);
+  EXPECT_TRUE(parseFznString(content) == fileModel);
+
+  // the buffer is only read within the bounds of the view
+  const size_t size = content.size();
+  content += "this is not FlatZinc";
+  EXPECT_TRUE(parseFznString(std::string_view(content.data(), size)) ==
+              fileModel);
+  EXPECT_THROW(parseFznString(content), FznException);
+}
+
+class CollectingHandler : public ItemHandler {
+ public:
+  std::vector<Var> vars;
+  size_t numArrays = 0;
+  std::vector<Constraint> constraints;
+  std::optional<SolveType> solveType;
+
+  void onVar(const Var& var) override { vars.push_back(var); }
+  void onArray(const Var& var) override {
+    EXPECT_TRUE(var.isArray());
+    ++numArrays;
+    vars.push_back(var);
+  }
+  void onConstraint(Constraint&& constraint) override {
+    constraints.push_back(std::move(constraint));
+  }
+  void onSolve(SolveType&& solve) override {
+    solveType.emplace(std::move(solve));
+  }
+};
+
+TEST(parser, item_handler_matches_model) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    const fznparser::Model fileModel = parseFznFile(filename);
+
+    CollectingHandler handler;
+    parseFznFile(filename, handler);
+    EXPECT_EQ(handler.vars.size(), fileModel.numVars()) << filename;
+    EXPECT_GT(handler.numArrays, 0) << filename;
+    // constraints are passed in source order
+    EXPECT_TRUE(handler.constraints == fileModel.constraints()) << filename;
+    ASSERT_TRUE(handler.solveType.has_value()) << filename;
+    const fznparser::Model handledModel(std::move(handler.vars),
+                                        std::move(handler.constraints),
+                                        std::move(*handler.solveType));
+    EXPECT_TRUE(handledModel == fileModel) << filename;
+  }
+}
+
+TEST(parser, item_handler_rejects_invalid) {
+  ItemHandler handler;
+  EXPECT_THROW(parseFznString("var int: x;", handler), FznException);
+  EXPECT_THROW(parseFznString("solve satisfy; var int: x;", handler),
+               FznException);
+  EXPECT_THROW(
+      parseFznString("constraint int_le(x, 1);\nsolve satisfy;", handler),
+      FznException);
+  EXPECT_NO_THROW(parseFznString(
+      "var 1..2: x;\nconstraint int_le(x, 1);\nsolve satisfy;", handler));
+}
+
+TEST(parser, item_handler_rejects_duplicate_vars) {
+  const std::string duplicate =
+      "var 1..2: x;\nvar 1..3: x;\nconstraint int_le(x, 1);\nsolve satisfy;";
+  for (const bool useTokenizer : {false, true}) {
+    CollectingHandler handler;
+    EXPECT_THROW(
+        parseFznString(duplicate, handler, {.useTokenizer = useTokenizer}),
+        FznException);
+    EXPECT_EQ(handler.vars.size(), 1);
+  }
+  EXPECT_THROW(parseFznString(duplicate), FznException);
+}
+
+TEST(parser, tokenizer_matches_x3) {
+  const ParseOptions tokenizer{.useTokenizer = true};
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    const fznparser::Model x3Model = parseFznFile(filename);
+    EXPECT_TRUE(parseFznFile(filename, tokenizer) == x3Model) << filename;
+
+    CollectingHandler handler;
+    parseFznFile(filename, handler, tokenizer);
+    EXPECT_TRUE(handler.constraints == x3Model.constraints()) << filename;
+  }
+  EXPECT_THROW(parseFznString("var int: x;", tokenizer), FznException);
+}
+
+TEST(parser, large_set_literal_domain) {
+  std::string domain = "{1";
+  std::vector<int64_t> elements{1};
+  for (int64_t i = 3; i <= 35; i += 2) {
+    domain += ", " + std::to_string(i);
+    elements.push_back(i);
+  }
+  for (const bool useTokenizer : {false, true}) {
+    const fznparser::Model model =
+        parseFznString("var " + domain + "}: x;\nsolve satisfy;\n",
+                       {.useTokenizer = useTokenizer});
+    const IntSet& intSet =
+        std::get<std::shared_ptr<IntVar>>(model.var("x"))->domain();
+    ASSERT_FALSE(intSet.isInterval());
+    EXPECT_EQ(intSet.elements(), elements);
+  }
+}
+
+// a model that is large enough to be parsed in several chunks
+std::string largeModel(const size_t numVars) {
+  std::string fzn =
+      "predicate fzn_all_different_int(array [int] of var int: x);\n"
+      "array [1..2] of int: coeffs = [1, -1];\n";
+  for (size_t i = 0; i < numVars; ++i) {
+    fzn += "var 0..10: x" + std::to_string(i) + " :: output_var;\n";
+  }
+  for (size_t i = 1; i < numVars; ++i) {
+    fzn += "constraint int_lin_le(coeffs, [x" + std::to_string(i - 1) +
+           ", x" + std::to_string(i) + "], 0) :: note(\"a; b\");\n";
+  }
+  return fzn + "solve satisfy;\n";
+}
+
+TEST(parser, parallel_matches_sequential) {
+  const std::string fzn = largeModel(3000);
+  for (const bool useTokenizer : {false, true}) {
+    const fznparser::Model sequential =
+        parseFznString(fzn, {.useTokenizer = useTokenizer});
+    const fznparser::Model parallel =
+        parseFznString(fzn, {.useTokenizer = useTokenizer, .numThreads = 4});
+    EXPECT_EQ(parallel.numVars(), 3000);
+    EXPECT_TRUE(parallel.vars() == sequential.vars());
+    EXPECT_TRUE(parallel.constraints() == sequential.constraints());
+    EXPECT_TRUE(parallel.solveType() == sequential.solveType());
+
+    // items out of order are rejected just like in a sequential parse
+    EXPECT_THROW(parseFznString(fzn + "var int: y;\n",
+                                {.useTokenizer = useTokenizer,
+                                 .numThreads = 4}),
+                 FznException);
+    EXPECT_THROW(parseFznString(fzn.substr(0, fzn.find("solve")),
+                                {.useTokenizer = useTokenizer,
+                                 .numThreads = 4}),
+                 FznException);
+  }
+}
+
+TEST(parser, parallel_transformation_reports_first_error) {
+  std::string fzn = largeModel(3000);
+  // constraints that define undefined variables
+  for (const size_t i : {1000, 2000}) {
+    const std::string args = ", x" + std::to_string(i) + "], 0)";
+    fzn.insert(fzn.find(args) + args.size(),
+               " :: defines_var(y" + std::to_string(i) + ")");
+  }
+  for (const bool useTokenizer : {false, true}) {
+    try {
+      parseFznString(fzn, {.useTokenizer = useTokenizer, .numThreads = 4});
+      FAIL() << "expected an FznException";
+    } catch (const FznException& e) {
+      EXPECT_STREQ(e.what(), "Var with identifier y1000 is not defined");
+    }
+  }
+}
+
+TEST(parser, collects_parse_stats) {
+  const std::string filename = std::string(FZN_DIR) + "/car_sequencing.fzn";
+  const size_t fileSize = std::filesystem::file_size(filename);
+  for (const bool useTokenizer : {false, true}) {
+    ParseStats stats;
+    const fznparser::Model model = parseFznFile(
+        filename, {.useTokenizer = useTokenizer, .stats = &stats});
+
+    EXPECT_EQ(stats.phase(ParsePhase::READ).bytes, fileSize);
+    EXPECT_EQ(stats.phase(ParsePhase::GRAMMAR).bytes, fileSize);
+    // the model has 2 predicates and a solve item, which are not replaced
+    EXPECT_EQ(stats.phase(ParsePhase::GRAMMAR).numItems,
+              stats.phase(ParsePhase::REPLACE).numItems + 3);
+    EXPECT_EQ(stats.phase(ParsePhase::VALIDATE).numItems,
+              stats.phase(ParsePhase::VARIABLES).numItems);
+    EXPECT_EQ(stats.phase(ParsePhase::VARIABLES).numItems, model.numVars());
+    EXPECT_EQ(stats.phase(ParsePhase::CONSTRAINTS).numItems,
+              model.numConstraints());
+    EXPECT_GT(stats.totalWallTime().count(), 0);
+#ifdef __linux__
+    EXPECT_GT(stats.phase(ParsePhase::GRAMMAR).peakResidentBytes, 0);
+    EXPECT_GT(stats.phase(ParsePhase::VARIABLES).peakResidentBytes, 0);
+    EXPECT_GE(stats.peakResidentBytes(),
+              stats.phase(ParsePhase::GRAMMAR).peakResidentBytes);
+#endif
+    EXPECT_NE(stats.toString().find("constraints: "), std::string::npos);
+  }
+}
+
 }  // namespace fznparser::testing
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "fznparser/simd.hpp"
+
+namespace fznparser::testing {
+
+std::vector<int64_t> sortedElements(const size_t size,
+                                    std::mt19937_64& generator) {
+  std::uniform_int_distribution<int64_t> gap(1, 5);
+  std::vector<int64_t> elements;
+  int64_t element = -static_cast<int64_t>(size);
+  for (size_t i = 0; i < size; ++i) {
+    element += gap(generator);
+    elements.push_back(element);
+  }
+  return elements;
+}
+
+TEST(simd, lower_bound) {
+  std::mt19937_64 generator(1);
+  for (const size_t size : {0, 1, 3, 4, 5, 16, 17, 33, 100, 1000}) {
+    const std::vector<int64_t> elements = sortedElements(size, generator);
+    const int64_t lb = elements.empty() ? 0 : elements.front() - 2;
+    const int64_t ub = elements.empty() ? 0 : elements.back() + 2;
+    for (int64_t value = lb; value <= ub; ++value) {
+      const auto expected = std::ranges::lower_bound(elements, value);
+      EXPECT_EQ(simd::lowerBound(elements, value), expected - elements.begin())
+          << size << ": " << value;
+      EXPECT_EQ(simd::gallop(elements, value), expected - elements.begin())
+          << size << ": " << value;
+    }
+  }
+  EXPECT_NE(simd::instructionSet(), nullptr);
+}
+
+TEST(simd, includes) {
+  std::mt19937_64 generator(2);
+  std::bernoulli_distribution keep(0.5);
+  for (const size_t size : {0, 1, 7, 64, 1000}) {
+    const std::vector<int64_t> superset = sortedElements(size, generator);
+    // dense and sparse subsets
+    for (const size_t step : {1, 40}) {
+      std::vector<int64_t> subset;
+      for (size_t i = 0; i < superset.size(); i += step) {
+        if (keep(generator)) {
+          subset.push_back(superset[i]);
+        }
+      }
+      EXPECT_TRUE(simd::includes(superset, subset)) << size;
+      if (!subset.empty()) {
+        std::vector<int64_t> other = subset;
+        other[other.size() / 2] += 1;
+        std::ranges::sort(other);
+        EXPECT_EQ(simd::includes(superset, other),
+                  std::ranges::includes(superset, other))
+            << size;
+        EXPECT_FALSE(simd::includes(subset, superset) &&
+                     subset.size() < superset.size());
+      }
+    }
+  }
+}
+
+// scanIntList one character at a time
+simd::IntList scanIntListScalar(const char* first, const char* last,
+                                const std::span<int64_t> ints) {
+  const auto isSpace = [](const char c) {
+    return c == ' ' || ('\t' <= c && c <= '\r');
+  };
+  simd::IntList list{first, 0};
+  const char* pos = first;
+  while (list.size < ints.size()) {
+    while (pos != last && isSpace(*pos)) {
+      ++pos;
+    }
+    const char* digits = pos != last && *pos == '-' ? pos + 1 : pos;
+    const char* end = digits;
+    while (end != last && '0' <= *end && *end <= '9') {
+      ++end;
+    }
+    const char* separator = end;
+    while (separator != last && isSpace(*separator)) {
+      ++separator;
+    }
+    int64_t value;
+    if (end == digits || separator == last ||
+        (*separator != ',' && *separator != ']') ||
+        std::from_chars(pos, end, value).ec != std::errc{}) {
+      return list;
+    }
+    ints[list.size++] = value;
+    list.end = end;
+    if (*separator == ']') {
+      return list;
+    }
+    pos = separator + 1;
+  }
+  return list;
+}
+
+TEST(simd, scan_int_list) {
+  std::mt19937_64 generator(3);
+  std::uniform_int_distribution<int> digits(1, 18);
+  std::uniform_int_distribution<int> spaces(0, 3);
+  std::uniform_int_distribution<int> kind(0, 99);
+  const std::vector<std::string> others{
+      "x",    "1.5", "2e3",    "0x1F", "0o7", "1..3", "1 .. 3",
+      "{1, 2}", "- 1", "+1", "]",    "%",   "5 %\n", "",
+      "9223372036854775808", "-9223372036854775808"};
+  std::uniform_int_distribution<size_t> other(0, others.size() - 1);
+  for (int test = 0; test < 2000; ++test) {
+    std::string input;
+    const int size = std::uniform_int_distribution<int>(0, 200)(generator);
+    for (int i = 0; i < size; ++i) {
+      const int k = kind(generator);
+      if (k == 0) {
+        input += others[other(generator)];
+      } else {
+        input += k % 3 == 0 ? "-" : "";
+        for (int d = digits(generator); d > 0; --d) {
+          input += static_cast<char>('0' + generator() % 10);
+        }
+      }
+      input.append(spaces(generator), " \n\t"[generator() % 3]);
+      if (kind(generator) == 0) {
+        // runs of whitespace longer than a block
+        input.append(70, ' ');
+      }
+      input += i + 1 < size ? "," : "]";
+      input.append(spaces(generator), ' ');
+    }
+    std::vector<int64_t> expected(1 + generator() % 300);
+    std::vector<int64_t> actual(expected.size());
+    const char* first = input.data();
+    const char* last = input.data() + input.size();
+    const simd::IntList expectedList =
+        scanIntListScalar(first, last, expected);
+    const simd::IntList actualList = simd::scanIntList(first, last, actual);
+    ASSERT_EQ(actualList.size, expectedList.size) << input;
+    ASSERT_EQ(actualList.end, expectedList.end) << input;
+    expected.resize(expectedList.size);
+    actual.resize(actualList.size);
+    EXPECT_EQ(actual, expected) << input;
+  }
+}
+
+}  // namespace fznparser::testing
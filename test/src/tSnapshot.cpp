@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fznparser/parser.hpp"
+#include "fznparser/snapshot.hpp"
+
+namespace fznparser::testing {
+
+std::string toSnapshot(const Model& model) {
+  std::stringstream ss;
+  writeSnapshot(model, ss);
+  return ss.str();
+}
+
+// the derived flags and links that Model::operator== does not compare
+void expectSameLinks(const Model& expected, const Model& actual) {
+  for (const auto& [identifier, var] : expected.vars()) {
+    EXPECT_EQ(actual.var(identifier).isOutput(), var.isOutput())
+        << identifier;
+  }
+  ASSERT_EQ(actual.numConstraints(), expected.numConstraints());
+  for (size_t i = 0; i < expected.numConstraints(); ++i) {
+    const std::optional<const Var> definedVar =
+        expected.constraints().at(i).definedVar();
+    const std::optional<const Var> actualDefinedVar =
+        actual.constraints().at(i).definedVar();
+    ASSERT_EQ(actualDefinedVar.has_value(), definedVar.has_value()) << i;
+    if (definedVar.has_value()) {
+      EXPECT_EQ(actualDefinedVar->identifier(), definedVar->identifier());
+    }
+  }
+}
+
+TEST(snapshot, round_trip) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    const std::string filename = std::string(FZN_DIR) + "/" + name + ".fzn";
+    const Model model = parseFznFile(filename);
+    const Model loaded = readSnapshotString(toSnapshot(model));
+    EXPECT_TRUE(loaded == model) << filename;
+    expectSameLinks(model, loaded);
+  }
+}
+
+TEST(snapshot, round_trip_of_every_type) {
+  const Model model = parseFznString(
+      "array [1..2] of float: fs = [1.5, 2.5];\n"
+      "var bool: b :: output_var;\n"
+      "var bool: t = true;\n"
+      "var {1, 3, 5}: x :: output_var;\n"
+      "var -5..5: y :: is_defined_var;\n"
+      "var int: z;\n"
+      "var 0.0..1.0: f;\n"
+      "var set of 1..3: s;\n"
+      "var set of {2, 4}: s2;\n"
+      "var int: alias = y;\n"
+      "array [1..3] of var int: xs :: output_array([1..3]) = [x, 7, y];\n"
+      "array [1..2] of var set of int: ss = [s, {1, 2}];\n"
+      "constraint int_lin_eq([1, -1], [x, y], 0) :: defines_var(y);\n"
+      "constraint bool_clause([b, true], [t]);\n"
+      "constraint float_lin_le(fs, [f, 0.5], 3.0) :: domain;\n"
+      "constraint set_in(y, {1, 2, 3});\n"
+      "constraint set_card(s2, z) :: "
+      "my_ann(\"a string\", [1.0..2.0], nested(x));\n"
+      "constraint float_in(f, 0.0..1.0);\n"
+      "solve :: int_search(xs, input_order, indomain_min) minimize z;\n");
+  const Model loaded = readSnapshotString(toSnapshot(model));
+  EXPECT_TRUE(loaded == model);
+  expectSameLinks(model, loaded);
+  EXPECT_TRUE(std::holds_alternative<std::shared_ptr<VarReference>>(
+      loaded.var("alias")));
+  EXPECT_TRUE(loaded.isMinimisationProblem());
+  EXPECT_EQ(loaded.objective().identifier(), "z");
+  EXPECT_EQ(std::get<std::shared_ptr<IntVarArray>>(loaded.var("xs"))
+                ->outputIndexSetSizes(),
+            std::vector<int64_t>{3});
+}
+
+TEST(snapshot, round_trip_of_large_sets) {
+  // set literals, which keep their elements
+  std::string evens = "{0";
+  std::string ranges = "{1";
+  for (int64_t i = 1; i <= 100; ++i) {
+    evens += ", " + std::to_string(2 * i);
+    ranges += ", " + std::to_string(i + 1) + ", " + std::to_string(i + 10000);
+  }
+  Model model = parseFznString("var " + evens + "}: x;\n" +
+                               "var set of " + ranges + "}: s;\n" +
+                               "constraint set_in(x, " + ranges + "});\n" +
+                               "solve satisfy;\n");
+  // sets built from intervals, which are a bitset and an interval list
+  std::vector<std::pair<int64_t, int64_t>> evenIntervals;
+  for (int64_t i = 0; i <= 100; ++i) {
+    evenIntervals.emplace_back(2 * i, 2 * i);
+  }
+  model.addVar(
+      std::make_shared<IntVar>(IntSet(std::move(evenIntervals)), "y"));
+  model.addVar(std::make_shared<SetVar>(
+      IntSet(std::vector<std::pair<int64_t, int64_t>>{{1, 101},
+                                                      {10001, 10100}}),
+      "t"));
+  const Model loaded = readSnapshotString(toSnapshot(model));
+  EXPECT_TRUE(loaded == model);
+  for (const std::string identifier : {"x", "y"}) {
+    EXPECT_EQ(std::get<std::shared_ptr<IntVar>>(loaded.var(identifier))
+                  ->domain()
+                  .intervals(),
+              std::get<std::shared_ptr<IntVar>>(model.var(identifier))
+                  ->domain()
+                  .intervals())
+        << identifier;
+  }
+  EXPECT_TRUE(std::get<std::shared_ptr<IntVar>>(loaded.var("x"))
+                  ->domain()
+                  .hasElements());
+  for (const std::string identifier : {"s", "t"}) {
+    EXPECT_EQ(std::get<std::shared_ptr<SetVar>>(loaded.var(identifier))
+                  ->upperBound()
+                  .intervals(),
+              (std::vector<std::pair<int64_t, int64_t>>{{1, 101},
+                                                        {10001, 10100}}))
+        << identifier;
+  }
+  EXPECT_EQ(std::get<IntSetArg>(loaded.constraints().front().arguments().at(1))
+                .parameter()
+                .size(),
+            201);
+}
+
+TEST(snapshot, shares_variables) {
+  const Model model = parseFznString(
+      "var 1..3: x;\n"
+      "array [1..2] of var int: xs = [x, x];\n"
+      "constraint int_le(x, 2);\n"
+      "constraint fzn_all_different_int(xs);\n"
+      "solve satisfy;\n");
+  const Model loaded = readSnapshotString(toSnapshot(model));
+  const auto x = std::get<std::shared_ptr<IntVar>>(loaded.var("x"));
+  const auto xs = std::get<std::shared_ptr<IntVarArray>>(loaded.var("xs"));
+  for (size_t i = 0; i < xs->size(); ++i) {
+    EXPECT_EQ(std::get<std::shared_ptr<const IntVar>>(xs->at(i)).get(),
+              x.get());
+  }
+  const Constraint& intLe = loaded.constraints().front();
+  EXPECT_EQ(std::get<IntArg>(intLe.arguments().front()).var().get(),
+            x.get());
+  const Constraint& allDifferent = loaded.constraints().back();
+  EXPECT_EQ(std::get<std::shared_ptr<IntVarArray>>(
+                allDifferent.arguments().front())
+                .get(),
+            xs.get());
+}
+
+TEST(snapshot, file_round_trip) {
+  const Model model =
+      parseFznFile(std::string(FZN_DIR) + "/magic_square.fzn");
+  const std::string filename =
+      (std::filesystem::temp_directory_path() / "fznparser_snapshot.bin")
+          .string();
+  writeSnapshotFile(model, filename);
+  EXPECT_TRUE(readSnapshotFile(filename) == model);
+  std::filesystem::remove(filename);
+  EXPECT_THROW(readSnapshotFile(filename), FznException);
+}
+
+TEST(snapshot, rejects_invalid_snapshots) {
+  const std::string snapshot = toSnapshot(
+      parseFznFile(std::string(FZN_DIR) + "/magic_square.fzn"));
+  EXPECT_THROW(readSnapshotString(""), FznException);
+  EXPECT_THROW(readSnapshotString("var int: x;\nsolve satisfy;\n"),
+               FznException);
+  for (const size_t size : {size_t{8}, size_t{12}, snapshot.size() / 2,
+                            snapshot.size() - 1}) {
+    EXPECT_THROW(readSnapshotString(snapshot.substr(0, size)), FznException)
+        << size;
+  }
+  EXPECT_THROW(readSnapshotString(snapshot + '\0'), FznException);
+
+  // the version follows the 8 byte magic
+  std::string otherVersion = snapshot;
+  otherVersion[8] = static_cast<char>(snapshotVersion + 1);
+  try {
+    readSnapshotString(otherVersion);
+    FAIL() << "expected an FznException";
+  } catch (const FznException& e) {
+    EXPECT_NE(std::string(e.what()).find("version"), std::string::npos);
+  }
+}
+
+}  // namespace fznparser::testing
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fznparser/variables.hpp"
+
+namespace fznparser::testing {
+
+TEST(varArray, mixed_elements) {
+  IntVarArray array("array");
+  array.reserve(200);
+  std::vector<std::shared_ptr<IntVar>> vars;
+  // enough elements to span several words of the tag bitmap
+  for (int64_t i = 0; i < 200; ++i) {
+    if (i % 3 == 0 || (i > 100 && i < 140)) {
+      vars.push_back(std::make_shared<IntVar>(0, i, "x" + std::to_string(i)));
+      array.append(vars.back());
+    } else {
+      array.append(i);
+    }
+  }
+  EXPECT_EQ(array.size(), 200);
+  EXPECT_FALSE(array.isParArray());
+  EXPECT_FALSE(array.isVarArray());
+  size_t numVars = 0;
+  for (size_t i = 0; i < array.size(); ++i) {
+    const auto element = array.at(i);
+    if (i % 3 == 0 || (i > 100 && i < 140)) {
+      EXPECT_FALSE(array.isParameter(i));
+      ASSERT_TRUE(
+          std::holds_alternative<std::shared_ptr<const IntVar>>(element));
+      EXPECT_EQ(std::get<std::shared_ptr<const IntVar>>(element),
+                vars.at(numVars));
+      EXPECT_EQ(array.var(i), vars.at(numVars));
+      ++numVars;
+    } else {
+      EXPECT_TRUE(array.isParameter(i));
+      ASSERT_TRUE(std::holds_alternative<int64_t>(element));
+      EXPECT_EQ(std::get<int64_t>(element), static_cast<int64_t>(i));
+      EXPECT_EQ(array.parameter(i), static_cast<int64_t>(i));
+    }
+  }
+  EXPECT_THROW(static_cast<void>(array.at(200)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(array.parameters()), FznException);
+  EXPECT_THROW(static_cast<void>(array.vars()), FznException);
+}
+
+TEST(varArray, contiguous_parameters) {
+  BoolVarArray array("array");
+  for (size_t i = 0; i < 100; ++i) {
+    array.append(i % 2 == 0);
+  }
+  EXPECT_TRUE(array.isParArray());
+  const std::span<const bool> parameters = array.parameters();
+  ASSERT_EQ(parameters.size(), 100);
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    EXPECT_EQ(parameters[i], i % 2 == 0);
+    EXPECT_EQ(std::get<bool>(array[i]), i % 2 == 0);
+  }
+  EXPECT_EQ(array.toParVector().size(), 100);
+  EXPECT_THROW(static_cast<void>(array.vars()), FznException);
+}
+
+TEST(varArray, contiguous_vars) {
+  SetVarArray array("array");
+  std::vector<std::shared_ptr<SetVar>> vars;
+  for (int64_t i = 0; i < 70; ++i) {
+    vars.push_back(std::make_shared<SetVar>(0, i, "s" + std::to_string(i)));
+    array.append(vars.back());
+  }
+  EXPECT_TRUE(array.isVarArray());
+  EXPECT_FALSE(array.isParArray());
+  const auto elements = array.vars();
+  ASSERT_EQ(elements.size(), vars.size());
+  for (size_t i = 0; i < vars.size(); ++i) {
+    EXPECT_EQ(elements[i], vars[i]);
+  }
+  EXPECT_THROW(static_cast<void>(array.parameters()), FznException);
+
+  const SetVarArray empty("empty");
+  EXPECT_TRUE(empty.isParArray());
+  EXPECT_TRUE(empty.parameters().empty());
+  EXPECT_TRUE(empty.vars().empty());
+}
+
+TEST(varArray, equality) {
+  IntVarArray array("array");
+  IntVarArray other("array");
+  const auto var = std::make_shared<IntVar>(0, 10, "x");
+  for (IntVarArray* a : {&array, &other}) {
+    a->append(1);
+    a->append(var);
+  }
+  EXPECT_EQ(array, other);
+  array.append(2);
+  other.append(var);
+  EXPECT_NE(array, other);
+}
+
+}  // namespace fznparser::testing
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "fznparser/parser.hpp"
+
+namespace fznparser::testing {
+
+template <class ArrayType, typename PooledElement>
+void expectEqualElements(const VarPools& pools, const ArrayType& array,
+                         const std::span<const PooledElement> elements) {
+  ASSERT_EQ(elements.size(), array.size());
+  auto handle = elements.begin();
+  for (const auto element : array) {
+    ASSERT_EQ(handle->isParameter(), element.isParameter());
+    if (element.isParameter()) {
+      EXPECT_EQ(pools.parameter(*handle), element.parameter());
+    } else {
+      EXPECT_EQ(pools.var(*handle).identifier(), element.var()->identifier());
+    }
+    ++handle;
+  }
+}
+
+TEST(varPools, pools) {
+  Model model = parseFznString(
+      "var 1..3: x;\n"
+      "var 1..3: y;\n"
+      "var int: alias = y;\n"
+      "array [1..3] of var int: xs = [x, 7, y];\n"
+      "constraint int_lin_eq([1, -1], [x, y], 0);\n"
+      "constraint fzn_all_different_int(xs);\n"
+      "constraint int_le(alias, x);\n"
+      "solve satisfy;\n");
+  model.buildVarPools();
+  ASSERT_TRUE(model.hasVarPools());
+  const VarPools& pools = model.varPools();
+  // the reference resolves to y and the array is pooled once
+  ASSERT_EQ(pools.intVars().size(), 2);
+  ASSERT_EQ(pools.vars().size(), 4);
+  EXPECT_EQ(pools.numConstraints(), 3);
+
+  const auto xs = std::get<ArrayHandle<IntVarArray>>(
+      pools.vars()[std::distance(model.vars().begin(),
+                                 model.vars().find("xs"))]);
+  const Var xsVar = model.var("xs");
+  expectEqualElements(pools, *std::get<std::shared_ptr<IntVarArray>>(xsVar),
+                      pools.elements(xs));
+
+  EXPECT_EQ(pools.identifier(0), "int_lin_eq");
+  const std::span<const PooledArg> linear = pools.arguments(0);
+  ASSERT_EQ(linear.size(), 3);
+  const auto coefficients = pools.elements(
+      std::get<ArrayHandle<IntVarArray>>(linear[0]));
+  ASSERT_EQ(coefficients.size(), 2);
+  EXPECT_EQ(pools.parameter(coefficients[0]), 1);
+  EXPECT_EQ(pools.parameter(coefficients[1]), -1);
+  EXPECT_EQ(pools.parameter(std::get<IntHandle>(linear[2])), 0);
+
+  EXPECT_EQ(pools.arguments(1)[0], PooledArg(xs));
+
+  const std::span<const PooledArg> le = pools.arguments(2);
+  EXPECT_EQ(pools.var(std::get<IntHandle>(le[0])).identifier(), "y");
+  EXPECT_EQ(pools.var(std::get<IntHandle>(le[1])).identifier(), "x");
+  EXPECT_THROW(static_cast<void>(pools.parameter(std::get<IntHandle>(le[0]))),
+               FznException);
+  EXPECT_THROW(static_cast<void>(pools.var(coefficients[0])), FznException);
+  EXPECT_THROW(static_cast<void>(pools.arguments(3)), FznException);
+
+  model.addConstraint(
+      Constraint("int_le", {IntArg(int64_t{0}), IntArg(int64_t{1})}));
+  EXPECT_FALSE(model.hasVarPools());
+  EXPECT_THROW(static_cast<void>(model.varPools()), FznException);
+}
+
+TEST(varPools, float_sets) {
+  Model model = parseFznString(
+      "constraint c1([1.0..2.0]);\n"
+      "constraint c2(9.0..9.5);\n"
+      "constraint c3([3.0..4.0, 5.0..6.0]);\n"
+      "solve satisfy;\n");
+  model.buildVarPools();
+  const VarPools& pools = model.varPools();
+  ASSERT_EQ(pools.numConstraints(), 3);
+
+  const std::span<const FloatSet> first = pools.elements(
+      std::get<ArrayHandle<FloatSetArray>>(pools.arguments(0)[0]));
+  ASSERT_EQ(first.size(), 1);
+  EXPECT_EQ(first[0], FloatSet(1.0, 2.0));
+
+  EXPECT_EQ(pools.parameter(std::get<FloatSetHandle>(pools.arguments(1)[0])),
+            FloatSet(9.0, 9.5));
+
+  // the float set between the arrays is not an element of either
+  const std::span<const FloatSet> last = pools.elements(
+      std::get<ArrayHandle<FloatSetArray>>(pools.arguments(2)[0]));
+  ASSERT_EQ(last.size(), 2);
+  EXPECT_EQ(last[0], FloatSet(3.0, 4.0));
+  EXPECT_EQ(last[1], FloatSet(5.0, 6.0));
+}
+
+TEST(varPools, handles_are_32_bit) {
+  EXPECT_EQ(sizeof(IntHandle), 4);
+  EXPECT_EQ(sizeof(ArrayHandle<IntVarArray>), 4);
+  EXPECT_EQ(sizeof(PooledArg), 8);
+  EXPECT_TRUE(std::is_trivially_copyable_v<PooledArg>);
+  const IntHandle handle = IntHandle::var(IntHandle::maxIndex);
+  EXPECT_FALSE(handle.isParameter());
+  EXPECT_EQ(handle.index(), IntHandle::maxIndex);
+  EXPECT_NE(handle, IntHandle::parameter(IntHandle::maxIndex));
+}
+
+TEST(varPools, matches_arguments) {
+  for (const std::string name :
+       {"car_sequencing", "magic_square", "n_queens", "tsp_alldiff"}) {
+    Model model = parseFznFile(std::string(FZN_DIR) + "/" + name + ".fzn");
+    model.buildVarPools();
+    const VarPools& pools = model.varPools();
+    ASSERT_EQ(pools.numConstraints(), model.constraints().size());
+    for (uint32_t c = 0; c < pools.numConstraints(); ++c) {
+      const Constraint& constraint = model.constraints()[c];
+      EXPECT_EQ(pools.identifier(c), constraint.identifier());
+      const std::span<const PooledArg> arguments = pools.arguments(c);
+      ASSERT_EQ(arguments.size(), constraint.arguments().size());
+      for (size_t a = 0; a < arguments.size(); ++a) {
+        const Arg& arg = constraint.arguments()[a];
+        ASSERT_EQ(arguments[a].index(), arg.index()) << name << ": " << c;
+        if (std::holds_alternative<IntArg>(arg)) {
+          const IntArg& intArg = std::get<IntArg>(arg);
+          const IntHandle handle = std::get<IntHandle>(arguments[a]);
+          if (intArg.isParameter()) {
+            EXPECT_EQ(pools.parameter(handle), intArg.parameter());
+          } else {
+            EXPECT_EQ(pools.var(handle).identifier(),
+                      intArg.var()->identifier());
+          }
+        } else if (std::holds_alternative<std::shared_ptr<IntVarArray>>(
+                       arg)) {
+          expectEqualElements(
+              pools, *std::get<std::shared_ptr<IntVarArray>>(arg),
+              pools.elements(
+                  std::get<ArrayHandle<IntVarArray>>(arguments[a])));
+        } else if (std::holds_alternative<std::shared_ptr<BoolVarArray>>(
+                       arg)) {
+          expectEqualElements(
+              pools, *std::get<std::shared_ptr<BoolVarArray>>(arg),
+              pools.elements(
+                  std::get<ArrayHandle<BoolVarArray>>(arguments[a])));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace fznparser::testing
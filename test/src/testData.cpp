@@ -93,8 +93,8 @@ vector<std::string> front_str_vec(
 }
 
 template <typename T>
-vector<T> combine_data(const vector<pair<vector<std::string>, T>> &data) {
-  vector<T> data_vec{};
+ArenaVector<T> combine_data(const vector<pair<vector<std::string>, T>> &data) {
+  ArenaVector<T> data_vec{};
   data_vec.reserve(data.size());
   for (const auto &[_, d] : data) {
     data_vec.emplace_back(d);
@@ -159,7 +159,7 @@ vector<pair<vector<std::string>, T>> int_set(
   }
   good_inputs.emplace_back(pair<vector<std::string>, T>{
       front_str_vec<int64_t>(ild, prefix, suffix),
-      T(std::vector<int64_t>{ild.front().second})});
+      T(ArenaVector<int64_t>{ild.front().second})});
   good_inputs.emplace_back(pair<vector<std::string>, T>{
       combine_str_vec<int64_t>(ild, prefix, separator, suffix),
       T(combine_data<int64_t>(ild))});
@@ -179,7 +179,7 @@ vector<pair<vector<std::string>, T>> float_set(
   }
   good_inputs.emplace_back(
       pair<vector<std::string>, T>{front_str_vec<double>(fld, prefix, suffix),
-                                   T(std::vector<double>{fld.front().second})});
+                                   T(ArenaVector<double>{fld.front().second})});
   good_inputs.emplace_back(pair<vector<std::string>, T>{
       combine_str_vec<double>(fld, prefix, separator, suffix),
       T(combine_data<double>(fld))});
@@ -196,7 +196,11 @@ vector<pair<vector<std::string>, int64_t>> int_literal_data_pos() {
 
 vector<pair<vector<std::string>, double>> float_literal_data_pos() {
   return vector<pair<vector<std::string>, double>>{
-      {{"123.456"}, 123.456}, {{"-123.456"}, -123.456}, {{"0.0"}, 0.0}};
+      {{"123.456"}, 123.456}, {{"-123.456"}, -123.456},
+      {{"1.5e3"}, 1.5e3},     {{"-2.5E-3"}, -2.5e-3},
+      {{"1e+10"}, 1e10},      {{"0.0"}, 0.0},
+      // too small for a double
+      {{"1e-400"}, 0.0},      {{"-2.5e-999"}, -0.0}};
 }
 
 vector<pair<vector<std::string>, std::string>> string_literal_data_pos() {
@@ -204,6 +208,7 @@ vector<pair<vector<std::string>, std::string>> string_literal_data_pos() {
       {{"\"abcd\""}, "\"abcd\""},
       {{"\"e f g h\""}, "\"e f g h\""},
       {{R"("\"ijk\"")"}, R"(""ijk"")"},
+      {{R"("p\\")"}, R"("p\\")"},
       {{"\"l\tm\tn\to\""}, "\"l\tm\tn\to\""}};
 }
 
@@ -563,7 +568,7 @@ vector<pair<vector<std::string>, ArrayLiteral>> array_literal_data_pos() {
   return vector<pair<vector<std::string>, ArrayLiteral>>{
       {vector<std::string>{"[", "]"}, ArrayLiteral{}},
       {front_str_vec<BasicExpr>(bed, "[", "]"),
-       ArrayLiteral(std::vector<BasicExpr>{bed.front().second})},
+       ArrayLiteral(ArenaVector<BasicExpr>{bed.front().second})},
       {combine_str_vec<BasicExpr>(bed, "[", ",", "]"),
        ArrayLiteral(combine_data<BasicExpr>(bed))}};
 }
@@ -589,7 +594,7 @@ par_array_literal_data_pos() {
   return vector<pair<vector<std::string>, ParArrayLiteral>>{
       {vector<std::string>{"[", "]"}, ParArrayLiteral{}},
       {front_str_vec<BasicLiteralExpr>(bled, "[", "]"),
-       ParArrayLiteral(std::vector<BasicLiteralExpr>{bled.front().second})},
+       ParArrayLiteral(ArenaVector<BasicLiteralExpr>{bled.front().second})},
       {combine_str_vec<BasicLiteralExpr>(bled, "[", ",", "]"),
        ParArrayLiteral(combine_data<BasicLiteralExpr>(bled))}};
 }
@@ -653,7 +658,7 @@ vector<pair<vector<std::string>, PredicateItem>> predicate_item_data_pos() {
       vector<std::string> str_vec{"predicate"};
       extend(str_vec, identifier_str_vec);
       str_vec.emplace_back("(");
-      vector<PredParam> params;
+      ArenaVector<PredParam> params;
       for (size_t j = 0; j < i; ++j) {
         if (j != 0) {
           str_vec.emplace_back(",");
@@ -709,7 +714,7 @@ ann_expr_data_pos(  // NOLINT(*-no-recursion)
   }
   for (const size_t i : vector<size_t>{0, 1, baed.size()}) {
     vector<std::string> str_vec{"["};
-    vector<BasicAnnExpr> vals{};
+    ArenaVector<BasicAnnExpr> vals{};
     for (size_t j = 0; j < i; ++j) {
       if (j > 0) {
         str_vec.emplace_back(",");
@@ -736,7 +741,8 @@ annotation_data_pos(  // NOLINT(*-no-recursion)
   const auto id = identifier_data_pos();
   for (const size_t i : vector<size_t>{1, id.size() - 1}) {
     good_inputs.emplace_back(
-        id.at(i).first, parser::Annotation{id.at(i).second, vector<AnnExpr>{}});
+        id.at(i).first,
+        parser::Annotation{id.at(i).second, ArenaVector<AnnExpr>{}});
   }
   const auto ae = ann_expr_data_pos(recursion - 1);
   if (ae.empty()) {
@@ -745,7 +751,7 @@ annotation_data_pos(  // NOLINT(*-no-recursion)
   for (const size_t i : vector<size_t>{1, ae.size()}) {
     vector<std::string> str_vec(id.front().first);
     str_vec.emplace_back("(");
-    vector<AnnExpr> expressions{};
+    ArenaVector<AnnExpr> expressions{};
     for (size_t j = 0; j < i; ++j) {
       if (j != 0) {
         str_vec.emplace_back(",");
@@ -887,7 +893,7 @@ vector<pair<vector<std::string>, ConstraintItem>> constraint_item_data_pos() {
         vector<std::string> str_vec{"constraint"};
         extend(str_vec, id_str_vec);
 
-        vector<Expr> expressions{};
+        ArenaVector<Expr> expressions{};
 
         str_vec.emplace_back("(");
         for (size_t j = 0; j < i; ++j) {
@@ -964,15 +970,15 @@ vector<pair<vector<std::string>, SolveItem>> solve_item_data_pos() {
 }
 
 template <typename T>
-pair<vector<std::string>, std::vector<T>> flatten(
+pair<vector<std::string>, ArenaVector<T>> flatten(
     const vector<pair<vector<std::string>, T>> &data_pos) {
   vector<std::string> str_vec{};
-  vector<T> item_vec{};
+  ArenaVector<T> item_vec{};
   for (const pair<vector<std::string>, T> &p : data_pos) {
     extend(str_vec, p.first);
     item_vec.emplace_back(p.second);
   }
-  return pair<vector<std::string>, std::vector<T>>{str_vec, item_vec};
+  return pair<vector<std::string>, ArenaVector<T>>{str_vec, item_vec};
 }
 
 vector<pair<vector<std::string>, parser::Model>> model_data_pos() {
@@ -984,22 +990,22 @@ vector<pair<vector<std::string>, parser::Model>> model_data_pos() {
   const auto cid_init = constraint_item_data_pos();
   const auto sid = solve_item_data_pos();
 
-  vector<pair<vector<std::string>, vector<PredicateItem>>> pid{
+  vector<pair<vector<std::string>, ArenaVector<PredicateItem>>> pid{
       {},
       {pid_init.front().first, {pid_init.front().second}},
       flatten<PredicateItem>(pid_init)};
 
-  vector<pair<vector<std::string>, vector<ParDeclItem>>> pdid{
+  vector<pair<vector<std::string>, ArenaVector<ParDeclItem>>> pdid{
       {},
       {pdid_init.front().first, {pdid_init.front().second}},
       flatten<ParDeclItem>(pdid_init)};
 
-  vector<pair<vector<std::string>, vector<VarDeclItem>>> vdid{
+  vector<pair<vector<std::string>, ArenaVector<VarDeclItem>>> vdid{
       {},
       {vdid_init.front().first, {vdid_init.front().second}},
       flatten<VarDeclItem>(vdid_init)};
 
-  vector<pair<vector<std::string>, vector<ConstraintItem>>> cid{
+  vector<pair<vector<std::string>, ArenaVector<ConstraintItem>>> cid{
       {},
       {cid_init.front().first, {cid_init.front().second}},
       flatten<ConstraintItem>(cid_init)};
@@ -1013,7 +1019,8 @@ vector<pair<vector<std::string>, parser::Model>> model_data_pos() {
           extend(str_vec, ci_str_vec);
           extend(str_vec, si_str_vec);
           good_inputs.emplace_back(
-              str_vec, parser::Model{pi, pdi, vector<VarDeclItem>{}, ci, si});
+              str_vec,
+              parser::Model{pi, pdi, ArenaVector<VarDeclItem>{}, ci, si});
         }
       }
     }
@@ -1021,8 +1028,13 @@ vector<pair<vector<std::string>, parser::Model>> model_data_pos() {
   return good_inputs;
 }
 
-vector<std::string> int_literal_data_neg() { return vector<std::string>{}; }
-vector<std::string> float_literal_data_neg() { return vector<std::string>{}; }
+vector<std::string> int_literal_data_neg() {
+  return vector<std::string>{"+1", "+-1"};
+}
+vector<std::string> float_literal_data_neg() {
+  return vector<std::string>{"1",  "1.",  ".5",    "1.e5",
+                             "1e", "+1.5", "1e400", "-1e400"};
+}
 vector<std::string> identifier_data_neg() { return vector<std::string>{}; }
 vector<std::string> basic_par_type_data_neg() { return vector<std::string>{}; }
 vector<std::string> bool_literal_data_neg() { return vector<std::string>{}; }
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "fznparser/transformer/symbolTable.hpp"
+
+namespace fznparser::testing {
+
+TEST(symbol_table, dense_ids) {
+  SymbolTable symbols;
+  const std::vector<std::string> names{"x", "y", "X_INTRODUCED_1_", "z"};
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(symbols.intern(names.at(i)), i);
+  }
+  EXPECT_EQ(symbols.size(), names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(symbols.intern(names.at(i)), i);
+    EXPECT_EQ(symbols.find(names.at(i)), i);
+    EXPECT_EQ(symbols.name(static_cast<SymbolId>(i)), names.at(i));
+  }
+  EXPECT_EQ(symbols.size(), names.size());
+  EXPECT_FALSE(symbols.find("w").has_value());
+  EXPECT_EQ(symbols.size(), names.size());
+}
+
+TEST(symbol_table, stable_names) {
+  SymbolTable symbols;
+  const std::string& first = symbols.name(symbols.intern("first"));
+  for (size_t i = 0; i < 10000; ++i) {
+    symbols.intern("x" + std::to_string(i));
+  }
+  EXPECT_EQ(first, "first");
+  EXPECT_EQ(symbols.find("first"), 0);
+  EXPECT_EQ(symbols.find("x9999"), 10000);
+}
+
+}  // namespace fznparser::testing